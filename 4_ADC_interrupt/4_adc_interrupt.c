@@ -1,14 +1,17 @@
 //******************************************************************************
-//  MSP430G2x31 Demo - ADC10, A1 mrse, Vref+ = Vcc, P1.0 g, ha A1 > 0.5*Vcc
+//  MSP430G2x31 Demo - ADC10, A1 ablakkompartor, Vref+ = Vcc, LED jelzs
 //
-//  Programlers: Egycsatorns mrs az A1 mebeneten, Vcc referencival.
-//  A konverzit szoftveresen indtjuk ADC10SC '1'-be lltsval - ADC10SC
-//  automatikusan trldik a konverzi vgn. ADC10 sajt oszcilltora temezi
-//  a mintavtelezst (64 rajel peridus) s a konverzit.
-//  A fprogram vgtelen ciklusban a mikrovezrl LPM0 energiatakarkos mdban 
-//  vrakozik, amg a konverzi be nem fejezdik. Az ADC megszaktsnak
-//  kiszolglsakor bresztjk fel jra a mikrovezrlt. 
-//  Ha A1 > 0.5*Vcc, akkor a P1.0-ra kttt LED vilgt, egybknt lekapcsoljuk.
+//  Programlers: Az A1 bemenetet Timer_A temezi (ACLK = VLO, 100 mrs/s),
+//  a konverzit a TA0.0 kimenjel indtja, az ADC10 sajt oszcilltora
+//  vgzi a mintavtelezst (64 rajel peridus) s a konverzit.
+//  A mrst az ADC megszakts rtkeli ki (common/adc10_win.c): a jel
+//  az 1/3*Vcc - 2/3*Vcc ablak alatt, bell vagy felett van-e, 16 LSB
+//  hiszterzissel s 3 egyez mrses pergsmentestssel. A fprogram
+//  LPM3 mdban alszik, s csak akkor bred, ha a jel tartsan znt vlt.
+//  Ha A1 > 2/3*Vcc, akkor a P1.0-ra kttt LED1 vilgt, ha A1 < 1/3*Vcc,
+//  akkor a P1.6-ra kttt LED2, az ablakon bell mindkett stt.
+//  Az bresztsek szmt s a becslt ramfelvtelt a gazdagpes
+//  emultor mutatja, pl.: 4_adc_interrupt-emu -t 10 -a 1=sine:1650:1500:0.5
 //
 //                MSP430G2x31
 //             -----------------
@@ -16,39 +19,49 @@
 //          | |                 |
 //          --|RST          XOUT|-
 //            |                 |
-//        >---|P1.1/A1      P1.0|-->LED
+//        >---|P1.1/A1      P1.0|-->LED1 (A1 > 2/3*Vcc)
+//            |             P1.6|-->LED2 (A1 < 1/3*Vcc)
 //
 //  Szerz: D. Dang, Texas Instruments Inc., Oct 2010 (msp430g2x31_adc10_01.c)
 //  Magyar vltozat: I. Cserny, MTA ATOMKI, Jan 2013 (4_adc_interrupt.c)
 //                   IAR Embedded Workbench Version: 5.51
 //******************************************************************************
 #include "msp430.h"
+#include "adc10_win.h"
+
+static const adc_win_t win = {
+  0x155, 0x2AA,                             // Az ablak: 1/3*Vcc - 2/3*Vcc
+  16,                                       // Hiszterzis: 16 LSB
+  3,                                        // 3 egyez mrs kell a vltshoz
+  0                                         // Nincs visszahvs, csak breszts
+};
 
 void main(void)
 {
   WDTCTL = WDTPW + WDTHOLD;                 // Letiltjuk a watchdog idztt
-  ADC10CTL0 = ADC10SHT_3                    // mintavtel: 64 rats
-             | ADC10ON                      // Az ADC bekapcsolsa
-             | SREF_0                       // VR+ = AVCC s VR- = AVSS  
-             | ADC10IE;                     // ADC10 megszakts engedlyezse   
-  ADC10CTL1 = ADC10SSEL_0 | INCH_1;         // ADC10OSC az rajel, A1 a bemenet
+  BCSCTL3 |= LFXT1S_2;                      // ACLK = VLO (kb. 12 kHz)
+  P1OUT &= ~(BIT0 + BIT6);                  // LED1 s LED2 stt
+  P1DIR |= BIT0 + BIT6;                     // P1.0 s P1.6 kimenet legyen
   ADC10AE0 |= BIT1;                         // P1.1 analg funkci engedlyezse
-  P1DIR |= BIT0;                            // P1.0 kimenet legyen (LED1)
+  TACCR0 = 59;                              // 60 ACLK ts: 200 Hz
+  TACCTL0 = OUTMOD_4;                       // Toggle md (OUT0 100 Hz lesz)
+  TACTL = TASSEL_1                          // ACLK az rajel forrsa
+         | MC_1                             // Felfel szmlls TACCR0-ig
+         | TACLR;                           // A szmll trlse
+  ADC_win_start(INCH_1, &win);              // A1 figyelse
 
   for (;;)
   {
-    ADC10CTL0 |= ENC + ADC10SC;             // Konverzi engedlyezse s indtsa
-    __low_power_mode_0();                   // Alvs a konverzi vgig
-    if (ADC10MEM < 0x1FF)                   // Ha A1 < 0.5*Vcc 
-      P1OUT &= ~0x01;                       // P1.0 LED1-et kikapcsoljuk
-    else
-      P1OUT |= 0x01;                        // P1.0 LED1-et bekapcsoljuk
+    switch (ADC_win_wait())                 // Alvs a kvetkez znavltsig
+    {
+    case ADC_WIN_ABOVE:                     // A1 > 2/3*Vcc
+      P1OUT = (P1OUT & ~BIT6) | BIT0;       // LED1 vilgt
+      break;
+    case ADC_WIN_BELOW:                     // A1 < 1/3*Vcc
+      P1OUT = (P1OUT & ~BIT0) | BIT6;       // LED2 vilgt
+      break;
+    default:                                // Az ablakon bell
+      P1OUT &= ~(BIT0 + BIT6);              // Mindkt LED stt
+    }
   }
 }
-
-//--- ADC10 megszaktskiszolgl eljrs -----
-#pragma vector=ADC10_VECTOR
-__interrupt void ADC10_ISR(void)
-{
-  __low_power_mode_off_on_exit();           // Felbresztjk az alv CPU-t
-}
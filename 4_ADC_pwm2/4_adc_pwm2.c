@@ -12,6 +12,11 @@
  * 8-cal s 1024-gyel osztjuk le.
  * A PWM kitlts frisstse az ADC megszaktsokban trtnik.
  * A konverzikat a CCR0 csatorna kimen jelvel indtjuk (OUT0).
+ * Az ADC kd s a kitlts kztt szablyoz fokozat van (common/pwm_ctrl.c):
+ * IIR simts (PWM_K), holtsv (PWM_BAND), majd a CIE fnyessg-
+ * korrekci tblzata, gy a LED nem vibrl az ADC zajtl, s a
+ * fnyer a potmter llsval egyenletesen n. Szablyozs nlkli,
+ * CPU-t sem ignyl vltozat: 4_ADC_pwm3 (DTC).
  *
  * Hardver felttelek:
  *  - MSP430 Launchpad krtya (MSP430G2231, MSP430G2452 vagy MSP430G2553)
@@ -32,9 +37,20 @@
  * Launchpad-ra adaptlta: I Cserny, 2012-11-23; IAR version 5.51
  **********************************************************************/
 #include "io430.h"
+#include "isr.h"
+#include "pwm_ctrl.h"
+
+#ifndef PWM_K
+#define PWM_K     3                    // Simts: 2^3 = 8 PWM peridus (~65 ms)
+#endif
+#ifndef PWM_BAND
+#define PWM_BAND  2                    // Holtsv: 2 LSB
+#endif
+pwm_ctrl_t ctrl;                       // A szablyoz llapota
 
 void main (void) {
     WDTCTL = WDTPW | WDTHOLD;          // Letiltjuk a watchdog idztt
+    pwm_ctrl_init(&ctrl,PWM_K,PWM_BAND,0); // Sttrl indul (lgy indts)
     P1OUT = 0;                         // A nem hasznlt kimeneteket lehzzuk
     P1DIR = ~(BIT2+BIT3+BIT5);         // Csak RXD, SW2 s AN5 legyen bemenet
     P1SEL |= BIT6;                     // P1.6 legyen TA0.1 kimenet
@@ -68,8 +84,7 @@ void main (void) {
 //----------------------------------------------------------------------
 // ADC10 megszakts kiszolglsa: PWM kitlts aktualizlsa
 //----------------------------------------------------------------------
-#pragma vector = ADC10_VECTOR
-__interrupt void ADC10_ISR (void)      // A jelzbit automatikusan trldik
+ISR(ADC10_VECTOR, ADC10_ISR)      // A jelzbit automatikusan trldik
 {
-    TACCR1 = ADC10MEM;                 // PWM kitlts = ADC konverzi eredmnye
+    TACCR1 = pwm_ctrl_put(&ctrl,ADC10MEM); // Simts, holtsv, fnyessg-korrekci
 }
\ No newline at end of file
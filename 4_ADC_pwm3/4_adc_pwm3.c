@@ -13,6 +13,8 @@
  * A PWM kitlts frisstshez hardveresen (DTC-vel) mozgatjuk t a 
  * konverzi eredmnyt az ADC10MEM regiszterbl a TACCR1 regiszterbe.
  * A konverzikat a CCR0 csatorna kimen jelvel indtjuk (OUT0).
+ * Itt a kd szablyozs nlkl kerl a kitltsbe (simts s
+ * fnyessg-korrekci: 4_ADC_pwm1, 4_ADC_pwm2).
  *
  * Hardver felttelek:
  *  - MSP430 Launchpad krtya (MSP430G2231, MSP430G2452 vagy MSP430G2553)
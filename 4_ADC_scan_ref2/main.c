@@ -7,14 +7,21 @@
  *
  * A mrs eredmnyeit egyirny szoftveres UART kezelssel (csak adatklds) 
  * kiratjuk. Paramterek: 9600 baud, 8 adatbit, nincs paritsbit, 2 stopbit
+ *
+ * Ha a TELEM_BINARY makr definilt (Preprocessor/Defined symbols),
+ * szveg helyett 9 bjtos binris keretet kldnk (common/telem.h),
+ * ezt a gazdagpen a tools/telem_decode program alaktja CSV-v.
  * 
  * A gyrilag kalibrlt 1 MHz-es DCO rajelet hasznljuk: 
- * ACLK = n/a, MCLK = SMCLK = DCO 1 MHz
+ * ACLK = VLO (idzts), MCLK = SMCLK = DCO 1 MHz
  * 
  * Hardver kvetelmnyek:
  *  - Launchpad MSP430G2xxx mikrovezrlvel
  *  - Az jabb kiads (v1.5) krtyn az RXD,TXD tktseket 
  *    SW llsba kell helyezni (a tbbi tktssel prhuzamosan)
+ *  - MSP430G2553 esetn a kirs a hardveres USCI_A0 UART-on megy
+ *    (TXD = P1.2, 115200 baud, 1 stopbit), ekkor az RXD,TXD tktsek
+ *    HW llsba kerlnek (SW_UART_NO_USCI: marad a szoftveres UART)
  *
  *       MSP430G2231, MSP430G2452 vagy MSP430G2553
  *             -----------------
@@ -34,138 +41,30 @@
  **********************************************************************/
 #include  "io430.h"
 #include "stdint.h"
-#define TXD       BIT1                      //TXD a P1.1 lbon
+#include "adc10.h"
+#include "tick.h"
+#include "sw_uart.h"
+#include "convert.h"
+#include "telem.h"
 
 uint16_t adc_data[16];                      //Ide kerlnek a mrsi adatok
-
-/*-------------------------------------------------------------
- * Egyszeri csatornapsztzs, ADC a 2.5V-os bels referencival
- *-------------------------------------------------------------
- * chan - a kezd csatorna sorszma << 12
- * pbuf - a kimeneti adatbuffer kezdcme
- * ndat - a psztzand csatornk szma
- */
-void ADC_scan_meas_REF2_5V(uint16_t chan, uint16_t *pbuf, uint8_t ndat) {
-  ADC10CTL0 &= ~ENC;                   //Az ADC letiltsa jrakonfigurlshoz
-  while (ADC10CTL1 & BUSY);            //Vrakozs a foglaltsg vgre
-  ADC10CTL0 = ADC10SHT_3               //mintavtel: 64 rats
-             | ADC10ON                 //Az ADC bekapcsolsa
-             | SREF_1                  //VR+ = VREF+ s VR- = AVSS
-             | REFON                   //Bels referencia bekapcsolsa
-             | REF2_5V                 //2,5 V-os referencia kivlasztsa
-             | MSC;                    //Tbbszrs konverzi egy triggerjelre   
-  ADC10CTL1 = ADC10SSEL_0              //ADC10OSC kivlasztsa 
-             | CONSEQ_1                //Egyszeri csatornapsztzs
-             | chan;                   //kezd csatorna megadsa
-  ADC10DTC0 &= ~(ADC10TB+ADC10CT);     //Egy blokk md
-  ADC10DTC1 = ndat;                    //ndat konverzit vgznk  
-  ADC10SA = (unsigned short)pbuf;      //adatok mentse a mutatval jelzett helyre 
-  ADC10CTL0 |= ENC + ADC10SC;          //Konverzi engedlyezse s indtsa
-  while (!(ADC10CTL0 & ADC10IFG));     //Vrakozs a konverzi vgre
-}
-
-/**------------------------------------------------------------
- *   Ksleltet eljrs (1 - 65535 ms)
- *-------------------------------------------------------------
- * delay - a ksleltets ms egysgben megadva
- */
-void delay_ms(uint16_t delay) {
-  uint16_t i;
-  for(i=0; i<delay; i++) {             //"delay"-szer ismteljk
-    __delay_cycles(1000);              //1 ms ksleltets
-  }
-}
-
-/**------------------------------------------------------------
- *   Egy karakter kikldse a soros portra
- *   SW_UART: 9600 bit/s, 8, N, 2 formtum
- *   DCO = 1 MHz (Bitid = 104.167 usec)
- *-------------------------------------------------------------
- * c - a kikldeni kvnt karakter kdja
- */
-void sw_uart_putc(char c) {
-  uint8_t i;
-  uint16_t TXData;                     //Adatregiszter (11 bites)
-  TXData = (uint16_t)c | 0x300;        //2 Stop bit (mark)
-  TXData = TXData << 1;                //Start bit (space)
-  for(i=0; i<11; i++) {                //11 bitet kldnk ki
-    if(TXData & 0x0001) {              //Soron kvetkez bit vizsglata
-      P1OUT |= TXD;                    //Ha '1'
-    } else {
-      P1OUT &= ~TXD;                   //Ha '0'
-    }
-    TXData = TXData >> 1;              //Adatregiszter lptets jobbra
-    __delay_cycles(89);                //<== Itt kell hangolni!
-  }
-  P1OUT |= TXD;                        //Az alaphelyzet: mark
-}
-
-/**------------------------------------------------------------
- *  Karakterfzr kirsa a soros portra
- *-------------------------------------------------------------
- * p_str - karakterfzr mutat (nullval lezrt stringre mutat)
- */
-void sw_uart_puts(char* p_str) {
-  char c;
-  while ((c=*p_str)) {
-      sw_uart_putc(c);
-      p_str++;
-  }
-}
-
-/**------------------------------------------------------------
- * Eljel nlkli egsz szm kirsa hexadecimlis formban
- *-------------------------------------------------------------
- * t - a kirand szm (uint16_t tpus)
- */
-void sw_uart_out4hex(uint16_t t)
-{
-  char c;
-  c=(char)((t>>12) & 0x0F);
-  if (c>9) c+=7;
-  sw_uart_putc(c+'0');
-  c=(char)((t>>8) & 0x0F);
-  if (c>9) c+=7;
-  sw_uart_putc(c+'0');
-  c=(char)((t>>4) & 0x0F);
-  if (c>9) c+=7;
-  sw_uart_putc(c+'0');
-  c=(char)(t & 0x0F);
-  if (c>9) c+=7;
-  sw_uart_putc(c+'0');
-}
-
-/**------------------------------------------------------------
- * Decimlis kirats adott szm tizedesjegyre.
- *-------------------------------------------------------------
- * data - a kirand eljeles szm (int32_t)
- * ndigits - a kirand tizedesek szma (uint8_t)
- */
-void sw_uart_outdec(int32_t data, uint8_t ndigits) {
-  static char sign, s[12];
-  int8_t i;
-  i=0; sign=' ';
-  if(data<0) { sign='-'; data = -data;}
-    do {
-      s[i]=data%10 + '0';
-      data=data/10;
-      i++;
-      if(i==ndigits) {s[i]='.'; i++;}
-    } while(data>0 || i<(ndigits+2));
-    sw_uart_putc(sign);
-    do {
-      sw_uart_putc(s[--i]);
-    } while(i);
-}
+#ifdef TELEM_BINARY
+uint8_t frame[TELEM_FRAME_SIZE(3)];    //A binris keret
+uint8_t seq;                           //A keret sorszma
+#endif
 
 void main(void) {
 uint8_t i;
+#ifdef TELEM_BINARY
+uint8_t n;
+#else
 int32_t temp;
+#endif
   WDTCTL = WDTPW + WDTHOLD;            //Letiltjuk a watchdog idztt
   DCOCTL = CALDCO_1MHZ;                // DCO belltsa a gyrilag kalibrlt 
   BCSCTL1 = CALBC1_1MHZ;               // 1 MHz-es frekvencira  
-  P1DIR |= TXD;                        //TXD legyen digitlis kimenet
-  P1OUT |= TXD;                        //TXD alaphelyzete: mark
+  tick_init();                         //ACLK = VLO, WDT idalap, LPM3 alvs
+  sw_uart_init();                      //TXD kimenet, alaphelyzete: mark
 //--- P1.3 bels felhzs engedlyezse -----------------------  
   P1DIR &= ~BIT3;                      //P1.3 legyen digitlis bemenet
   P1OUT |= BIT3;                       //Felfel hzzuk, nem lefel  
@@ -173,16 +72,22 @@ int32_t temp;
 //--- Analg csatornk engedlyezse --------------------------
   ADC10AE0 |= BIT5+BIT6+BIT7;          //P1.5, P1.6, P1.7 legyen analg bemenet
   while(1) {
-    delay_ms(2000);
+    sleep_ms(2000);
 //--- Psztz mrs az A7, A6 s A5 csatornkban -------------   
     ADC_scan_meas_REF2_5V(INCH_7, adc_data,3);  
+#ifdef TELEM_BINARY
+    n = telem_pack(frame,seq++,BIT7+BIT6+BIT5,adc_data); //A7, A6, A5
+    for(i=0; i<n; i++) sw_uart_putc(frame[i]);
+#else
     for(i=0; i<3; i++) {
-      temp = (int32_t)adc_data[i]*2500L/1023L;
+      temp = conv_apply(&conv_mv_ref2_5v,adc_data[i]);
       sw_uart_putc(i+48);
       sw_uart_puts(". csat = ");
       sw_uart_outdec(temp,3);
       sw_uart_puts(" V  ");
     }
     sw_uart_puts("\r\n");  
+#endif
+    sw_uart_flush();                   //Alvs eltt az ads befejezse
   }
 }
\ No newline at end of file
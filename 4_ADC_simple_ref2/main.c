@@ -5,17 +5,23 @@
  * Az A5 (P1.5 lb) analg bemenetre 0 - 2,5 V kztti jelet vigynk.
  * Emellett megmrjk a fl tpfeszltsget (Chan 11) s a bels
  * hmr jelt (Chan 10).
+ * A mrs 250 ms-onknt, a kirs 2 s-onknt fut periodikus feladatknt
+ * (tick_run), kzben a CPU LPM3 mdban alszik. Az eredmnyeket
+ * egyplus IIR szrvel simtjuk.
  * 
  * A mrs eredmnyeit egyirny szoftveres UART kezelssel (csak adatklds) 
  * kiratjuk. Paramterek: 9600 baud, 8 adatbit, nincs paritsbit, 2 stopbit
  * 
  * A gyrilag kalibrlt 1 MHz-es DCO rajelet hasznljuk: 
- * ACLK = n/a, MCLK = SMCLK = DCO 1 MHz
+ * ACLK = VLO (idzts), MCLK = SMCLK = DCO 1 MHz
  * 
  * Hardver kvetelmnyek:
  *  - Launchpad MSP430G2xxx mikrovezrlvel
  *  - Az jabb kiads (v1.5) krtyn az RXD,TXD tktseket 
  *    SW llsba kell helyezni (a tbbi tktssel prhuzamosan)
+ *  - MSP430G2553 esetn a kirs a hardveres USCI_A0 UART-on megy
+ *    (TXD = P1.2, 115200 baud, 1 stopbit), ekkor az RXD,TXD tktsek
+ *    HW llsba kerlnek (SW_UART_NO_USCI: marad a szoftveres UART)
  *
  *
  *                MSP430G2xxx
@@ -34,157 +40,79 @@
  **********************************************************************/
 #include "io430.h"
 #include "stdint.h"
+#include "adc10.h"
+#include "tick.h"
+#include "sw_uart.h"
+#include "convert.h"
+#include "filter.h"
 
-#define TXD       BIT1                 // TXD a P1.1 lbon
+#define NCHAN     3                    //A mrt csatornk szma
+const uint16_t chans[NCHAN] = { INCH_5, INCH_11, INCH_10 };
+filt_iir_t flt[NCHAN];                 //Csatornnknti simts
+uint16_t smooth[NCHAN];                //A simtott eredmnyek
+uint8_t first = 1;                     //Az els mrs tlti fel a szrket
 
 /*-------------------------------------------------------------
- * Egyszeri mrs egy ADC csatornban, 2,5 V a bels referencia
- *-------------------------------------------------------------
- * chan - csatornavlaszt bitek (a csatorna sorszma << 12)
- */
-uint16_t ADC_single_meas_REF2_5V(uint16_t chan) {
-  ADC10CTL0 &= ~ENC;                   //Az ADC letiltsa jrakonfigurlshoz
-  ADC10CTL0 = ADC10SHT_3               //mintavtel: 64 rats
-             | ADC10ON                 //Az ADC bekapcsolsa
-             | SREF_1                  //VR+ = VREF+ s VR- = AVSS
-             | REFON                   //Bels referencia bekapcsolsa
-             | REF2_5V;                //2,5 V-os referencia kivlasztsa
-  ADC10CTL1 = ADC10SSEL_0 + chan;      //csatorna = 'chan', ADC10OSC az rajel
-  ADC10CTL0 |= ENC + ADC10SC;          //Konverzi engedlyezse s indtsa
-  while (ADC10CTL1 & BUSY);            //Vrakozs a konverzi vgre
-  return ADC10MEM;                     //Visszatrsi rtk a konverzi eredmnye 
-}
-
-/**------------------------------------------------------------
- *   Ksleltet eljrs (1 - 65535 ms)
- *-------------------------------------------------------------
- * delay - a ksleltets ms egysgben megadva
- */
-void delay_ms(uint16_t delay) {
-  uint16_t i;
-  for(i=0; i<delay; i++) {             //"delay"-szer ismteljk
-    __delay_cycles(1000);              //1 ms ksleltets
-  }
-}
-
-/**------------------------------------------------------------
- *   Egy karakter kikldse a soros portra
- *   SW_UART: 9600 bit/s, 8, N, 2 formtum
- *   DCO = 1 MHz (Bitid = 104.167 usec)
- *-------------------------------------------------------------
- * c - a kikldeni kvnt karakter kdja
- */
-void sw_uart_putc(char c) {
-  uint8_t i;
-  uint16_t TXData;                     //Adatregiszter (11 bites)
-  TXData = (uint16_t)c | 0x300;        //2 Stop bit (mark)
-  TXData = TXData << 1;                //Start bit (space)
-  for(i=0; i<11; i++) {                //11 bitet kldnk ki
-    if(TXData & 0x0001) {              //Soron kvetkez bit vizsglata
-      P1OUT |= TXD;                    //Ha '1'
-    } else {
-      P1OUT &= ~TXD;                   //Ha '0'
-    }
-    TXData = TXData >> 1;              //Adatregiszter lptets jobbra
-    __delay_cycles(89);                //<== Itt kell hangolni!
-  }
-  P1OUT |= TXD;                        //Az alaphelyzet: mark
-}
-
-/**------------------------------------------------------------
- *  Karakterfzr kirsa a soros portra
- *-------------------------------------------------------------
- * p_str - karakterfzr mutat (nullval lezrt stringre mutat)
- */
-void sw_uart_puts(char* p_str) {
-  char c;
-  while ((c=*p_str)) {
-      sw_uart_putc(c);
-      p_str++;
+ * Periodikus feladat: a hrom csatorna mrse s simtsa
+ *-------------------------------------------------------------*/
+void meas_task(void) {
+uint16_t data;
+uint8_t i;
+  for(i=0; i<NCHAN; i++) {
+    data = ADC_single_meas_REF2_5V(chans[i]);
+    if(first) {
+      filt_iir_init(&flt[i],2,data);   //Idlland: 4 mrs
+      smooth[i] = data;
+    } else smooth[i] = filt_iir_put(&flt[i],data);
   }
+  first = 0;
 }
 
-/**------------------------------------------------------------
- * Eljel nlkli egsz szm kirsa hexadecimlis formban
- *-------------------------------------------------------------
- * t - a kirand szm (uint16_t tpus)
- */
-void sw_uart_out4hex(uint16_t t)
-{
-  char c;
-  c=(char)((t>>12) & 0x0F);
-  if (c>9) c+=7;
-  sw_uart_putc(c+'0');
-  c=(char)((t>>8) & 0x0F);
-  if (c>9) c+=7;
-  sw_uart_putc(c+'0');
-  c=(char)((t>>4) & 0x0F);
-  if (c>9) c+=7;
-  sw_uart_putc(c+'0');
-  c=(char)(t & 0x0F);
-  if (c>9) c+=7;
-  sw_uart_putc(c+'0');
+/*-------------------------------------------------------------
+ * Periodikus feladat: a simtott eredmnyek kiratsa
+ *-------------------------------------------------------------*/
+void print_task(void) {
+uint16_t data;
+int32_t temp;
+//--- Az A5 csatorna (P1.5) bemen feszltsge ----------------
+    data = smooth[0];
+    sw_uart_puts("\r\nchan 5 = ");
+    sw_uart_out4hex(data);
+    temp = conv_apply(&conv_mv_ref2_5v,data); //A mV-okban mrt feszltsg
+    sw_uart_outdec(temp,3);            //kirs 3 tizedesre
+    sw_uart_puts("V chan 11 = ");
+//--- Chan 11 = VDD/2 -----------------------------------------
+    data = smooth[1];
+    sw_uart_out4hex(data);
+    temp = conv_apply(&conv_vdd_ref2_5v,data); //VDD mV-okban mrve
+    sw_uart_outdec(temp,3);            //kirs 3 tizedesre
+    sw_uart_puts("V chan 10 = ");
+//--- Chan 10 a bels hmr ----------------------------------
+    data = smooth[2];
+    sw_uart_out4hex(data);
+    temp = conv_apply(&conv_temp_ref2_5v,data);
+    sw_uart_puts(" temp = ");
+    sw_uart_outdec(temp,1);            //Kirs 1 tizedesre
+    sw_uart_puts(" C");
+  sw_uart_flush();                     //Alvs eltt az ads befejezse
 }
 
-/**------------------------------------------------------------
- * Decimlis kirats adott szm tizedesjegyre.
- *-------------------------------------------------------------
- * data - a kirand eljeles szm (int32_t)
- * ndigits - a kirand tizedesek szma (uint8_t)
- */
-void sw_uart_outdec(int32_t data, uint8_t ndigits) {
-  static char sign, s[12];
-  int8_t i;
-  i=0; sign=' ';
-  if(data<0) { sign='-'; data = -data;}
-    do {
-      s[i]=data%10 + '0';
-      data=data/10;
-      i++;
-      if(i==ndigits) {s[i]='.'; i++;}
-    } while(data>0 || i<(ndigits+2));
-    sw_uart_putc(sign);
-    do {
-      sw_uart_putc(s[--i]);
-    } while(i);
-}
+tick_task_t tasks[] = {
+  TICK_TASK(meas_task, 250),           //Mrs 250 ms-onknt
+  TICK_TASK(print_task, 2000)          //Kirs 2 s-onknt
+};
 
 void main(void) {
-uint16_t data;
-int32_t temp;
   WDTCTL = WDTPW + WDTHOLD;            //Letiltjuk a watchdog idztt
   DCOCTL = CALDCO_1MHZ;                // DCO belltsa a gyrilag kalibrlt 
   BCSCTL1 = CALBC1_1MHZ;               // 1 MHz-es frekvencira  
-  P1DIR |= TXD;                        //TXD legyen digitlis kimenet
-  P1OUT |= TXD;                        //TXD alaphelyzete: mark
+  tick_init();                         //ACLK = VLO, WDT idalap, LPM3 alvs
+  sw_uart_init();                      //TXD kimenet, alaphelyzete: mark
 //--- P1.3 bels felhzs engedlyezse -----------------------  
   P1DIR &= ~BIT3;                      //P1.3 legyen digitlis bemenet
   P1OUT |= BIT3;                       //Felfel hzzuk, nem lefel  
   P1REN |= BIT3;                       //Bels felhzs engedlyezse   
 //--- Analg csatornk engedlyezse --------------------------
   ADC10AE0 |= BIT5;                    //P1.5 legyen analg bemenet
-  while(1) {
-    delay_ms(1000);
-//--- Az A5 csatorna (P1.5) bemen feszltsgnek mrse ------    
-    data = ADC_single_meas_REF2_5V(INCH_5);
-    sw_uart_puts("\r\nchan 5 = ");
-    sw_uart_out4hex(data);
-    temp = (int32_t)data*2500L/1023;   //A mV-okban mrt feszltsg
-    sw_uart_outdec(temp,3);            //kirs 3 tizedesre
-    sw_uart_puts("V chan 11 = ");    
-//--- Chan 11 = VDD/2 mrse ----------------------------------   
-    data = ADC_single_meas_REF2_5V(INCH_11);
-    sw_uart_out4hex(data);
-    temp = (int32_t)data*5000L/1023;   //VDD mV-okban mrve
-    sw_uart_outdec(temp,3);            //kirs 3 tizedesre
-    sw_uart_puts("V chan 10 = ");  
-//--- Chan 10 a bels hmr ----------------------------------    
-    data = ADC_single_meas_REF2_5V(INCH_10);
-    sw_uart_out4hex(data);    
-    temp = ((uint32_t)data*1762L - 711030L) >> 8;   
-    sw_uart_puts(" temp = ");
-    sw_uart_outdec(temp,1);            //Kirs 1 tizedesre
-    sw_uart_puts(" C");   
-    delay_ms(1000);    
-  }
+  tick_run(tasks,2);                   //A feladatok futtatsa, kzben LPM3
 }
@@ -6,18 +6,26 @@
  *
  * Az A5 (Chan 5, P1.5 lb) analg bemenetre kapcsoljuk a 0 - 3,5 V kztti jelet, 
  * amit meg akarunk mrni. Emellett megmrjk a fl tpfeszltsget (Chan 11) 
- * s a bels hmr jelt (Chan 10).
+ * s a bels hmr jelt (Chan 10). A hrom csatornt a mrstemez
+ * (common/adc10_sched.c) egy keretben mri: a szomszdos A11 s A10
+ * csatornt egy hardveres psztzssal, az A5-t egy msodikkal.
  * 
+ * Az eredmnyeket a gyri kalibrcis adatokkal (TLV) korrigljuk,
+ * ha a mikrovezrl tartalmaz ilyet (G2452, G2553), lsd common/calib.h.
+ *
  * A mrs eredmnyeit egyirny szoftveres UART kezelssel (csak adatklds) 
  * kiratjuk. Paramterek: 9600 baud, 8 adatbit, nincs paritsbit, 2 stopbit.
  * 
  * A CPU gyrilag kalibrlt 1 MHz-es DCO rajelet hasznlja. 
- * ACLK = n/a, MCLK = SMCLK = DCO 1 MHz
+ * ACLK = VLO (idzts), MCLK = SMCLK = DCO 1 MHz
  * 
  * Hardver kvetelmnyek:
  *  - Launchpad MSP430G2xxx mikrovezrlvel
  *  - Az jabb kiads (v1.5) krtyn az RXD,TXD tktseket 
  *    SW llsba kell helyezni (a tbbi tktssel prhuzamosan)
+ *  - MSP430G2553 esetn a kirs a hardveres USCI_A0 UART-on megy
+ *    (TXD = P1.2, 115200 baud, 1 stopbit), ekkor az RXD,TXD tktsek
+ *    HW llsba kerlnek (SW_UART_NO_USCI: marad a szoftveres UART)
  *
  *
  *      MSP430G2231, MSP430G2452 vagy MSP430G2553
@@ -37,118 +45,21 @@
 
 #include "io430.h"
 #include "stdint.h"
+#include "adc10.h"
+#include "adc10_sched.h"
+#include "tick.h"
+#include "sw_uart.h"
+#include "convert.h"
+#include "calib.h"
 
-#define TXD       BIT1                 // TXD a P1.1 lbon
-
-/*-------------------------------------------------------------
- * Egyszeri mrs egy ADC csatornban, VCC a referencia
- *-------------------------------------------------------------
- * chan - csatornavlaszt bitek (a csatorna sorszma << 12)
- */
-uint16_t ADC_single_meas(uint16_t chan) {
-  ADC10CTL0 &= ~ENC;                   //Az ADC letiltsa jrakonfigurlshoz
-  ADC10CTL0 = ADC10SHT_3               //mintavtel: 64 rats
-             | ADC10ON                 //Az ADC bekapcsolsa
-             | SREF_0;                 //VR+ = AVCC s VR- = AVSS
-  ADC10CTL1 = ADC10SSEL_0 + chan;      //csatorna = 'chan', ADC10OSC az rajel
-  ADC10CTL0 |= ENC + ADC10SC;          //Konverzi engedlyezse s indtsa
-  while (ADC10CTL1 & BUSY);            //Vrakozs a konverzi vgre
-  return ADC10MEM;                     //Visszatrsi rtk a konverzi eredmnye 
-}
-
-/**------------------------------------------------------------
- *   Ksleltet eljrs (1 - 65535 ms)
- *-------------------------------------------------------------
- * delay - a ksleltets ms egysgben megadva
- */
-void delay_ms(uint16_t delay) {
-  uint16_t i;
-  for(i=0; i<delay; i++) {             //"delay"-szer ismteljk
-    __delay_cycles(1000);              //1 ms ksleltets
-  }
-}
-
-/**------------------------------------------------------------
- *   Egy karakter kikldse a soros portra
- *   SW_UART: 9600 bit/s, 8, N, 2 formtum
- *   DCO = 1 MHz (Bitid = 104.167 usec)
- *-------------------------------------------------------------
- * c - a kikldeni kvnt karakter kdja
- */
-void sw_uart_putc(char c) {
-  uint8_t i;
-  uint16_t TXData;
-  TXData = (uint16_t)c | 0x300;        //Add 2 stop bits (mark) 
-  TXData = TXData << 1;                //Add 1 start bits (space)
-  for(i=0; i<11; i++) {
-    if(TXData & 0x0001) {              //Soron kvetkez bit vizsglata
-      P1OUT |= TXD;                    //Ha '1'
-    } else {
-      P1OUT &= ~TXD;                   //Ha '0'
-    }
-    TXData = TXData >> 1;              //Adatregiszter lptets jobbra
-    __delay_cycles(89);                //<== Itt kell hangolni!
-  }
-  P1OUT |= TXD;                        //Az alaphelyzet: mark 
-}
-
-/**------------------------------------------------------------
- *  Karakterfzr kirsa a soros portra
- *-------------------------------------------------------------
- * p_str - karakterfzr mutat (nullval lezrt stringre mutat)
- */
-void sw_uart_puts(char* p_str) {
-  char c;
-  while ((c=*p_str)) {
-      sw_uart_putc(c);
-      p_str++;
-  }
-}
-
-/**------------------------------------------------------------
- * Eljel nlkli egsz szm kirsa hexadecimlis formban
- *-------------------------------------------------------------
- * t - a kirand szm (uint16_t tpus)
- */
-void sw_uart_out4hex(uint16_t t)
-{
-  char c;
-  c=(char)((t>>12) & 0x0F);
-  if (c>9) c+=7;
-  sw_uart_putc(c+'0');
-  c=(char)((t>>8) & 0x0F);
-  if (c>9) c+=7;
-  sw_uart_putc(c+'0');
-  c=(char)((t>>4) & 0x0F);
-  if (c>9) c+=7;
-  sw_uart_putc(c+'0');
-  c=(char)(t & 0x0F);
-  if (c>9) c+=7;
-  sw_uart_putc(c+'0');
-}
-
-/**------------------------------------------------------------
- * Decimlis kirats adott szm tizedesjegyre.
- *-------------------------------------------------------------
- * data - a kirand szm (eljelesen)
- * ndigits - a kirand tizedesek szma
- */
-void sw_uart_outdec(int32_t data, uint8_t ndigits) {
-  static char sign, s[12];
-  uint8_t i;
-  i=0; sign=' ';
-  if(data<0) { sign='-'; data = -data;}
-    do {
-      s[i]=data%10 + '0';
-      data=data/10;
-      i++;
-      if(i==ndigits) {s[i]='.'; i++;}
-    } while(data > 0 || i < ndigits+2);
-    sw_uart_putc(sign);
-    do {
-      sw_uart_putc(s[--i]);
-    } while(i);
-}
+//--- A mrend csatornk: csatorna, referencia, mintavteli id -------
+const adc_sched_t chans[] = {
+  ADC_SCHED(5,  SREF_0, 0, ADC10_SHT, 0), //A5 bemenet (P1.5)
+  ADC_SCHED(11, SREF_0, 0, ADC10_SHT, 0), //VDD/2
+  ADC_SCHED(10, SREF_0, 0, ADC10_SHT, 0)  //Bels hmr
+};
+#define NCHAN     (sizeof(chans)/sizeof(chans[0]))
+uint16_t results[NCHAN];
 
 void main(void) {
 uint16_t data;
@@ -156,8 +67,9 @@ int32_t temp;
   WDTCTL = WDTPW + WDTHOLD;            //Letiltjuk a watchdog idztt
   DCOCTL = CALDCO_1MHZ;                // DCO belltsa a gyrilag kalibrlt 
   BCSCTL1 = CALBC1_1MHZ;               // 1 MHz-es frekvencira  
-  P1DIR |= TXD;                        //TXD legyen digitlis kimenet
-  P1OUT |= TXD;                        //TXD alaphelyzete: mark
+  tick_init();                         //ACLK = VLO, WDT idalap, LPM3 alvs
+  sw_uart_init();                      //TXD kimenet, alaphelyzete: mark
+  calib_init((const uint8_t *)CALIB_TLV_ADDR); //Gyri ADC kalibrci (TLV)
 //--- P1.3 bels felhzs engedlyezse -----------------------  
   P1DIR &= ~BIT3;                      //P1.3 legyen digitlis bemenet
   P1OUT |= BIT3;                       //Felfel hzzuk, nem lefel  
@@ -166,29 +78,29 @@ int32_t temp;
   ADC10AE0 |= BIT5;                    //P1.5 legyen analg bemenet 
 
   while(1) {
-    delay_ms(2000);                    //2 s vrakozs
-//--- Az A5 bemenjelnek mrse s kiratsa ------------------ 
-    data = ADC_single_meas(INCH_5);    
+    sleep_ms(2000);                    //2 s vrakozs
+    ADC_sched_run(chans,NCHAN,results); //Mindhrom csatorna mrse
+//--- Az A5 bemenjelnek kiratsa ----------------------------
+    data = results[0];
     sw_uart_puts("\r\nchan 5 = ");
     sw_uart_out4hex(data);
-    temp = (int32_t)data*3500L/1023;   //A mV-okban mrt feszltsg
+    temp = conv_apply(&cal_mv_vcc,data); //A mV-okban mrt feszltsg
     sw_uart_outdec(temp,3);            //kirs 3 tizedesre
     sw_uart_puts("V chan 11 = ");  
-//--- Az A11 csatorna (VDD/2) mrse s kiratsa --------------     
-    data = ADC_single_meas(INCH_11);
+//--- Az A11 csatorna (VDD/2) kiratsa -----------------------
+    data = results[1];
     sw_uart_out4hex(data);
-    temp = (int32_t)data*3500L/1023;   //VDD/2 mV-okban mrve
+    temp = conv_apply(&cal_mv_vcc,data); //VDD/2 mV-okban mrve
     sw_uart_outdec(temp,3);            //kirs 3 tizedesre
     sw_uart_puts("V chan 10 = "); 
-//--- Az A10 csatorna (hmr) mrse s kiratsa -------------    
-    data = ADC_single_meas(INCH_10);
+//--- Az A10 csatorna (hmr) kiratsa ----------------------
+    data = results[2];
     sw_uart_out4hex(data);   
-    temp = ((uint32_t)data*2467L - 711030L) >> 8; //tizedfok egysgben
+    temp = conv_apply(&conv_temp_vcc,data); //tizedfok egysgben
     sw_uart_puts(" temp = ");
     sw_uart_outdec(temp,1);            //kirats egy tizedesjegyre
     sw_uart_puts(" C");     
+    sw_uart_flush();                   //Alvs eltt az ads befejezse
   }
 }
 
-
-
@@ -0,0 +1,100 @@
+/**********************************************************************
+ *  Launchpad demprogram: ADC_cont_ref1
+ *
+ * Folyamatos, hzagmentes mrs az A5 csatornban, 1,5 V-os bels
+ * referencival. Az ADC-t Timer0 CCR0 csatornjnak kimenjele
+ * triggereli (~ 500 Hz), a DTC ktblokkos (ping-pong) zemmdban
+ * felvltva tlti a buffer kt felt (common/adc10_cont.c).
+ * Amg a CPU az egyik blokkot szri, a DTC a msikat tlti,
+ * gy egyetlen minta sem vsz el.
+ *
+ * Egy blokk pontosan egy 50 Hz-es peridus (10 minta), ezt egy
+ * msodfok CIC szr (common/filter.c) egyetlen kimenett decimlja,
+ * gy a hlzati zavar s felharmonikusai kiesnek. A blokkonknti
+ * eredmnyeket egyplus IIR szr simtja, NBLOCK blokkonknt (1 s)
+ * kirjuk az eredmnyt s az elveszett (fel nem dolgozott) blokkok szmt.
+ *
+ * A kirats a Timer_A CCR1 megszaktsos szoftveres UART adval
+ * trtnik (SW_UART_USE_TIMER), gy a CPU a bitek kztt is alhat.
+ * Az adsi buffer 16 bjtos (SW_UART_TXBUF_SIZE), hogy a program
+ * az MSP430G2231 128 bjtos RAM-jban is elfrjen.
+ * Paramterek: 9600 baud, 8 adatbit, nincs paritsbit, 2 stopbit
+ *
+ * A gyrilag kalibrlt 1 MHz-es DCO rajelet hasznljuk:
+ * ACLK = n/a, MCLK = SMCLK = DCO 1 MHz
+ *
+ * Hardver kvetelmnyek:
+ *  - Launchpad MSP430G2xxx mikrovezrlvel
+ *  - Az jabb kiads (v1.5) krtyn az RXD,TXD tktseket
+ *    SW llsba kell helyezni (a tbbi tktssel prhuzamosan)
+ *
+ *
+ *       MSP430G2231, MSP430G2452 vagy MSP430G2553
+ *             -----------------
+ *         /|\|              XIN|-
+ *          | |                 |
+ *          --|RST          XOUT|-
+ *            |                 |
+ *     TxD <--|P1.1         P1.5|<-- 0-1,5 V
+ *
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ *  Fejleszti krnyezet: IAR Embedded Workbench for MSP430 v5.51
+ **********************************************************************/
+#include "io430.h"
+#include "stdint.h"
+#include "adc10_cont.h"
+#include "sw_uart.h"
+#include "convert.h"
+#include "filter.h"
+
+#define FS        500                  //Mintavteli frekvencia (Hz)
+#define NDATA     FILT_MAINS_LEN(FS,50) //Egy blokk = egy 50 Hz-es peridus
+#define NBLOCK    50                   //Kirs 50 blokkonknt (1 s)
+uint16_t adc_data[2*NDATA];            //A DTC ktblokkos buffere
+filt_cic_t cic;                        //Blokkonknti CIC decimtor
+filt_iir_t iir;                        //Simts a blokkok kztt
+
+void main(void) {
+const uint16_t *p;
+uint16_t data;
+uint8_t n;
+  WDTCTL = WDTPW + WDTHOLD;            //Letiltjuk a watchdog idztt
+  DCOCTL = CALDCO_1MHZ;                //DCO belltsa a gyrilag kalibrlt
+  BCSCTL1 = CALBC1_1MHZ;               //1 MHz-es frekvencira
+//--- P1.3 bels felhzs engedlyezse -----------------------
+  P1DIR &= ~BIT3;                      //P1.3 legyen digitlis bemenet
+  P1OUT |= BIT3;                       //Felfel hzzuk, nem lefel
+  P1REN |= BIT3;                       //Bels felhzs engedlyezse
+//--- Analg csatornk engedlyezse --------------------------
+  ADC10AE0 |= BIT5;                    //P1.5 legyen analg bemenet
+//-- Timer_A belltsa: OUT0=500 Hz, SMCLK, "Felfel szmlls"
+    TACCR0 = 999;                      //A peridusid 1000 Hz
+    TACCTL0 = OUTMOD_4;                //Toggle md (OUT0 500 Hz lesz)
+    TACTL = TASSEL_2 |                 //SMCLK az rajel forrsa
+                ID_0 |                 //1:1 oszts belltsa
+                MC_1 |                 //Felfel szmll md
+                TACLR;                 //TAR trlse
+  sw_uart_init();                      //TXD kimenet, a fut Timer_A-t hasznlja
+  filt_cic_init(&cic,NDATA);           //Blokkonknt egy kimenet
+  ADC_cont_start_REF1_5V_TA(INCH_5,adc_data,NDATA); //Folyamatos mrs indul
+  for(n=0; n<FILT_CIC_ORDER; n++) {    //A CIC feltltse (FILT_CIC_ORDER blokk)
+    p = ADC_cont_get();
+    filt_cic_block(&cic,p,NDATA,&data);
+  }
+  filt_iir_init(&iir,3,data);          //Idlland: 8 blokk (160 ms)
+  while(1) {
+    for(n=0; n<NBLOCK; n++) {
+      p = ADC_cont_get();              //Alvs a kvetkez ksz blokkig
+      filt_cic_block(&cic,p,NDATA,&data); //50 Hz-es zavar kiszrse
+      data = filt_iir_put(&iir,data);  //Simts
+    }
+    sw_uart_puts("chan 5 = ");
+    sw_uart_out4hex(data);
+    sw_uart_outdec(conv_apply(&conv_mv_ref1_5v,data),3); //kirs V-ban
+    sw_uart_puts("V lost = ");
+    sw_uart_outdec(ADC_cont_overruns,0); //Elveszett blokkok szma
+    sw_uart_puts("\r\n");
+  }
+}
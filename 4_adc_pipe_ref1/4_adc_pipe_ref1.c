@@ -0,0 +1,238 @@
+/**********************************************************************
+ *  Launchpad demprogram: ADC_pipe_ref1
+ *
+ * Tbbfokozat feldolgozsi lnc: a mintavtel teme nem fgg a
+ * kirats sebessgtl. Mrs az A5 csatornban, 1,5 V-os bels
+ * referencival.
+ *
+ * A lnc fokozatai:
+ *  1. Mintavtel: Timer0 CCR0 kimenjele triggereli az ADC-t (~ 500 Hz),
+ *     a DTC ktblokkos zemmdban tlti a buffert (common/adc10_cont.c),
+ *     az ADC megszakts a ksz blokkot a 'blocks' sorba teszi,
+ *     idblyege a blokk sorszma. Szmll: blocks.overruns (tele sor)
+ *     + ADC_cont_overruns (a DTC mr fellrta): elveszett blokkok.
+ *  2. Feldolgozs: a 'blocks' sorbl vett blokkon CIC szr (egy blokk
+ *     = egy 50 Hz-es peridus), NDEC blokkonknt egy eredmny kerl a
+ *     'results' sorba, a blokk idblyegvel. Szmll: results.overruns
+ *     (a kirs nem gyzte, az eredmnyt eldobtuk), results.maxfill.
+ *  3. Kirats: a sorbl vett eredmnybl egy RAM bufferben lltja
+ *     ssze a teljes sort (common/line.c), s annyit r belle a
+ *     megszaktsos UART ad bufferbe, amennyi befr, sosem vr.
+ *     Szmll: lat_max (a legnagyobb ksleltets blokkokban).
+ *
+ * A fokozatokat a fprogram felvltva hvja, ha egyiknek sincs dolga,
+ * a CPU LPM0 mdban alszik, a blokk vge, az ad vagy a vev breszti fel.
+ *
+ * Bellts a soros vonalon (P1.2 RXD, szoftveres vev, common/cmd.c),
+ * minden sort "OK" vagy "ERR" vlasz kvet (a vlaszok sorban vrnak
+ * a kirsra, egy sem vsz el):
+ *   ch <n>   - a mrt csatorna (A0, A3 - A7)
+ *   dec <n>  - eredmny n blokkonknt (1 - 50)
+ * Ha NDEC rtkt 1-re cskkentjk, a kirats nem gyzi a tempt:
+ * a 'drop' szmll n, de a 'lost' 0 marad, a mintavtel egyenletes.
+ *
+ * Kirs: 9600 baud, 8 adatbit, nincs paritsbit, 2 stopbit
+ * (Timer_A CCR2 megszaktsos szoftveres UART ad, 16 bjtos buffer,
+ * a CCR1 a vev: SW_UART_RX).
+ *
+ * A gyrilag kalibrlt 1 MHz-es DCO rajelet hasznljuk:
+ * ACLK = n/a, MCLK = SMCLK = DCO 1 MHz
+ *
+ * Hardver kvetelmnyek:
+ *  - Launchpad MSP430G2452 vagy MSP430G2553 mikrovezrlvel
+ *    (a sorok s a szr miatt 128 bjt RAM nem elg)
+ *  - Az jabb kiads (v1.5) krtyn az RXD,TXD tktseket
+ *    SW llsba kell helyezni (a tbbi tktssel prhuzamosan)
+ *
+ *
+ *         MSP430G2452 vagy MSP430G2553
+ *             -----------------
+ *         /|\|              XIN|-
+ *          | |                 |
+ *          --|RST          XOUT|-
+ *            |                 |
+ *     TxD <--|P1.1         P1.5|<-- 0-1,5 V
+ *     RxD -->|P1.2             |
+ *
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ *  Fejleszti krnyezet: IAR Embedded Workbench for MSP430 v5.51
+ **********************************************************************/
+#include "io430.h"
+#include "stdint.h"
+#include "adc10_cont.h"
+#include "sw_uart_tx.h"
+#include "convert.h"
+#include "filter.h"
+#include "queue.h"
+#include "sw_uart_rx.h"
+#include "cmd.h"
+#include "line.h"
+
+#define FS        500                  //Mintavteli frekvencia (Hz)
+#define NDATA     FILT_MAINS_LEN(FS,50) //Egy blokk = egy 50 Hz-es peridus
+#ifndef NDEC
+#define NDEC      5                    //Eredmny 5 blokkonknt (100 ms)
+#endif
+#define NBLOCKQ   4                    //A blokksor mrete
+#define NRESULTS  4                    //Az eredmnysor mrete
+#define NREPLIES  4                    //A vlaszok sornak mrete
+uint16_t adc_data[2*NDATA];            //A DTC ktblokkos buffere
+QUEUE_DEFINE(blocks,NBLOCKQ);          //Mintavtel (ISR) -> feldolgozs
+filt_cic_t cic;                        //Blokkonknti CIC decimtor
+QUEUE_DEFINE(results,NRESULTS);        //Feldolgozs -> kirats
+uint8_t ndec = NDEC;                   //Eredmny ndec blokkonknt (parancs: dec)
+cmd_t cmd;                             //A parancsrtelmez llapota
+QUEUE_DEFINE(replies,NREPLIES);        //Parancs -> kirats: a vlaszok
+uint16_t lat_max;                      //Legnagyobb ksleltets (blokk)
+LINE_DEFINE(out,48);                   //A kirand sor
+const char *p_out;                     //A mg ki nem rt szveg
+uint8_t nout;                          //s a hossza
+
+/*-------------------------------------------------------------
+ * 2. fokozat: egy ksz blokk szrse
+ * Visszatrsi rtk: 1, ha volt feldolgozand blokk
+ *-------------------------------------------------------------*/
+uint8_t proc_stage(void) {
+static uint8_t cnt = NDEC;
+queue_item_t item;
+const uint16_t *p;
+uint16_t data;
+  if (!queue_get(&blocks,&item)) return 0;
+  p = ADC_cont_block(&item);
+  if (!p) return 1;                    //Mr fellrt blokk: ADC_cont_overruns n
+  filt_cic_block(&cic,p,NDATA,&data);  //50 Hz-es zavar kiszrse
+  if (--cnt == 0) {
+    cnt = ndec;
+    queue_put(&results,data,item.stamp); //Tele sor: results.overruns n
+  }
+  return 1;
+}
+
+/*-------------------------------------------------------------
+ * Mrs (jra)indtsa a megadott csatornn
+ *-------------------------------------------------------------*/
+void start_chan(uint8_t chan) {
+  ADC_cont_stop();
+  ADC10AE0 = 1 << chan;                //Legyen analg bemenet
+  filt_cic_init(&cic,NDATA);           //Blokkonknt egy kimenet
+  queue_init(&blocks,blocks_items,NBLOCKQ); //Az ISR csak indts utn r bele
+  ADC_cont_attach(&blocks);
+  queue_init(&results,results_items,NRESULTS); //A rgi idblyegek rvnytelenek
+  lat_max = 0;
+  ADC_cont_start_REF1_5V_TA((uint16_t)chan << 12,adc_data,NDATA);
+}
+
+/*-------------------------------------------------------------
+ * Parancsok: a mrt csatorna s a kirs gyakorisga
+ *-------------------------------------------------------------*/
+uint8_t cmd_ch(int16_t arg) {
+  if (arg < 0 || arg > 7 || arg == 1 || arg == 2) return CMD_BAD_ARG; //P1.1, P1.2: UART
+  start_chan((uint8_t)arg);
+  return CMD_OK;
+}
+
+uint8_t cmd_dec(int16_t arg) {
+  if (arg < 1 || arg > 50) return CMD_BAD_ARG;
+  ndec = (uint8_t)arg;
+  return CMD_OK;
+}
+
+const cmd_entry_t commands[] = {
+  { "ch",  cmd_ch },
+  { "dec", cmd_dec }
+};
+
+/*-------------------------------------------------------------
+ * Parancsfokozat: a vett karakterek feldolgozsa
+ * A vlasz (cmd_put eredmnye) a 'replies' sorba kerl. Ha a sor
+ * tele van, nem vesznk ki jabb karaktert, amg a kirats el nem
+ * viszi a vlaszokat: gy egy vlasz sem vsz el, a vrakoz
+ * karakterek a vev bufferben maradnak.
+ * Visszatrsi rtk: 1, ha volt vett karakter
+ *-------------------------------------------------------------*/
+uint8_t cmd_stage(void) {
+char c;
+uint8_t res;
+  if (queue_count(&replies) == NREPLIES - 1) return 0; //Tele a vlaszsor
+  if (!sw_uart_rx_get(&c)) return 0;
+  res = cmd_put(&cmd,c);
+  if (res != CMD_NONE) queue_put(&replies,res,0);
+  return 1;
+}
+
+/*-------------------------------------------------------------
+ * 3. fokozat: egy eredmnysor sszelltsa s kirsa, vrakozs
+ * nlkl. A sort egyben formzzuk, az ad bufferbe annyi kerl
+ * belle, amennyi befr, a maradk a kvetkez hvsokkor.
+ * Visszatrsi rtk: 1, ha trtnt elrelps
+ *-------------------------------------------------------------*/
+uint8_t out_stage(void) {
+queue_item_t item;
+uint16_t lat;
+uint8_t n;
+  if (nout) {                          //A flbehagyott sor folytatsa
+    n = sw_uart_write(p_out,nout);
+    p_out += n;
+    nout -= n;
+    return n != 0;
+  }
+  if (queue_get(&replies,&item)) {     //Sorok kztt: a parancs vlasza
+    p_out = (item.data == CMD_OK) ? "OK\r\n" : "ERR\r\n";
+    for (nout = 0; p_out[nout]; nout++);
+    return 1;
+  }
+  if (!queue_get(&results,&item)) return 0;
+  lat = ADC_cont_blocks - item.stamp;
+  if (lat > lat_max) lat_max = lat;
+  line_clear(&out);
+  line_dec(&out,conv_apply(&conv_mv_ref1_5v,item.data),3);
+  line_label(&out,"V lat=");
+  line_dec(&out,lat_max,0);
+  line_label(&out," lost=");
+  line_dec(&out,ADC_cont_overruns + blocks.overruns,0);
+  line_label(&out," drop=");
+  line_dec(&out,results.overruns,0);
+  line_label(&out,"\r\n");
+  p_out = out.buf;                     //A ksz sor egyetlen tadssal
+  nout = out.len;
+  return 1;
+}
+
+void main(void) {
+uint8_t n;
+  WDTCTL = WDTPW + WDTHOLD;            //Letiltjuk a watchdog idztt
+  DCOCTL = CALDCO_1MHZ;                //DCO belltsa a gyrilag kalibrlt
+  BCSCTL1 = CALBC1_1MHZ;               //1 MHz-es frekvencira
+//--- P1.3 bels felhzs engedlyezse -----------------------
+  P1DIR &= ~BIT3;                      //P1.3 legyen digitlis bemenet
+  P1OUT |= BIT3;                       //Felfel hzzuk, nem lefel
+  P1REN |= BIT3;                       //Bels felhzs engedlyezse
+//-- Timer_A belltsa: OUT0=500 Hz, SMCLK, "Felfel szmlls"
+    TACCR0 = 999;                      //A peridusid 1000 Hz
+    TACCTL0 = OUTMOD_4;                //Toggle md (OUT0 500 Hz lesz)
+    TACTL = TASSEL_2 |                 //SMCLK az rajel forrsa
+                ID_0 |                 //1:1 oszts belltsa
+                MC_1 |                 //Felfel szmll md
+                TACLR;                 //TAR trlse
+  sw_uart_tx_init();                   //TXD kimenet, a fut Timer_A-t hasznlja
+  sw_uart_rx_init();                   //RXD bemenet, CCR1 rgzts
+  cmd_init(&cmd,commands,sizeof(commands)/sizeof(commands[0]));
+  start_chan(5);                       //Folyamatos mrs indul az A5-n
+  while(1) {
+    n = proc_stage();                  //A feldolgozs elsbbsget kap
+    if (!n) n = cmd_stage();
+    if (!n) n = out_stage();
+    if (!n) {                          //Nincs teend: alvs
+      __disable_interrupt();
+      if (!queue_count(&blocks)        //Kzben nem jtt j blokk,
+          && (!sw_uart_rx_avail()      //karakter sem (vagy nem vehetjk t),
+              || queue_count(&replies) == NREPLIES - 1) //s
+          && (!nout || sw_uart_tx_wake())) { //nincs kirand, vagy az ad breszt
+        __low_power_mode_0();          //A blokk vge is felbreszt
+      }
+      __enable_interrupt();
+    }
+  }
+}
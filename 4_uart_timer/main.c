@@ -0,0 +1,53 @@
+/************************************************************************************
+ *  Launchpad demprogram: uart_timer
+ *
+ * Szveg kiratsa soros kapcsolaton keresztl, egyirny szoftveres UART kezels,
+ * ahol a biteket a Timer_A CCR1 megszaktsa lpteti ki (common/sw_uart_tx.c).
+ * Paramterek: 9600 baud, 8 adatbit, nincs paritsbit, 2 stopbit
+ * A gyrilag kalibrlt 1 MHz-es DCO rajelet hasznljuk:
+ * ACLK = VLO (idzts), MCLK = SMCLK = DCO 1 MHz
+ *
+ * A sw_uart_write() csak a krbufferbe r, azonnal visszatr. A kirs
+ * alatt a CPU LPM0 mdban alszik (sw_uart_tx_flush), a bitidt Timer_A
+ * mri ki, nem a __delay_cycles() hangolsa.
+ *
+ * Hardver kvetelmnyek:
+ *  - Launchpad MSP430G2xxx mikrovezrlvel
+ *  - Az jabb kiads (v1.5) krtyn az RXD,TXD tktseket
+ *    SW llsba kell helyezni (a tbbi tktssel prhuzamosan)
+ *
+ *                MSP430G2xxx
+ *             -----------------
+ *         /|\|              XIN|-
+ *          | |                 |
+ *          --|RST          XOUT|-
+ *            |                 |
+ *     TxD <--|P1.1             |
+ *
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ *  Fejleszti krnyezet: IAR Embedded Workbench for MSP430 v5.51
+ ************************************************************************************/
+#include "io430.h"
+#include "stdint.h"
+#include "tick.h"
+#include "sw_uart_tx.h"
+
+void main(void) {
+  WDTCTL = WDTPW + WDTHOLD;       //Letiltjuk a watchdog idztt
+  DCOCTL = CALDCO_1MHZ;           // DCO belltsa a gyrilag kalibrlt
+  BCSCTL1 = CALBC1_1MHZ;          // 1 MHz-es frekvencira
+  tick_init();                    //ACLK = VLO, WDT idalap, LPM3 alvs
+//---  P1.3 bemenet legyen, bels felhzst engedlyezzk ------
+  P1DIR &= ~BIT3;                 //P1.3 legyen digitlis bemenet
+  P1OUT |= BIT3;                  //Felfel hzzuk, nem lefel
+  P1REN |= BIT3;                  //Bels felhzs engedlyezse
+//--- A TXD kimenet s Timer_A belltsa -----------------------
+  sw_uart_tx_init();              //SMCLK, folytonos szmlls
+  while(1) {
+    sleep_ms(1000);               //1 msodperc vrakozs
+    sw_uart_write("Hello world!\r\n",14);  //Egy sor a bufferbe
+    sw_uart_tx_flush();           //Alvs, amg ki nem megy
+  }
+}
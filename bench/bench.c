@@ -0,0 +1,149 @@
+/**********************************************************************
+ *  Benchmark program a kzs eljrsok futsidejnek mrsre
+ *
+ * Az mspdebug "sim" szimultorban fut (bench/run_bench.py indtja).
+ * Minden mrend hvst a bench_begin(id) s bench_end(id) hvsok
+ * fognak kzre, ezekre a szimultorban trspontot tesznk, s a
+ * "tracer" szimullt perifria ciklusszmlljt olvassuk ki.
+ * A 0-s azonostj res mrs adja a keret sajt idejt, ezt a
+ * szkript levonja a tbbi eredmnybl.
+ *
+ * Az azonostk sorrendje meg kell, hogy egyezzen a run_bench.py
+ * BENCHMARKS listjval!
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "stdint.h"
+#include "sw_uart.h"
+#include "format.h"
+#include "stat.h"
+#include "convert.h"
+#include "line.h"
+#include "pwm_ctrl.h"
+
+#define NDATA     32                   //Az tlagolt adatok szma
+
+volatile uint16_t bench_id;            //Az ppen mrt eljrs azonostja
+volatile uint16_t adc_in = 0x01F3;     //Bemen adat (volatile: ne legyen konstans)
+volatile int32_t result;               //Eredmny (volatile: ne optimalizlja ki)
+uint16_t adc_data[NDATA];
+char s[FMT_DEC_SIZE];
+LINE_DEFINE(line,40);                  //Egy rekord a 15-16. mrshez
+pwm_ctrl_t ctrl;                       //A PWM szablyoz (17. mrs)
+stat_block_t st;                       //Blokkstatisztika (18-19. mrs)
+
+//--- 128 mints blokk a flash-ben (a G2231 RAM-ja kicsi) --------------
+#define R4(x)     (x), (x)+1, (x)+3, (x)+2
+#define R16(x)    R4(x), R4((x)+9), R4((x)+5), R4((x)+12)
+static const uint16_t blk_data[128] = {
+  R16(0x1F0), R16(0x210), R16(0x1C4), R16(0x230),
+  R16(0x1E2), R16(0x205), R16(0x1B0), R16(0x220)
+};
+
+/*-------------------------------------------------------------
+ * A mrsi keret: ezekre kerl trspont a szimultorban
+ *-------------------------------------------------------------*/
+void __attribute__((noinline)) bench_begin(uint16_t id) {
+  bench_id = id;
+}
+
+void __attribute__((noinline)) bench_end(uint16_t id) {
+  bench_id = id;
+}
+
+void main(void) {
+  uint8_t i;
+  WDTCTL = WDTPW + WDTHOLD;            //Letiltjuk a watchdog idztt
+  sw_uart_init();                      //TXD kimenet, alaphelyzete: mark
+  for(i=0; i<NDATA; i++) adc_data[i] = 0x3F0 + i;
+
+  bench_begin(0);                      //0: res keret
+  bench_end(0);
+
+  bench_begin(1);                      //1: egy karakter kikldse
+  sw_uart_putc('U');
+  bench_end(1);
+
+  bench_begin(2);                      //2: 4 jegy hexa kirs
+  sw_uart_out4hex(adc_in);
+  bench_end(2);
+
+  bench_begin(3);                      //3: decimlis kirs 3 tizedesre
+  sw_uart_outdec(1234567L,3);
+  bench_end(3);
+
+  bench_begin(4);                      //4: csak a formzs
+  fmt_dec(s,1234567L,3);
+  bench_end(4);
+
+  bench_begin(5);                      //5: 32 adat tlagolsa
+  result = avg(adc_data,NDATA);
+  bench_end(5);
+
+  bench_begin(6);                      //6: mV, 1,5 V referencia
+  result = (int32_t)adc_in*1500L/1023;
+  bench_end(6);
+
+  bench_begin(7);                      //7: mV, 2,5 V referencia
+  result = (int32_t)adc_in*2500L/1023;
+  bench_end(7);
+
+  bench_begin(8);                      //8: mV, VCC (3,5 V) referencia
+  result = (int32_t)adc_in*3500L/1023;
+  bench_end(8);
+
+  bench_begin(9);                      //9: hmrsklet, 1,5 V referencia
+  result = ((int32_t)adc_in*270687L - 182023932L) >> 16;
+  bench_end(9);
+
+  bench_begin(10);                     //10: hmrsklet, VCC referencia
+  result = ((uint32_t)adc_in*2467L - 711030L) >> 8;
+  bench_end(10);
+
+  bench_begin(11);                     //11: mV, 1,5 V, szorzs-lptets
+  result = conv_apply(&conv_mv_ref1_5v,adc_in);
+  bench_end(11);
+
+  bench_begin(12);                     //12: hmrsklet, 1,5 V, szorzs-lptets
+  result = conv_apply(&conv_temp_ref1_5v,adc_in);
+  bench_end(12);
+
+  bench_begin(13);                     //13: 16 minta decimlsa 12 bitre
+  result = decimate(adc_data,2);
+  bench_end(13);
+
+  bench_begin(14);                     //14: mV, 1,5 V, 12 bites kd
+  result = conv_apply_os(&conv_mv_ref1_5v,adc_in,2);
+  bench_end(14);
+
+  bench_begin(15);                     //15: egy rekord sszelltsa
+  line_clear(&line);
+  line_label(&line,"chan 5 = ");
+  line_hex4(&line,adc_in);
+  line_dec(&line,1234567L,3);
+  line_label(&line,"V temp = ");
+  line_dec(&line,-123L,1);
+  line_label(&line," C\r\n");
+  bench_end(15);
+
+  bench_begin(16);                     //16: a ksz rekord kikldse
+  sw_uart_send(line.buf,line.len);
+  bench_end(16);
+
+  pwm_ctrl_init(&ctrl,3,2,0);
+  bench_begin(17);                     //17: PWM szablyoz, egy ADC mrs
+  result = pwm_ctrl_put(&ctrl,adc_in);
+  bench_end(17);
+
+  bench_begin(18);                     //18: blokkstatisztika, 32 minta
+  stat_block(adc_data,5,&st);
+  bench_end(18);
+
+  bench_begin(19);                     //19: blokkstatisztika, 128 minta
+  stat_block(blk_data,7,&st);
+  bench_end(19);
+
+  for(;;);                             //Vge
+}
@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+# -*- coding: iso-8859-2 -*-
+# ---------------------------------------------------------------------
+#  A pwm_ctrl.c fnyessg-korrekcis tblzatnak ellltsa.
+#  A bemenet (0..1023) a kvnt rzkelt vilgossg (CIE 1976 L*,
+#  0..100 %), a kimenet a hozz tartoz relatv fnysrsg (Y) a
+#  PWM kitlts skljn (0..1023):
+#      Y = L* / 903.3                  ha L* <= 8
+#      Y = ((L* + 16) / 116)^3         klnben
+#  A tblzat PWM_CTRL_TAB_N + 1 pontbl ll (a bemenet fels bitjei
+#  indexelik, az als bitekkel linerisan interpollunk): az i. pont
+#  bemenete i * 1024 / PWM_CTRL_TAB_N, a teljes sklnl levgva.
+#  Az utols pontot gy vlasztjuk, hogy a legnagyobb kd (1023)
+#  teljes kitltst adjon.
+#
+#  Hasznlat:
+#    cie_table.py [--points 129] [--top 1023] [--gamma 0]
+#  --gamma > 0 esetn a CIE grbe helyett egyszer hatvnyfggvny
+#  (Y = x^gamma) tblzatt rja ki.
+# ---------------------------------------------------------------------
+import argparse
+
+
+def cie(x):
+    """A relatv fnysrsg (0..1) az L* vilgossg (0..1) fggvnyben."""
+    l = x * 100.0
+    if l <= 8.0:
+        return l / 903.3
+    return ((l + 16.0) / 116.0) ** 3
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--points", type=int, default=129)
+    ap.add_argument("--top", type=int, default=1023)
+    ap.add_argument("--gamma", type=float, default=0.0)
+    a = ap.parse_args()
+    n = a.points - 1
+    step = (a.top + 1) / n                          # Bemen kd pontonknt
+    vals = []
+    for i in range(a.points):
+        x = min(1.0, i * step / a.top)
+        y = x ** a.gamma if a.gamma > 0 else cie(x)
+        vals.append(int(round(y * a.top)))
+    # Az utols pont a skln tlra mutat: a legnagyobb kd (top) a
+    # lineris interpolcival (lefel kerektve) pontosan top legyen
+    seg = int(step)
+    f = a.top - (n - 1) * seg                       # Trtrsz a vgn
+    vals[n] = vals[n - 1] + -(-(a.top - vals[n - 1]) * seg // f)
+    print("static const uint16_t cie_tab[PWM_CTRL_TAB_N + 1] = {")
+    for i in range(0, len(vals), 10):
+        row = ", ".join("%4d" % v for v in vals[i:i + 10])
+        sep = "," if i + 10 < len(vals) else ""
+        print("  " + row + sep)
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
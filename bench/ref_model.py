@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+# -*- coding: iso-8859-2 -*-
+# ---------------------------------------------------------------------
+#  A bels referencia kezelsi mdjainak (common/adc10_ref.c) becslt
+#  tlts- s idignye egy mrsre vettve, a mrsek kztti id
+#  fggvnyben. Az alaprtkek az MSP430G2x53 adatlapjnak tipikus
+#  rtkei (3 V, 1 MHz MCLK, ADC10OSC = 5 MHz).
+#
+#    ADC_REF_ON_DEMAND: a referencia minden mrshez bekapcsol, a CPU
+#                       a bellsi idt aktvan kivrja
+#    ADC_REF_ALWAYS_ON: a referencia folyamatosan fogyaszt, de nincs
+#                       bellsi id
+#
+#  Hasznlat:
+#    ref_model.py [--interval 0.001 0.01 0.1 1 10] [--sht 64]
+#                 [--i-ref 250] [--i-adc 600] [--i-cpu 230]
+#                 [--t-settle 30] [--f-adc 5.0]
+#  Az eredmny: uA*s (azaz uC) s us mrsenknt.
+# ---------------------------------------------------------------------
+import argparse
+
+
+def model(interval, a):
+    """(tlts uA*s, ksleltets us) mrsenknt, mindkt mdra."""
+    t_conv = (a.sht + 13) / a.f_adc                 # us
+    q_adc = a.i_adc * t_conv * 1e-6                 # uA*s
+    on_demand = (a.i_ref * (a.t_settle + t_conv) * 1e-6
+                 + a.i_cpu * a.t_settle * 1e-6 + q_adc,
+                 a.t_settle + t_conv)
+    always_on = (a.i_ref * interval + q_adc, t_conv)
+    return on_demand, always_on
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--interval", type=float, nargs="+",
+                    default=[1e-4, 1e-3, 1e-2, 0.1, 1.0, 10.0],
+                    help="a mrsek kztti id (s)")
+    ap.add_argument("--sht", type=int, default=64,
+                    help="mintavteli id ADC10OSC temben (ADC10SHT_3: 64)")
+    ap.add_argument("--i-ref", type=float, default=250.0, help="referencia ram (uA)")
+    ap.add_argument("--i-adc", type=float, default=600.0, help="ADC10 ram (uA)")
+    ap.add_argument("--i-cpu", type=float, default=230.0, help="aktv CPU ram (uA)")
+    ap.add_argument("--t-settle", type=float, default=30.0, help="bellsi id (us)")
+    ap.add_argument("--f-adc", type=float, default=5.0, help="ADC10OSC (MHz)")
+    a = ap.parse_args()
+
+    print("%12s  %14s %10s  %14s %10s" % ("intervallum", "ON_DEMAND", "", "ALWAYS_ON", ""))
+    print("%12s  %14s %10s  %14s %10s" % ("s", "uA*s", "us", "uA*s", "us"))
+    for t in a.interval:
+        (qd, td), (qa, ta) = model(t, a)
+        print("%12g  %14.6g %10.1f  %14.6g %10.1f" % (t, qd, td, qa, ta))
+    # Ahol a kt md tltsignye megegyezik
+    (qd, _), (qa0, _) = model(0.0, a)
+    print("\nA mindig bekapcsolt md %.1f us mrsi idkz alatt takarkosabb."
+          % ((qd - qa0) / a.i_ref * 1e6))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,231 @@
+#!/usr/bin/env python3
+# -*- coding: iso-8859-2 -*-
+# ---------------------------------------------------------------------
+#  Benchmark futtat: a bench.elf programot az mspdebug "sim"
+#  szimultorban futtatja, s minden mrsrl kirja:
+#    - a ciklusszmot (a keret sajt idejvel cskkentve),
+#    - a mrt fggvny kdmrett (msp430-elf-nm --print-size),
+#    - a veremignyt (-fstack-usage .su fjlok).
+#  Az eredmny CSV tblzat. Alaprtkekkel (--baseline) sszevetve
+#  1-es kilpsi kddal jelzi, ha valamelyik rtk megntt. A BUDGETS
+#  mrsek ciklusignyt a fejlcekben megadott korltokkal is sszeveti
+#  (pl. STAT_BLOCK_BUDGET), s kirja a tartalkot. A bench 1
+#  (sw_uart_putc) ciklusszmbl kiszmolja a SW_UART_LOOP_CYCLES mrt
+#  rtkt, s hibt ad, ha a belltott rtk nem felel meg neki.
+#  A trolban nincs bench/baseline.csv (szimultoros futs mg nem
+#  volt); az els mrs eredmnybl kell ltrehozni (CMake: a
+#  bench_baseline cl):
+#    run_bench.py --elf bench.elf --su-dir DIR --csv bench/baseline.csv
+#  Ha a --baseline fjl hinyzik, a program a szimulci eltt, 2-es
+#  kddal lell (a run_bench CMake cl mindig megadja).
+#
+#  Hasznlat:
+#    run_bench.py --elf bench.elf [--su-dir DIR] [--csv out.csv]
+#                 [--baseline bench/baseline.csv [--tolerance 0.02]]
+# ---------------------------------------------------------------------
+import argparse
+import csv
+import glob
+import os
+import re
+import subprocess
+import sys
+
+# (azonost, nv, mrt fggvny) - a bench.c sorrendjben!
+BENCHMARKS = [
+    (1,  "sw_uart_putc",       "sw_uart_putc"),
+    (2,  "sw_uart_out4hex",    "sw_uart_out4hex"),
+    (3,  "sw_uart_outdec",     "sw_uart_outdec"),
+    (4,  "fmt_dec",            "fmt_dec"),
+    (5,  "avg_32",             "avg"),
+    (6,  "mv_ref1_5v",         None),
+    (7,  "mv_ref2_5v",         None),
+    (8,  "mv_vcc",             None),
+    (9,  "temp_ref1_5v",       None),
+    (10, "temp_vcc",           None),
+    (11, "conv_mv_ref1_5v",    "conv_apply"),
+    (12, "conv_temp_ref1_5v",  "conv_apply"),
+    (13, "decimate_16",        "decimate"),
+    (14, "conv_os_mv_ref1_5v", "conv_apply_os"),
+    (15, "line_record",        None),
+    (16, "sw_uart_send",       "sw_uart_send"),
+    (17, "pwm_ctrl_put",       "pwm_ctrl_put"),
+    (18, "stat_block_32",      "stat_block"),
+    (19, "stat_block_128",     "stat_block"),
+]
+
+# Ciklusigny korltok: (mrs, fejlc, makr, egysgek szma). A mrt
+# ciklusszm egysgenknt (pl. mintnknt) nem lehet nagyobb a fejlcben
+# megadott korltnl, klnben a run_bench hibval ll le.
+BUDGETS = [
+    ("stat_block_32",  "stat.h", "STAT_BLOCK_BUDGET", 32),
+    ("stat_block_128", "stat.h", "STAT_BLOCK_BUDGET", 128),
+    ("pwm_ctrl_put",   "pwm_ctrl.h", "PWM_CTRL_BUDGET", 1),
+]
+SAMPLE_CYCLES = 1000000 // 500          # 500 Hz, 1 MHz: ciklus/minta
+PUTC_SLACK = 3                          # sw_uart_putc: hvs sajt ideje/bit
+
+CYCLES_RE = re.compile(r'cycles?\D*?(\d+)', re.IGNORECASE)
+
+
+def run_sim(mspdebug, elf):
+    """A szimulci lefuttatsa, a ciklusszmll llsai sorrendben."""
+    cmds = ["prog %s" % elf,
+            "simio add tracer tr",
+            "simio add gpio p1",
+            "simio config p1 base 0x20",
+            "setbreak bench_begin",
+            "setbreak bench_end"]
+    for _ in range(len(BENCHMARKS) + 1):           # +1: a 0-s res keret
+        cmds += ["run", "simio info tr", "run", "simio info tr"]
+    out = subprocess.run([mspdebug, "-q", "sim"] + cmds,
+                         stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                         universal_newlines=True, check=False).stdout
+    counts = [int(m.group(1)) for m in CYCLES_RE.finditer(out)]
+    if len(counts) < 2 * (len(BENCHMARKS) + 1):
+        sys.stderr.write(out)
+        sys.exit("run_bench: kevs ciklusszm a szimultor kimenetben")
+    return counts
+
+
+def func_sizes(nm, elf):
+    """Fggvnymretek bjtban (msp430-elf-nm --print-size)."""
+    sizes = {}
+    out = subprocess.check_output([nm, "--print-size", elf],
+                                  universal_newlines=True)
+    for line in out.splitlines():
+        f = line.split()
+        if len(f) == 4 and f[2] in "tT":
+            sizes[f[3]] = int(f[1], 16)
+    return sizes
+
+
+def stack_usage(su_dir):
+    """Veremigny bjtban a -fstack-usage .su fjljaibl."""
+    usage = {}
+    if not su_dir:
+        return usage
+    for su in glob.glob(os.path.join(su_dir, "**", "*.su"), recursive=True):
+        for line in open(su):
+            f = line.split("\t")
+            if len(f) >= 2:
+                usage[f[0].split(":")[-1]] = int(f[1])
+    return usage
+
+
+def header_define(header, macro):
+    """Egsz rtk makr a common/ fejlcbl (#define MAKR rtk)."""
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                        os.pardir, "common", header)
+    pat = re.compile(r'^\s*#define\s+%s\s+(\d+)' % macro)
+    for line in open(path, encoding="iso-8859-2"):
+        m = pat.match(line)
+        if m:
+            return int(m.group(1))
+    sys.exit("run_bench: nincs %s a %s fjlban" % (macro, header))
+
+
+def check_budgets(rows):
+    """A ciklusigny korltok ellenrzse, a tartalk kirsa."""
+    cycles = {r["name"]: r["cycles"] for r in rows}
+    failed = False
+    for name, header, macro, units in BUDGETS:
+        limit = header_define(header, macro)
+        per = cycles[name] / float(units)
+        sys.stderr.write("%-15s %7.1f ciklus/egysg, korlt %s = %d"
+                         % (name, per, macro, limit))
+        if units > 1:
+            sys.stderr.write(", tartalk 500 Hz-en (1 MHz) %.0f ciklus/minta"
+                             % (SAMPLE_CYCLES - per))
+        sys.stderr.write("\n")
+        if per > limit:
+            sys.stderr.write("KORLT: %s %.1f > %s (%d)\n"
+                             % (name, per, macro, limit))
+            failed = True
+    return failed
+
+
+def check_loop_cycles(rows):
+    """SW_UART_LOOP_CYCLES a bench 1 (sw_uart_putc) ciklusszmbl.
+
+    A bench alapbelltssal fordul (CLOCK_MHZ, SW_UART_BAUD,
+    SW_UART_STOPBITS a fejlcekbl); a keret idelis hossza
+    SW_UART_EDGE(NBITS), a tbblet bitenknt a sajt id hibja."""
+    smclk = header_define("clock.h", "CLOCK_MHZ") * 1000000
+    baud = header_define("sw_uart.h", "SW_UART_BAUD")
+    nbits = 1 + 8 + header_define("sw_uart.h", "SW_UART_STOPBITS")
+    loop = header_define("sw_uart.h", "SW_UART_LOOP_CYCLES")
+    frame = (nbits * smclk + baud // 2) // baud       # SW_UART_EDGE(NBITS)
+    n = {r["name"]: r["cycles"] for r in rows}["sw_uart_putc"]
+    extra = (n - frame) / float(nbits)
+    sys.stderr.write("sw_uart_putc    %d ciklus, keret %d: SW_UART_LOOP_CYCLES "
+                     "mrt rtke kb. %.1f (belltva %d)\n"
+                     % (n, frame, loop + extra, loop))
+    if extra < 0 or extra > PUTC_SLACK:
+        sys.stderr.write("KORLT: SW_UART_LOOP_CYCLES = %d, a mrs szerint "
+                         "kb. %.1f\n" % (loop, loop + extra))
+        return True
+    return False
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--elf", required=True)
+    ap.add_argument("--su-dir")
+    ap.add_argument("--mspdebug", default="mspdebug")
+    ap.add_argument("--nm", default="msp430-elf-nm")
+    ap.add_argument("--csv")
+    ap.add_argument("--baseline")
+    ap.add_argument("--tolerance", type=float, default=0.0)
+    args = ap.parse_args()
+    if args.baseline and not os.path.isfile(args.baseline):
+        sys.stderr.write("run_bench: nincs alaprtk fjl: %s\n"
+                         "  Az els mrsbl hozzuk ltre (CMake: --target "
+                         "bench_baseline):\n"
+                         "    run_bench.py --elf %s --csv %s\n"
+                         "  (A trolban nincs bench/baseline.csv: "
+                         "szimultoros futs mg nem volt.)\n"
+                         % (args.baseline, args.elf, args.baseline))
+        sys.exit(2)
+
+    counts = run_sim(args.mspdebug, args.elf)
+    spans = [counts[2*i+1] - counts[2*i] for i in range(len(counts) // 2)]
+    frame = spans[0]                                # res keret
+    sizes = func_sizes(args.nm, args.elf)
+    stack = stack_usage(args.su_dir)
+
+    rows = []
+    for (bid, name, func), span in zip(BENCHMARKS, spans[1:]):
+        rows.append({"name": name,
+                     "cycles": span - frame,
+                     "flash": sizes.get(func, "") if func else "",
+                     "stack": stack.get(func, "") if func else ""})
+
+    fields = ["name", "cycles", "flash", "stack"]
+    out = open(args.csv, "w", newline="") if args.csv else sys.stdout
+    w = csv.DictWriter(out, fieldnames=fields)
+    w.writeheader()
+    w.writerows(rows)
+    if args.csv:
+        out.close()
+
+    failed = check_budgets(rows)
+    failed = check_loop_cycles(rows) or failed
+    if args.baseline:                               # Regresszik keresse
+        base = {r["name"]: r for r in csv.DictReader(open(args.baseline))}
+        for r in rows:
+            b = base.get(r["name"])
+            if not b:
+                continue
+            for key in ("cycles", "flash", "stack"):
+                if b[key] == "" or r[key] == "":
+                    continue
+                if int(r[key]) > int(b[key]) * (1.0 + args.tolerance):
+                    sys.stderr.write("REGRESSZI: %s %s %s -> %s\n"
+                                     % (r["name"], key, b[key], r[key]))
+                    failed = True
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
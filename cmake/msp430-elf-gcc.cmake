@@ -0,0 +1,34 @@
+# ---------------------------------------------------------------------
+#  CMake toolchain fjl a TI msp430-elf-gcc fordthoz
+#
+#  Hasznlat:
+#    cmake -S . -B build-msp430 -DCMAKE_TOOLCHAIN_FILE=cmake/msp430-elf-gcc.cmake
+#          [-DMSP430_TOOLCHAIN_DIR=/opt/ti/msp430-gcc]
+#          [-DMSP430_SUPPORT_DIR=/opt/ti/msp430-gcc/include]
+#    cmake --build build-msp430
+#    cmake --build build-msp430 --target size
+# ---------------------------------------------------------------------
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR msp430)
+
+set(MSP430_TOOLCHAIN_DIR "$ENV{MSP430_TOOLCHAIN_DIR}" CACHE PATH
+    "Az msp430-elf-gcc teleptsi knyvtra (res: keress a PATH-ban)")
+if(MSP430_TOOLCHAIN_DIR)
+  set(_msp430_bin "${MSP430_TOOLCHAIN_DIR}/bin/")
+else()
+  set(_msp430_bin "")
+endif()
+
+set(CMAKE_C_COMPILER   "${_msp430_bin}msp430-elf-gcc")
+set(CMAKE_ASM_COMPILER "${_msp430_bin}msp430-elf-gcc")
+set(CMAKE_SIZE         "${_msp430_bin}msp430-elf-size" CACHE FILEPATH "msp430-elf-size")
+
+# A tmogat fjlok (eszkzfejlcek, linker szkriptek) knyvtra
+set(MSP430_SUPPORT_DIR "" CACHE PATH "msp430-gcc-support-files include knyvtra")
+if(NOT MSP430_SUPPORT_DIR AND MSP430_TOOLCHAIN_DIR)
+  set(MSP430_SUPPORT_DIR "${MSP430_TOOLCHAIN_DIR}/include")
+endif()
+
+# A fordt prbja nem tud eszkz nlkl linkelni
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
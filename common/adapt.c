@@ -0,0 +1,96 @@
+/**********************************************************************
+ *  adapt.c
+ *
+ * Jelaktivitstl fgg mrsi gyakorisg (lsd adapt.h).
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "adapt.h"
+#include "tick.h"
+
+/**------------------------------------------------------------
+ *  Egy csatorna szablyozjnak inicializlsa
+ *-------------------------------------------------------------
+ * p_a - a szablyoz llapota
+ * p_cfg - a csatorna belltsai (a futs vgig rvnyes marad)
+ * Az els mrs azonnal esedkes, utna t_min idkz kvetkezik.
+ */
+void adapt_init(adapt_t *p_a, const adapt_cfg_t *p_cfg) {
+  p_a->p_cfg = p_cfg;
+  p_a->period = p_cfg->t_min;
+  p_a->next = tick_ms();
+  p_a->last = 0;
+  p_a->calm = 0;
+  p_a->primed = 0;
+  p_a->busy = 0;
+  p_a->span = 0;
+}
+
+/**------------------------------------------------------------
+ *  Alvs a legkorbban esedkes csatorna mrsig (LPM3)
+ *-------------------------------------------------------------
+ * p_tab - a csatornk szablyozi
+ * n - a csatornk szma (legalbb 1)
+ * Visszatrsi rtk: az esedkes csatorna indexe. Ha mr
+ * kssben van, nem alszik.
+ */
+uint8_t adapt_wait(adapt_t *p_tab, uint8_t n) {
+  uint8_t i, k;
+  int16_t d, dmin;
+  uint16_t now = tick_ms();
+  k = 0;
+  dmin = 0x7FFF;
+  for(i=0; i<n; i++) {
+    d = (int16_t)(p_tab[i].next - now); //Krbeforduls-biztos klnbsg
+    if (d < dmin) {
+      dmin = d;
+      k = i;
+    }
+  }
+  if (dmin > 0) sleep_ms(dmin);
+  return k;
+}
+
+/**------------------------------------------------------------
+ *  Egy mrs eredmnye: a kvetkez idkz kiszmtsa
+ *-------------------------------------------------------------
+ * p_a - a csatorna szablyozja
+ * x - a mrt rtk (pl. a decimlt blokk)
+ * spread - a blokk terjedelme (spread(), vagy 0, ha nem figyeljk)
+ * Visszatrsi rtk: a kvetkez mrsig htralev idkz (ms)
+ * A kvetkez mrs ideje az esedkessg, nem a mostani id utn
+ * szmt, gy a mrs ideje nem cssztatja az temezst.
+ */
+uint16_t adapt_put(adapt_t *p_a, uint16_t x, uint16_t spread) {
+  const adapt_cfg_t *p_cfg = p_a->p_cfg;
+  uint16_t dx;
+  dx = (x > p_a->last) ? x - p_a->last : p_a->last - x;
+  if (!p_a->primed || dx > p_cfg->slope || spread > p_cfg->spread) {
+    p_a->period = p_cfg->t_min;        //Aktivits: azonnal a leggyorsabb tem
+    p_a->calm = 0;
+    p_a->primed = 1;
+  } else if (++p_a->calm >= p_cfg->hold) {
+    p_a->calm = 0;                     //Nyugalom: az idkz ktszerezdik
+    p_a->period = (p_a->period > p_cfg->t_max / 2) ? p_cfg->t_max : p_a->period << 1;
+  }
+  p_a->last = x;
+  p_a->next += p_a->period;
+  p_a->busy += p_cfg->t_busy;
+  p_a->span += p_a->period;
+  if (p_a->span >= ADAPT_SPAN_MAX) {   //busy * 1000 ne csorduljon tl
+    p_a->busy >>= 1;
+    p_a->span >>= 1;
+  }
+  return p_a->period;
+}
+
+/**------------------------------------------------------------
+ *  Az ADC kitltse ezrelkben (mrsi id / eltelt id)
+ *-------------------------------------------------------------
+ * p_a - a csatorna szablyozja
+ */
+uint16_t adapt_duty(const adapt_t *p_a) {
+  if (!p_a->span) return 0;
+  return (uint16_t)(p_a->busy * 1000 / p_a->span);
+}
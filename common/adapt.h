@@ -0,0 +1,65 @@
+/**********************************************************************
+ *  adapt.h
+ *
+ * Jelaktivitstl fgg mrsi gyakorisg, csatornnknt. Nyugodt
+ * jelnl a mrsek kztti idkz fokozatosan n (hold egyms utni
+ * nyugodt mrs utn ktszerezdik, legfeljebb t_max-ig), a CPU
+ * kzben LPM3-ban alszik (sleep_ms). Ha a jel az elz mrshez kpest
+ * slope-nl tbbet lpett, vagy a mrsi blokk terjedelme (stat.h,
+ * spread()) nagyobb, mint spread, az idkz azonnal t_min lesz.
+ *
+ * Ksleltetsi garancia: egy ugrst a csatorna kvetkez mrse
+ * szlel, ez legksbb t_max mlva esedkes. Addigra a tbbi (n-1)
+ * csatorna mrse is esedkess vlhat, s mindegyik mrse (t_busy)
+ * utn a kirs (t_print, a sor adsi ideje, sw_uart_flush) is a
+ * fprogramban fut, gy a korlt
+ *   t_max + n*t_busy + (n-1)*t_print + egy tick,
+ * kt csatornra t_max + 2*t_busy + t_print. Egy 55 karakteres sor
+ * 9600 baud, 2 stop bit mellett 55*11/9600 s = kb. 63 ms. Onnantl
+ * t_min idkzzel mrnk. A felbonts egy tick (kb. 5 ms, tick.h).
+ *
+ * Kitlts: az ADC-vel tlttt id (mrsenknt t_busy) s az eltelt
+ * id arnya ezrelkben (adapt_duty()), az lland t_min idkz
+ * mrshez kpest ebbl becslhet a megtakarts. A kt szmll
+ * 2^22 ms (kb. 70 perc) felett felezdik, gy a kitlts az utols
+ * egy-kt ra tlaga.
+ *
+ * Felttelek:
+ *  - t_busy < t_min <= t_max <= 32767 (a tick_ms() 16 bites)
+ *  - a tick_init() hvsa megtrtnt, a kirst alvs eltt be kell
+ *    fejezni (sw_uart_flush)
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef ADAPT_H
+#define ADAPT_H
+
+#include "stdint.h"
+
+#define ADAPT_SPAN_MAX  (1UL << 22)    //A kitlts szmllinak felezsi hatra (ms)
+
+typedef struct {
+  uint16_t t_min, t_max;               //A mrsi idkz hatrai (ms)
+  uint16_t slope;                      //Ugrs kszb: |x - elz x|
+  uint16_t spread;                     //A blokk terjedelmnek kszbe
+  uint8_t  hold;                       //Ennyi nyugodt mrs utn lasst
+  uint8_t  t_busy;                     //Egy mrs (blokk) ideje (ms)
+} adapt_cfg_t;
+
+typedef struct {
+  const adapt_cfg_t *p_cfg;
+  uint16_t period;                     //A mostani idkz (ms)
+  uint16_t next;                       //A kvetkez mrs ideje (tick_ms)
+  uint16_t last;                       //Az elz mrt rtk
+  uint8_t  calm;                       //Egyms utni nyugodt mrsek
+  uint8_t  primed;                     //Van mr elz rtk
+  uint32_t busy, span;                 //Mrsi s eltelt id (ms)
+} adapt_t;
+
+void adapt_init(adapt_t *p_a, const adapt_cfg_t *p_cfg);
+uint8_t adapt_wait(adapt_t *p_tab, uint8_t n);
+uint16_t adapt_put(adapt_t *p_a, uint16_t x, uint16_t spread);
+uint16_t adapt_duty(const adapt_t *p_a);
+
+#endif
@@ -0,0 +1,128 @@
+/**********************************************************************
+ *  adc10.c
+ *
+ * ADC10 mreljrsok. Minden eljrs kln fggvny, gy a
+ * szerkeszt csak a tnylegesen meghvottakat teszi a programba.
+ * A bels referencit az adc10_ref.c kezeli (bellsi id, zemmd).
+ * A belltsok fordtsi idben sszelltott regiszterkpek
+ * (adc10_cfg.h), futs kzben csak a csatorna s a DTC mret vltozik.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "adc10.h"
+#include "adc10_ref.h"
+#include "adc10_cfg.h"
+
+//--- Regiszterkpek (a csatornt s a DTC mretet a hv adja) -------
+static const adc_cfg_t cfg_single_vcc =
+  ADC_CFG(INCH_0, ADC_VR_VCC, ADC10_SHT, ADC_TRIG_SC, CONSEQ_0, 0, 0);
+static const adc_cfg_t cfg_single_1v5 =
+  ADC_CFG(INCH_0, ADC_VR_1V5, ADC10_SHT, ADC_TRIG_SC, CONSEQ_0, 0, 0);
+static const adc_cfg_t cfg_single_2v5 =
+  ADC_CFG(INCH_0, ADC_VR_2V5, ADC10_SHT, ADC_TRIG_SC, CONSEQ_0, 0, 0);
+static const adc_cfg_t cfg_multi_1v5 =  //Ismtelt mrs, az MSC indtja
+  ADC_CFG(INCH_0, ADC_VR_1V5, ADC10_SHT, ADC_TRIG_SC, CONSEQ_2, MSC, 0);
+static const adc_cfg_t cfg_multi_1v5_ta = //Ismtelt mrs, TA0.0 indtja
+  ADC_CFG(INCH_0, ADC_VR_1V5, ADC10_SHT, ADC_TRIG_TA0, CONSEQ_2, ADC10IE, 0);
+static const adc_cfg_t cfg_scan_2v5 =   //Egyszeri psztzs
+  ADC_CFG(INCH_0, ADC_VR_2V5, ADC10_SHT, ADC_TRIG_SC, CONSEQ_1, MSC, 0);
+
+/*-------------------------------------------------------------
+ * Egyszeri mrs egy ADC csatornban, VCC a referencia
+ *-------------------------------------------------------------
+ * chan - csatornavlaszt bitek (a csatorna sorszma << 12)
+ */
+uint16_t ADC_single_meas(uint16_t chan) {
+  ADC_cfg_load(&cfg_single_vcc, chan); //(a referencia llapota nem vltozik)
+  ADC10CTL0 |= ENC + ADC10SC;          //Konverzi engedlyezse s indtsa
+  while (ADC10CTL1 & BUSY);            //Vrakozs a konverzi vgre
+  return ADC10MEM;                     //Visszatrsi rtk a konverzi eredmnye
+}
+
+/*-------------------------------------------------------------
+ * Egyszeri mrs egy ADC csatornban, 1,5 V a bels referencia
+ *-------------------------------------------------------------
+ * chan - csatornavlaszt bitek (a csatorna sorszma << 12)
+ */
+uint16_t ADC_single_meas_REF1_5V(uint16_t chan) {
+  ADC_cfg_load(&cfg_single_1v5, chan); //1,5 V-os referencia, bellssal
+  ADC10CTL0 |= ENC + ADC10SC;          //Konverzi engedlyezse s indtsa
+  while (ADC10CTL1 & BUSY);            //Vrakozs a konverzi vgre
+  ADC10CTL0 &= ~ENC;
+  ADC_ref_release();                   //Igny szerinti mdban kikapcsol
+  return ADC10MEM;                     //Visszatrs a konverzi eredmnyvel
+}
+
+/*-------------------------------------------------------------
+ * Egyszeri mrs egy ADC csatornban, 2,5 V a bels referencia
+ *-------------------------------------------------------------
+ * chan - csatornavlaszt bitek (a csatorna sorszma << 12)
+ */
+uint16_t ADC_single_meas_REF2_5V(uint16_t chan) {
+  ADC_cfg_load(&cfg_single_2v5, chan); //2,5 V-os referencia, bellssal
+  ADC10CTL0 |= ENC + ADC10SC;          //Konverzi engedlyezse s indtsa
+  while (ADC10CTL1 & BUSY);            //Vrakozs a konverzi vgre
+  ADC10CTL0 &= ~ENC;
+  ADC_ref_release();                   //Igny szerinti mdban kikapcsol
+  return ADC10MEM;                     //Visszatrsi rtk a konverzi eredmnye
+}
+
+/*-------------------------------------------------------------
+ * Sorozat mrs egy ADC csatornban, 1,5 V a bels referencia
+ * Egyetlen (szoftveres) indts, a tovbbi konverzikat az
+ * MSC bit indtja. Az adatokat a DTC menti el.
+ *-------------------------------------------------------------
+ * chan - csatornavlaszt bitek (a csatorna sorszma << 12)
+ * pbuf - a mrsi adatok trhelynek cme
+ * ndat - az egy sorozatban elvgzend mrsek szma
+ */
+void ADC_multi_meas_REF1_5V(uint16_t chan, uint16_t *pbuf, uint8_t ndat) {
+  ADC_cfg_load(&cfg_multi_1v5, chan);  //1,5 V-os referencia, bellssal
+  ADC10DTC1 = ndat;                    //ndat mrst vgznk
+  ADC10SA = (unsigned short)pbuf;      //adatok mentse a mutatval jelzett helyre
+  ADC10CTL0 |= ENC + ADC10SC;          //Konverzi engedlyezse s indtsa
+  while (!(ADC10CTL0 & ADC10IFG));     //Vrakozs a konverzi vgre
+  ADC10CTL0 &= ~ENC;                   //Az ismtelt konverzik lelltsa
+  while (ADC10CTL1 & BUSY);            //Vrakozs a foglaltsg vgre
+  ADC_ref_release();                   //Igny szerinti mdban kikapcsol
+}
+
+/*-------------------------------------------------------------
+ * Sorozat mrs egy ADC csatornban, 1,5 V a bels referencia
+ * A konverzikat Timer_A OUT0 kimenjele indtja (SHS_2), a CPU
+ * a sorozat vgig LPM0 mdban alszik.
+ *-------------------------------------------------------------
+ * chan - csatornavlaszt bitek (a csatorna sorszma << 12)
+ * pbuf - a mrsi adatok trhelynek cme
+ * ndat - az egy sorozatban elvgzend mrsek szma
+ */
+void ADC_multi_meas_REF1_5V_TA(uint16_t chan, uint16_t *pbuf, uint8_t ndat) {
+  ADC_cfg_load(&cfg_multi_1v5_ta, chan); //1,5 V-os referencia, bellssal
+  ADC10DTC1 = ndat;                    //ndat mrst vgznk
+  ADC10SA = (unsigned short)pbuf;      //adatok mentse a mutatval jelzett helyre
+  ADC10CTL0 |= ENC;                    //Konverzi engedlyezse
+  __low_power_mode_0();                //CPU altats a mrssorozat vgig
+  ADC10CTL0 &= ~ENC;                   //Az ADC letiltsa jrakonfigurlshoz
+  while (ADC10CTL1 & BUSY);            //Vrakozs a foglaltsg vgre
+  ADC_ref_release();                   //Igny szerinti mdban kikapcsol
+}
+
+/*-------------------------------------------------------------
+ * Egyszeri csatornapsztzs, ADC a 2.5V-os bels referencival
+ *-------------------------------------------------------------
+ * chan - a kezd csatorna sorszma << 12
+ * pbuf - a kimeneti adatbuffer kezdcme
+ * ndat - a psztzand csatornk szma
+ */
+void ADC_scan_meas_REF2_5V(uint16_t chan, uint16_t *pbuf, uint8_t ndat) {
+  ADC_cfg_load(&cfg_scan_2v5, chan);   //2,5 V-os referencia, bellssal
+  ADC10DTC1 = ndat;                    //ndat konverzit vgznk
+  ADC10SA = (unsigned short)pbuf;      //adatok mentse a mutatval jelzett helyre
+  ADC10CTL0 |= ENC + ADC10SC;          //Konverzi engedlyezse s indtsa
+  while (!(ADC10CTL0 & ADC10IFG));     //Vrakozs a konverzi vgre
+  ADC10CTL0 &= ~ENC;
+  while (ADC10CTL1 & BUSY);            //Vrakozs a psztzs vgre
+  ADC_ref_release();                   //Igny szerinti mdban kikapcsol
+}
@@ -0,0 +1,34 @@
+/**********************************************************************
+ *  adc10.h
+ *
+ * ADC10 mreljrsok (egyszeri mrs, sorozatmrs DTC-vel,
+ * csatornapsztzs). Kls jel mrse esetn az analg funkcit
+ * a hvnak kell engedlyeznie az ADC10AE0 regiszterben.
+ *
+ * Bellthat makr:
+ *  ADC10_SHT  - mintavteli id (alaprtelmezs: ADC10SHT_3, 64 rats)
+ *
+ * Az ADC_multi_meas_REF1_5V_TA() eljrs LPM0-ban vr a sorozat vgig,
+ * ezrt a programnak kell gondoskodnia az ADC10 megszakts
+ * kiszolglsrl (__low_power_mode_off_on_exit()).
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef ADC10_H
+#define ADC10_H
+
+#include "stdint.h"
+
+#ifndef ADC10_SHT
+#define ADC10_SHT   ADC10SHT_3         //mintavtel: 64 rats
+#endif
+
+uint16_t ADC_single_meas(uint16_t chan);
+uint16_t ADC_single_meas_REF1_5V(uint16_t chan);
+uint16_t ADC_single_meas_REF2_5V(uint16_t chan);
+void ADC_multi_meas_REF1_5V(uint16_t chan, uint16_t *pbuf, uint8_t ndat);
+void ADC_multi_meas_REF1_5V_TA(uint16_t chan, uint16_t *pbuf, uint8_t ndat);
+void ADC_scan_meas_REF2_5V(uint16_t chan, uint16_t *pbuf, uint8_t ndat);
+
+#endif
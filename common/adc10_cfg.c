@@ -0,0 +1,29 @@
+/**********************************************************************
+ *  adc10_cfg.c
+ *
+ * Fordtsi idben sszelltott ADC10 belltsok betltse.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "adc10_cfg.h"
+#include "adc10_ref.h"
+
+/**------------------------------------------------------------
+ *  Egy ADC_CFG() regiszterkp betltse (ENC = 0 marad)
+ *-------------------------------------------------------------
+ * p_cfg - a konstans regiszterkp
+ * chan - a lershoz hozzadott csatornavlaszt bitek (a csatorna
+ *        sorszma << 12), ha a lersban INCH_0 szerepel
+ * A referencia bellst az ADC_ref_use() kezeli. Futs kzben
+ * vltoz DTC mret esetn a hv ezutn rja az ADC10DTC1-et.
+ */
+void ADC_cfg_load(const adc_cfg_t *p_cfg, uint16_t chan) {
+  ADC10CTL0 &= ~ENC;                   //Az ADC letiltsa jrakonfigurlshoz
+  while (ADC10CTL1 & BUSY);            //Vrakozs a foglaltsg vgre
+  ADC10CTL0 = p_cfg->ctl0 | ADC_ref_use(p_cfg->ref);
+  ADC10CTL1 = p_cfg->ctl1 | chan;
+  ADC10DTC0 = p_cfg->dtc0;
+  ADC10DTC1 = p_cfg->dtc1;
+}
@@ -0,0 +1,96 @@
+/**********************************************************************
+ *  adc10_cfg.h
+ *
+ * ADC10 belltsok fordtsi idben sszelltott regiszterkpekkel.
+ * Egy belltst egy ADC_CFG() lers ad meg (csatorna, referencia,
+ * mintavteli id, indtjel, zemmd, DTC), ebbl a fordt egy
+ * flash-ben trolt konstans kpet kszt, gy futs kzben nincs
+ * bitenknti sszeraks: az ADC_cfg_load() nhny szrssal tlti be.
+ * Pl. A5, 1,5 V-os referencia, 64 rats mintavtel, TA0.0 indts,
+ * ismtelt mrs, 32 mrs DTC-vel:
+ *   static const adc_cfg_t cfg = ADC_CFG(INCH_5, ADC_VR_1V5, ADC10SHT_3,
+ *                                        ADC_TRIG_TA0, CONSEQ_2, ADC10IE, 32);
+ *
+ * Az rtelmetlen kombincik fordtsi hibt adnak (negatv mret
+ * tmb az ADC_CFG_CHECK() makrban), pl.
+ *  - MSC egyszeri mrs (CONSEQ_0) mellett
+ *  - bels referencia (SREF_1, SREF_5) vagy REF2_5V REFON nlkl
+ *  - felcserlt paramterek (idegen bitek egy mezben), ndat > 255
+ *
+ * A referencia bitjeit (REFON, REF2_5V) a kp kln trolja, ezeket az
+ * ADC_ref_use() kapja meg, hogy a bellsi id kezelse (adc10_ref.c)
+ * rvnyben maradjon. A futs kzben vltoz csatornt (INCH_0 a
+ * lersban) s a DTC mrett (ndat = 0) a hv adja meg.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef ADC10_CFG_H
+#define ADC10_CFG_H
+
+#include "stdint.h"
+
+typedef struct {
+  uint16_t ctl0;                       //ADC10CTL0 (referencia bitek nlkl)
+  uint16_t ctl1;                       //ADC10CTL1
+  uint16_t ref;                        //0, REFON vagy REFON + REF2_5V
+  uint8_t  dtc0;                       //ADC10DTC0: ADC10TB, ADC10CT
+  uint8_t  dtc1;                       //ADC10DTC1: mrsek szma (0: nincs DTC)
+} adc_cfg_t;
+
+//--- Referencia (SREF_x s a bels referencia bitjei) -----------------
+#define ADC_VR_VCC    (SREF_0)                   //VR+ = AVCC
+#define ADC_VR_1V5    (SREF_1 | REFON)           //VR+ = VREF+ = 1,5 V
+#define ADC_VR_2V5    (SREF_1 | REFON | REF2_5V) //VR+ = VREF+ = 2,5 V
+#define ADC_VR_EXT    (SREF_2)                   //VR+ = VeREF+ (P1.4)
+
+//--- A mintavtel indtjele -----------------------------------------
+#define ADC_TRIG_SC   (SHS_0)          //ADC10SC bit (szoftver, MSC)
+#define ADC_TRIG_TA0  (SHS_2)          //Timer_A OUT0
+#define ADC_TRIG_TA1  (SHS_1)          //Timer_A OUT1
+#define ADC_TRIG_TA2  (SHS_3)          //Timer_A OUT2
+
+//--- Az opt paramterben megengedett ADC10CTL0 bitek ------------------
+#define ADC_CFG_OPTS  (MSC | ADC10IE | REFOUT | REFBURST | ADC10SR)
+
+//--- Fordtsi idej ellenrzs: hamis felttelnl negatv tmbmret --
+#define ADC_CFG_CHECK(ok)  (0 * sizeof(char[(ok) ? 1 : -1]))
+
+#define ADC_CFG_VALID(chan,vr,sht,trig,seq,opt,ndat,dtc0)            \
+  (   ((chan) & ~INCH_15) == 0                                        \
+   && ((vr) & ~(SREF_7 | REFON | REF2_5V)) == 0                       \
+   && ((sht) & ~ADC10SHT_3) == 0                                      \
+   && ((trig) & ~SHS_3) == 0                                          \
+   && ((seq) & ~CONSEQ_3) == 0                                        \
+   && ((opt) & ~ADC_CFG_OPTS) == 0                                    \
+   && ((dtc0) & ~(ADC10TB | ADC10CT)) == 0                            \
+   && (ndat) <= 255                                                   \
+   && !(((opt) & MSC) && (seq) == CONSEQ_0)                           \
+   && !(((vr) & (SREF_1 | SREF_2)) == SREF_1 && !((vr) & REFON))      \
+   && !(((vr) & REF2_5V) && !((vr) & REFON))                          \
+   && !(((opt) & REFOUT) && !((vr) & REFON)))
+
+/**------------------------------------------------------------
+ *  Konstans regiszterkp egy lersbl (inicializl)
+ *-------------------------------------------------------------
+ * chan - INCH_x (INCH_0, ha a hv adja meg)
+ * vr   - ADC_VR_VCC, ADC_VR_1V5, ADC_VR_2V5, ADC_VR_EXT (vagy SREF_x)
+ * sht  - ADC10SHT_x, trig - ADC_TRIG_x, seq - CONSEQ_x
+ * opt  - MSC, ADC10IE, REFOUT, REFBURST, ADC10SR kombincija (vagy 0)
+ * ndat - a DTC mrseinek szma (0: nincs DTC, vagy a hv adja meg)
+ * dtc0 - ADC10TB, ADC10CT (csak ADC_CFG_DTC() esetn)
+ * Az rajel mindig ADC10OSC (ADC10SSEL_0, ADC10DIV_0).
+ */
+#define ADC_CFG_DTC(chan,vr,sht,trig,seq,opt,ndat,dtc0)              \
+  { (uint16_t)(((vr) & ~(REFON | REF2_5V)) | (sht) | (opt) | ADC10ON  \
+     | ADC_CFG_CHECK(ADC_CFG_VALID(chan,vr,sht,trig,seq,opt,ndat,dtc0))), \
+    (uint16_t)(ADC10SSEL_0 | (chan) | (trig) | (seq)),                \
+    (uint16_t)((vr) & (REFON | REF2_5V)),                             \
+    (uint8_t)(dtc0), (uint8_t)(ndat) }
+
+#define ADC_CFG(chan,vr,sht,trig,seq,opt,ndat)                       \
+  ADC_CFG_DTC(chan,vr,sht,trig,seq,opt,ndat,0)
+
+void ADC_cfg_load(const adc_cfg_t *p_cfg, uint16_t chan);
+
+#endif
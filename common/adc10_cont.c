@@ -0,0 +1,138 @@
+/**********************************************************************
+ *  adc10_cont.c
+ *
+ * Folyamatos mrs a DTC ktblokkos zemmdjval (ping-pong buffer).
+ * A megszakts csak feljegyzi a megtelt blokk cmt (vagy csatolt
+ * sor esetn a sorba teszi a sorszmt) s felbreszti a CPU-t, az
+ * adatokat nem msolja.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "adc10_cont.h"
+#include "adc10_ref.h"
+#include "adc10_cfg.h"
+#include "isr.h"
+
+volatile uint16_t ADC_cont_overruns;   //Fel nem dolgozott blokkok szma
+volatile uint16_t ADC_cont_blocks;     //A megtelt blokkok szma (idblyeg)
+static uint16_t *cont_buf;             //A ktblokkos buffer kezdcme
+static uint8_t cont_ndat;              //Egy blokk mrete (sz)
+static const uint16_t * volatile cont_ready; //Ksz blokk cme (0: nincs)
+static queue_t *cont_queue;            //Csatolt sor (0: nincs)
+
+//--- Kt blokk, folyamatos tvitel; a blokkmretet a hv adja --------
+static const adc_cfg_t cfg_cont = ADC_CFG_DTC(INCH_0, ADC_VR_1V5, ADC10_SHT,
+    ADC_TRIG_TA0, CONSEQ_2, ADC10IE, 0, ADC10TB | ADC10CT);
+
+/**------------------------------------------------------------
+ * Folyamatos mrs indtsa egy csatornban, 1,5 V a bels
+ * referencia, a konverzikat Timer_A OUT0 indtja (SHS_2)
+ *-------------------------------------------------------------
+ * chan - csatornavlaszt bitek (a csatorna sorszma << 12)
+ * pbuf - a 2*ndat szavas buffer cme
+ * ndat - egy blokk (flbuffer) mrete
+ */
+void ADC_cont_start_REF1_5V_TA(uint16_t chan, uint16_t *pbuf, uint8_t ndat) {
+  ADC10CTL0 &= ~ENC;                   //Az ADC letiltsa jrakonfigurlshoz
+  while (ADC10CTL1 & BUSY);            //Vrakozs a foglaltsg vgre
+  cont_buf = pbuf;
+  cont_ndat = ndat;
+  cont_ready = 0;
+  ADC_cont_overruns = 0;
+  ADC_cont_blocks = 0;
+  ADC_cfg_load(&cfg_cont, chan);       //1,5 V-os referencia, bellssal
+  ADC10DTC1 = ndat;                    //Blokkonknt ndat mrs
+  ADC10SA = (unsigned short)pbuf;      //Az els blokk kezdcme
+  ADC10CTL0 |= ENC;                    //Konverzi engedlyezse
+  __enable_interrupt();
+}
+
+/**------------------------------------------------------------
+ * A kvetkez ksz blokk megvrsa (LPM0 mdban)
+ *-------------------------------------------------------------
+ * Visszatrsi rtk: a megtelt blokk cme. A blokk a kvetkez
+ * ADC_cont_get() hvsig olvashat, ha a feldolgozs elg gyors.
+ */
+const uint16_t *ADC_cont_get(void) {
+  const uint16_t *p;
+  __disable_interrupt();
+  while (!cont_ready) {
+    __low_power_mode_0();              //Alvs a kvetkez blokk vgig
+    __disable_interrupt();
+  }
+  p = cont_ready;
+  cont_ready = 0;
+  __enable_interrupt();
+  return p;
+}
+
+/**------------------------------------------------------------
+ * A ksz blokk lekrdezse vrakozs nlkl
+ *-------------------------------------------------------------
+ * Visszatrsi rtk: a megtelt blokk cme, vagy 0, ha nincs j blokk.
+ * A blokk sorszma a hvs pillanatban ADC_cont_blocks - 1.
+ */
+const uint16_t *ADC_cont_poll(void) {
+  const uint16_t *p;
+  __disable_interrupt();
+  p = cont_ready;
+  cont_ready = 0;
+  __enable_interrupt();
+  return p;
+}
+
+/**------------------------------------------------------------
+ * Sor csatolsa: a megszakts a ksz blokkokat ebbe teszi
+ *-------------------------------------------------------------
+ * p_q - a sor (0: nincs sor, ADC_cont_get/ADC_cont_poll)
+ * ll mrs mellett hvand. Az elem adata a flbuffer sorszma,
+ * idblyege az ADC_cont_blocks rtke a blokk megtelsekor.
+ */
+void ADC_cont_attach(queue_t *p_q) {
+  cont_queue = p_q;
+}
+
+/**------------------------------------------------------------
+ * A sorbl kivett blokk cme
+ *-------------------------------------------------------------
+ * p_item - a queue_get() ltal kivett elem
+ * Visszatrsi rtk: a blokk cme, vagy 0, ha azta jabb blokk is
+ * megtelt, s a DTC mr fellrja (ekkor ADC_cont_overruns n).
+ * A blokk a kvetkez blokk megtelsig olvashat.
+ */
+const uint16_t *ADC_cont_block(const queue_item_t *p_item) {
+  if (p_item->stamp != ADC_cont_blocks) {
+    ADC_cont_overruns++;               //Ksve vettk ki: elveszett
+    return 0;
+  }
+  return p_item->data ? cont_buf + cont_ndat : cont_buf;
+}
+
+/**------------------------------------------------------------
+ * A folyamatos mrs lelltsa
+ *-------------------------------------------------------------*/
+void ADC_cont_stop(void) {
+  ADC10CTL0 &= ~(ENC + ADC10IE);       //Az ADC s a megszakts letiltsa
+  while (ADC10CTL1 & BUSY);            //Vrakozs a foglaltsg vgre
+  ADC10DTC0 = 0;                       //Egy blokk md, DTC lell
+  ADC10CTL0 &= ~ADC10ON;               //Az ADC kikapcsolsa
+  ADC_ref_release();                   //Igny szerinti mdban a referencia is
+}
+
+//----------------------------------------------------------------------
+// ADC10 megszakts: egy blokk megtelt (ADC10B1 = 1: az els blokk)
+//----------------------------------------------------------------------
+ISR(ADC10_VECTOR, ADC10_ISR)           //A jelzbit automatikusan trldik
+{
+  uint8_t half = (ADC10DTC0 & ADC10B1) ? 0 : 1; //A megtelt flbuffer
+  ADC_cont_blocks++;
+  if (cont_queue) {                    //Tele sor: cont_queue->overruns n
+    queue_put(cont_queue,half,ADC_cont_blocks);
+  } else {
+    if (cont_ready) ADC_cont_overruns++; //Az elz blokkot nem dolgoztk fel
+    cont_ready = cont_buf + half * cont_ndat;
+  }
+  __low_power_mode_off_on_exit();      //Felbresztjk az alv CPU-t
+}
@@ -0,0 +1,48 @@
+/**********************************************************************
+ *  adc10_cont.h
+ *
+ * Folyamatos, hzagmentes mrs egy ADC csatornban, a DTC ktblokkos
+ * (ADC10TB + ADC10CT) zemmdjval. A DTC felvltva tlti a buffer
+ * kt felt, minden flbuffer megtelsekor megszakts keletkezik.
+ * A fprogram ADC_cont_get() hvssal (LPM0-ban alva) megvrja a
+ * kvetkez ksz blokkot, s azt dolgozza fel, amg a DTC a msik
+ * blokkot tlti. Ha a fprogram kzben mst is csinl (feldolgozsi
+ * lnc), az ADC_cont_poll() vrakozs nlkl krdezi le a ksz blokkot.
+ * Feldolgozsi lncban a megszakts a ksz blokkot egy sorba is
+ * teheti (ADC_cont_attach): az elem adata a flbuffer sorszma (0, 1),
+ * idblyege a blokkszmll; a fogyaszt queue_get() utn az
+ * ADC_cont_block() hvssal kapja meg a blokk cmt.
+ * A konverzikat Timer_A OUT0 kimenjele indtja (SHS_2),
+ * a Timer_A belltsa a hv feladata.
+ *
+ * Felttelek:
+ *  - a buffer mrete 2*ndat sz
+ *  - egy blokk feldolgozsa rvidebb, mint ndat mintavteli peridus,
+ *    klnben a DTC fellrja (a tlcsordulsokat ADC_cont_overruns szmolja)
+ *  - az ADC10 megszaktsi vektor ez a modul
+ *  - csatolt sor esetn az ADC_cont_get() s az ADC_cont_poll() nem
+ *    hasznlhat; a tele sor miatt eldobott blokkokat a sor overruns
+ *    szmllja, a ksve kivett (mr fellrt) blokkokat az
+ *    ADC_cont_overruns szmolja
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef ADC10_CONT_H
+#define ADC10_CONT_H
+
+#include "stdint.h"
+#include "adc10.h"                     //ADC10_SHT
+#include "queue.h"
+
+extern volatile uint16_t ADC_cont_overruns; //Fel nem dolgozott blokkok szma
+extern volatile uint16_t ADC_cont_blocks; //A megtelt blokkok szma (idblyeg)
+
+void ADC_cont_start_REF1_5V_TA(uint16_t chan, uint16_t *pbuf, uint8_t ndat);
+const uint16_t *ADC_cont_get(void);
+const uint16_t *ADC_cont_poll(void);
+void ADC_cont_stop(void);
+void ADC_cont_attach(queue_t *p_q);
+const uint16_t *ADC_cont_block(const queue_item_t *p_item);
+
+#endif
@@ -0,0 +1,55 @@
+/**********************************************************************
+ *  adc10_ref.c
+ *
+ * A bels referencia kezelse: bellsi id csak szksg esetn,
+ * "mindig bekapcsolva" vagy "igny szerint" zemmdban.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "adc10_ref.h"
+
+static uint16_t ref_state;             //REFON | REF2_5V, 0: kikapcsolva
+static uint8_t ref_policy;             //ADC_REF_ON_DEMAND vagy ADC_REF_ALWAYS_ON
+
+/**------------------------------------------------------------
+ * zemmd vlaszts
+ *-------------------------------------------------------------
+ * policy - ADC_REF_ON_DEMAND vagy ADC_REF_ALWAYS_ON
+ */
+void ADC_ref_policy(uint8_t policy) {
+  ref_policy = policy;
+  if (policy == ADC_REF_ON_DEMAND) ADC_ref_release();
+}
+
+/**------------------------------------------------------------
+ * A referencia bekapcsolsa a mrshez (ENC = 0 mellett hvand)
+ *-------------------------------------------------------------
+ * ref - 0 (nincs szksg bels referencira), REFON (1,5 V)
+ *       vagy REFON + REF2_5V (2,5 V)
+ * Visszatrsi rtk: az ADC10CTL0-ba rand referencia bitek.
+ * Csak akkor vr, ha a referencia most kapcsolt be vagy tllt.
+ */
+uint16_t ADC_ref_use(uint16_t ref) {
+  if (!ref) {                          //VCC referencij mrs
+    if (ref_policy == ADC_REF_ALWAYS_ON) return ref_state;
+    ADC_ref_release();
+    return 0;
+  }
+  if (ref != ref_state) {
+    ADC10CTL0 = (ADC10CTL0 & ~(REFON + REF2_5V)) | ref;
+    __delay_cycles(ADC10_REF_SETTLE);  //Vrakozs a referencia bellsra
+    ref_state = ref;
+  }
+  return ref;
+}
+
+/**------------------------------------------------------------
+ * Mrs vge: igny szerinti mdban a referencia kikapcsol
+ *-------------------------------------------------------------*/
+void ADC_ref_release(void) {
+  if (ref_policy == ADC_REF_ALWAYS_ON) return;
+  ADC10CTL0 &= ~(REFON + REF2_5V);     //Referencia kikapcsolsa
+  ref_state = 0;
+}
@@ -0,0 +1,41 @@
+/**********************************************************************
+ *  adc10_ref.h
+ *
+ * A bels referencia (REFON, REF2_5V) kezelse. A referencia
+ * bekapcsols utn kb. 30 us alatt ll be, ez alatt a mrs pontatlan.
+ * A kezel nyilvntartja a referencia llapott, s csak akkor
+ * vrakozik (ADC10_REF_SETTLE), ha a referencia most kapcsolt be,
+ * vagy a feszltsge (1,5/2,5 V) megvltozott. A vrakozs ciklusszma
+ * az rajelbl (CLOCK_MHZ, clock.h) addik, gy minden frekvencin 30 us.
+ *
+ * Kt zemmd kzl vlaszthatunk (ADC_ref_policy()):
+ *  - ADC_REF_ON_DEMAND: mrs utn a referencia kikapcsol, ritka
+ *    (pl. msodpercenknti) mrseknl ez takarkos
+ *  - ADC_REF_ALWAYS_ON: a referencia bekapcsolva marad, nincs
+ *    bellsi id, de folyamatosan fogyaszt (kb. 250 uA)
+ * A kt md energia- s idignyt a bench/ref_model.py becsli.
+ *
+ * Az ADC10CTL0 regisztert r eljrsok a referencia bitjeit
+ * az ADC_ref_use() visszatrsi rtkbl vegyk!
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef ADC10_REF_H
+#define ADC10_REF_H
+
+#include "stdint.h"
+#include "clock.h"                     //CLOCK_MHZ
+
+#ifndef ADC10_REF_SETTLE
+#define ADC10_REF_SETTLE  (30 * CLOCK_MHZ) //Referencia bells: 30 us (ciklus)
+#endif
+
+#define ADC_REF_ON_DEMAND 0            //Mrs utn kikapcsol (alaprtelmezs)
+#define ADC_REF_ALWAYS_ON 1            //Folyamatosan bekapcsolva
+
+void ADC_ref_policy(uint8_t policy);
+uint16_t ADC_ref_use(uint16_t ref);
+void ADC_ref_release(void);
+
+#endif
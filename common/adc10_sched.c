@@ -0,0 +1,117 @@
+/**********************************************************************
+ *  adc10_sched.c
+ *
+ * Tbbcsatorns mrstemez: azonos profil csatornk
+ * csoportostsa hardveres psztzsokba (CONSEQ_1 + DTC).
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "adc10_sched.h"
+#include "adc10_ref.h"
+
+//--- Bels referencit hasznl-e a profil (SREF_1 vagy SREF_5)? ------
+#define USES_REF(p)   (((p) & (SREF_1|SREF_2)) == SREF_1)
+
+uint8_t ADC_sched_nseq;                //Psztzsok szma az utols keretben
+static uint16_t sched_buf[12];         //Egy psztzs eredmnyei (A11 - A0)
+
+/*-------------------------------------------------------------
+ * A profil sszehasonlthat alakja: bels referencia nlkl
+ * a REF2_5V bitnek nincs jelentsge
+ *-------------------------------------------------------------*/
+static uint16_t prof_norm(uint16_t prof) {
+  return USES_REF(prof) ? prof : (prof & ~REF2_5V);
+}
+
+/*-------------------------------------------------------------
+ * A profilhoz szksges referencia bellts (0: nincs)
+ *-------------------------------------------------------------*/
+static uint16_t ref_need(uint16_t prof) {
+  return USES_REF(prof) ? (REFON | (prof & REF2_5V)) : 0;
+}
+
+/**------------------------------------------------------------
+ * Egy mrsi keret: a tblzat minden bejegyzsnek mrse
+ *-------------------------------------------------------------
+ * p_tab - a csatornk tblzata (ADC_SCHED() bejegyzsek)
+ * n - a bejegyzsek szma (1 - ADC_SCHED_MAXN)
+ * p_out - n elem tmb, p_out[i] a p_tab[i] bejegyzs eredmnye
+ */
+void ADC_sched_run(const adc_sched_t *p_tab, uint8_t n, uint16_t *p_out) {
+  uint16_t todo, members, chmask, prof, ref_now, reps;
+  uint8_t i, lead, hi, lo, ch, os;
+  ADC10CTL0 &= ~ENC;                   //Az ADC letiltsa jrakonfigurlshoz
+  while (ADC10CTL1 & BUSY);            //Vrakozs a foglaltsg vgre
+  ADC10DTC0 = 0;                       //Egy blokk md
+  for(i=0; i<n; i++) p_out[i] = 0;
+  todo = (n >= 16) ? 0xFFFF : (1U << n) - 1;
+  ref_now = 0;                         //Elszr a referencia nlkli csoportok
+  ADC_sched_nseq = 0;
+  while (todo) {
+//--- Csoportvezet: lehetleg a mostani referencival mrhet ---------
+    lead = 0xFF;
+    for(i=0; i<n; i++) {
+      if (!(todo & (1U << i))) continue;
+      if (lead == 0xFF) lead = i;
+      if (ref_need(p_tab[i].prof) == ref_now) { lead = i; break; }
+    }
+    prof = prof_norm(p_tab[lead].prof);
+//--- A csoport csatorni, a psztzs fels s als hatra -----------
+    chmask = 0;
+    for(i=0; i<n; i++) {
+      if ((todo & (1U << i)) && prof_norm(p_tab[i].prof) == prof)
+        chmask |= 1U << p_tab[i].chan;
+    }
+    hi = 11;
+    while (!(chmask & (1U << hi))) hi--;
+    lo = hi;
+    for(ch=hi; ch-- > 0; ) {
+      if (!(chmask & (1U << ch))) continue;
+      if (lo - ch - 1 > ADC_SCHED_MAXGAP) break;
+      lo = ch;
+    }
+//--- A psztzsba es bejegyzsek, az ismtlsek szma --------------
+    members = 0;
+    reps = 1;
+    for(i=0; i<n; i++) {
+      ch = p_tab[i].chan;
+      if ((todo & (1U << i)) && prof_norm(p_tab[i].prof) == prof
+          && ch >= lo && ch <= hi) {
+        members |= 1U << i;
+        if ((1U << (2*p_tab[i].os)) > reps) reps = 1U << (2*p_tab[i].os);
+      }
+    }
+//--- Bellts; a referencia csak vltozskor kell, hogy belljon ----
+    ref_now = ref_need(prof);
+    ADC10CTL0 = prof                   //referencia, mintavteli id
+             | ADC_ref_use(ref_now)    //bels referencia (adc10_ref.c)
+             | ADC10ON                 //Az ADC bekapcsolsa
+             | MSC;                    //Tbbszrs konverzi egy triggerjelre
+    ADC10DTC1 = hi - lo + 1;           //A krt csatornk eredmnyei
+    while (reps--) {
+      ADC10CTL1 = ADC10SSEL_0          //ADC10OSC kivlasztsa
+                 | CONSEQ_1            //Egyszeri csatornapsztzs
+                 | ((uint16_t)hi << 12); //kezd csatorna megadsa
+      ADC10SA = (unsigned short)sched_buf; //DTC indtsa
+      ADC10CTL0 |= ENC + ADC10SC;      //Konverzi engedlyezse s indtsa
+      while (!(ADC10CTL0 & ADC10IFG)); //Vrakozs a lo csatornig
+      ADC10CTL1 &= ~CONSEQ_3;          //Azonnali lellts: CONSEQ = 0
+      ADC10CTL0 &= ~(ENC + ADC10IFG);  //s ENC = 0
+      for(i=0; i<n; i++) {             //sszegzs a bejegyzsenknti szmig
+        if ((members & (1U << i)) && reps < (1U << (2*p_tab[i].os)))
+          p_out[i] += sched_buf[hi - p_tab[i].chan];
+      }
+    }
+    todo &= ~members;
+    ADC_sched_nseq++;
+  }
+  ADC10CTL0 &= ~ADC10ON;               //Az ADC kikapcsolsa
+  ADC_ref_release();                   //Igny szerinti mdban a referencia is
+//--- Decimls: (10+os) bites eredmny, kerektssel ------------------
+  for(i=0; i<n; i++) {
+    os = p_tab[i].os;
+    if (os) p_out[i] = (p_out[i] >> os) + ((p_out[i] >> (os-1)) & 1);
+  }
+}
@@ -0,0 +1,51 @@
+/**********************************************************************
+ *  adc10_sched.h
+ *
+ * Tbbcsatorns mrstemez. A mrend csatornkat egy tblzat
+ * rja le, minden bejegyzsnek sajt profilja van (referencia,
+ * 1,5/2,5 V, mintavteli id, tlmintavtelezs). Az ADC_sched_run()
+ * az azonos profil bejegyzseket hardveres csatornapsztzsokba
+ * (CONSEQ_1) csoportostja, gy egy mrsi keretben a referencia
+ * csoportonknt csak egyszer kapcsol be s ll be, a regisztereket
+ * pedig nem kell csatornnknt jrarni.
+ *
+ * Egy psztzs a legnagyobb sorszm csatorntl lefel halad.
+ * A csoporton bell legfeljebb ADC_SCHED_MAXGAP fel nem hasznlt
+ * csatorna fr kt bejegyzs kz, klnben j psztzs indul.
+ * Az utols krt csatorna utn a psztzst azonnal lelltjuk.
+ * A csoportok sorrendje olyan, hogy a referencia a lehet legritkbban
+ * vltson. A referencia bellst s az zemmdot (igny szerint vagy
+ * mindig bekapcsolva) az adc10_ref.c kezeli, a keret vgn az ADC kikapcsol.
+ *
+ * Az eredmny os > 0 esetn 4^os mrs decimlt, (10+os) bites rtke
+ * (mint a stat.h decimate() eljrsnl). Az analg bemenetek
+ * engedlyezse (ADC10AE0) a hv feladata.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef ADC10_SCHED_H
+#define ADC10_SCHED_H
+
+#include "stdint.h"
+
+#ifndef ADC_SCHED_MAXGAP
+#define ADC_SCHED_MAXGAP  2            //Kihagyhat csatornk egy psztzsban
+#endif
+#define ADC_SCHED_OS_MAX  3            //Legfeljebb 64 mrs, 16 bites sszeg
+#define ADC_SCHED_MAXN    16           //A tblzat legfeljebb ennyi elem
+
+typedef struct {
+  uint16_t prof;                       //SREF_x | REF2_5V | ADC10SHT_x
+  uint8_t  chan;                       //Csatorna sorszma (0 - 11)
+  uint8_t  os;                         //Tlmintavtelezs: 4^os mrs (0 - 3)
+} adc_sched_t;
+
+//--- Egy tblzatbejegyzs (ref: 0 vagy REF2_5V) ----------------------
+#define ADC_SCHED(chan,sref,ref,sht,os)  { (sref)|(ref)|(sht), (chan), (os) }
+
+extern uint8_t ADC_sched_nseq;         //Psztzsok szma az utols keretben
+
+void ADC_sched_run(const adc_sched_t *p_tab, uint8_t n, uint16_t *p_out);
+
+#endif
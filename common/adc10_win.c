@@ -0,0 +1,115 @@
+/**********************************************************************
+ *  adc10_win.c
+ *
+ * Ablakkompartor hiszterzissel s pergsmentestssel: a dnts
+ * az ADC10 megszaktsban szletik, a fprogram csak znavltskor bred.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "adc10_win.h"
+#include "adc10_cfg.h"
+#include "adc10_ref.h"
+#include "isr.h"
+
+volatile uint16_t ADC_win_samples;     //A mrsek szma (krbefordul)
+volatile uint16_t ADC_win_changes;     //A znavltsok szma
+static const adc_win_t *win;           //A bellts
+static uint16_t thr_lo[4], thr_hi[4];  //Znnknti hatrok hiszterzissel
+static volatile uint8_t win_zone;      //A megerstett zna
+static volatile uint8_t win_event;     //Vltozs trtnt (ADC_win_wait trli)
+static uint8_t cand, cnt;              //A jellt zna s megerstsei
+
+//--- Ismtelt egycsatorns mrs, VCC referencia, TA0.0 indtja -------
+static const adc_cfg_t cfg_win =
+  ADC_CFG(INCH_0, ADC_VR_VCC, ADC10_SHT, ADC_TRIG_TA0, CONSEQ_2, ADC10IE, 0);
+
+/**------------------------------------------------------------
+ * Az ablakfigyels indtsa
+ *-------------------------------------------------------------
+ * chan - csatornavlaszt bitek (a csatorna sorszma << 12)
+ * p_win - az ablak lersa (a figyels vgig rvnyes marad)
+ * A hatrokat a mostani zntl elfel toljuk el, gy a
+ * megszaktsban znnknt csak kt sszehasonlts kell.
+ */
+void ADC_win_start(uint16_t chan, const adc_win_t *p_win) {
+  uint16_t h = p_win->hyst;
+  ADC10CTL0 &= ~ENC;                   //Az ADC letiltsa jrakonfigurlshoz
+  while (ADC10CTL1 & BUSY);            //Vrakozs a foglaltsg vgre
+  win = p_win;
+  thr_lo[ADC_WIN_BELOW] = p_win->lo + h;  thr_hi[ADC_WIN_BELOW] = p_win->hi + h;
+  thr_lo[ADC_WIN_INSIDE] = p_win->lo - h; thr_hi[ADC_WIN_INSIDE] = p_win->hi + h;
+  thr_lo[ADC_WIN_ABOVE] = p_win->lo - h;  thr_hi[ADC_WIN_ABOVE] = p_win->hi - h;
+  thr_lo[ADC_WIN_UNKNOWN] = p_win->lo;    thr_hi[ADC_WIN_UNKNOWN] = p_win->hi;
+  win_zone = ADC_WIN_UNKNOWN;
+  win_event = 0;
+  cand = ADC_WIN_UNKNOWN;
+  cnt = 0;
+  ADC_win_samples = 0;
+  ADC_win_changes = 0;
+  ADC_cfg_load(&cfg_win, chan);        //VCC referencia, ADC10OSC az rajel
+  ADC10CTL0 |= ENC;                    //Konverzi engedlyezse
+  __enable_interrupt();
+}
+
+/**------------------------------------------------------------
+ * A kvetkez znavlts megvrsa (LPM3 mdban)
+ *-------------------------------------------------------------
+ * Visszatrsi rtk: az j zna (ADC_WIN_BELOW, _INSIDE, _ABOVE)
+ */
+uint8_t ADC_win_wait(void) {
+  uint8_t z;
+  __disable_interrupt();
+  while (!win_event) {
+    __low_power_mode_3();              //Alvs a kvetkez vltozsig
+    __disable_interrupt();
+  }
+  win_event = 0;
+  z = win_zone;
+  __enable_interrupt();
+  return z;
+}
+
+/**------------------------------------------------------------
+ * A megerstett zna lekrdezse vrakozs nlkl
+ *-------------------------------------------------------------*/
+uint8_t ADC_win_zone(void) {
+  return win_zone;
+}
+
+/**------------------------------------------------------------
+ * Az ablakfigyels lelltsa
+ *-------------------------------------------------------------*/
+void ADC_win_stop(void) {
+  ADC10CTL0 &= ~(ENC + ADC10IE);       //Az ADC s a megszakts letiltsa
+  while (ADC10CTL1 & BUSY);            //Vrakozs a foglaltsg vgre
+  ADC10CTL0 &= ~ADC10ON;               //Az ADC kikapcsolsa
+  ADC_ref_release();
+}
+
+//----------------------------------------------------------------------
+// ADC10 megszakts: a mrs znja, megersts, vltozskor breszts
+//----------------------------------------------------------------------
+ISR(ADC10_VECTOR, ADC10_ISR)           //A jelzbit automatikusan trldik
+{
+  uint16_t x = ADC10MEM;
+  uint8_t z, s = win_zone;
+  ADC_win_samples++;
+  z = (x < thr_lo[s]) ? ADC_WIN_BELOW : (x > thr_hi[s]) ? ADC_WIN_ABOVE : ADC_WIN_INSIDE;
+  if (z == s) {                        //Nincs vltozs: a jellt elvsz
+    cnt = 0;
+    return;
+  }
+  if (z != cand) {                     //j jellt
+    cand = z;
+    cnt = 0;
+  }
+  if (++cnt < win->debounce && s != ADC_WIN_UNKNOWN) return;
+  win_zone = z;                        //Megerstett vlts
+  cnt = 0;
+  ADC_win_changes++;
+  win_event = 1;
+  if (win->notify) win->notify(z);
+  __low_power_mode_off_on_exit();      //Felbresztjk az alv CPU-t
+}
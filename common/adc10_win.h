@@ -0,0 +1,55 @@
+/**********************************************************************
+ *  adc10_win.h
+ *
+ * Ablakkompartor: egy csatorna idztett mrse, a fprogram csak
+ * akkor bred, ha a jel tartsan tlpi az ablak valamelyik hatrt.
+ * A konverzikat Timer_A OUT0 kimenjele indtja (SHS_2), a Timer_A
+ * belltsa a hv feladata; ACLK rajellel a CPU LPM3-ban alhat,
+ * mert az ADC10OSC ott is jr. Az ADC10 megszakts mrsenknt
+ * nhny tucat ciklusig fut, a fprogramot nem breszti.
+ *
+ * A jel hrom znba eshet: ADC_WIN_BELOW (lo alatt), ADC_WIN_INSIDE
+ * s ADC_WIN_ABOVE (hi felett). A hiszterzis a hatrokat a mostani
+ * zntl elfel tolja el hyst LSB-vel, az j znt pedig debounce
+ * egyms utni mrsnek kell megerstenie. Az els mrs azonnal
+ * belltja a znt (ez is vltozsnak szmt).
+ *
+ * Vltozskor a notify eljrs (ha nem 0) a megszaktsban fut le,
+ * utna a CPU felbred: az ADC_win_wait() ezt vrja meg LPM3-ban.
+ *
+ * Felttelek:
+ *  - hyst <= lo, hi + hyst <= 1023, lo <= hi, debounce >= 1
+ *  - a referencia VCC, a csatorna analg funkcijt (ADC10AE0)
+ *    a hvnak kell engedlyeznie
+ *  - az ADC10 megszaktsi vektor ez a modul
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef ADC10_WIN_H
+#define ADC10_WIN_H
+
+#include "stdint.h"
+#include "adc10.h"                     //ADC10_SHT
+
+#define ADC_WIN_BELOW    0             //A jel az ablak alatt
+#define ADC_WIN_INSIDE   1             //Az ablakon bell
+#define ADC_WIN_ABOVE    2             //Az ablak felett
+#define ADC_WIN_UNKNOWN  3             //Mg nincs mrs
+
+typedef struct {
+  uint16_t lo, hi;                     //Az ablak hatrai (ADC kd)
+  uint16_t hyst;                       //Hiszterzis (LSB)
+  uint8_t  debounce;                   //Ennyi egyez mrs kell a vltshoz
+  void (*notify)(uint8_t zone);        //Vltozskor, a megszaktsban (vagy 0)
+} adc_win_t;
+
+extern volatile uint16_t ADC_win_samples; //A mrsek szma (krbefordul)
+extern volatile uint16_t ADC_win_changes; //A znavltsok szma
+
+void ADC_win_start(uint16_t chan, const adc_win_t *p_win);
+uint8_t ADC_win_wait(void);
+uint8_t ADC_win_zone(void);
+void ADC_win_stop(void);
+
+#endif
@@ -0,0 +1,129 @@
+/**********************************************************************
+ *  calib.c
+ *
+ * Gyri kalibrcis adatok (TLV) felhasznlsa.
+ *
+ * A korriglt kd (SLAU144, ADC10 kalibrci):
+ *   kd_kal = kd * FREF/2^15 * GAIN/2^15 + OFFSET
+ * ezt a nvleges mV egytthatkba olvasztjuk be:
+ *   mV = (kd * k*FREF*GAIN/2^30 + OFFSET*k + b) >> s
+ * A hmrsklet a kt gyri pontra illesztett egyenes (0,1 C):
+ *   T = (kd - T30) * 550 / (T85 - T30) + 300
+ * Az osztst csak egyszer, a calib_init() vgzi el.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "calib.h"
+
+//--- Az ADC10 kalibrcis blokk szavai (a cmke utni sorrendben) ----
+#define CAL_ADC_GAIN_FACTOR    0
+#define CAL_ADC_OFFSET         1
+#define CAL_ADC_15VREF_FACTOR  2
+#define CAL_ADC_15T30          3
+#define CAL_ADC_15T85          4
+#define CAL_ADC_25VREF_FACTOR  5
+#define CAL_ADC_25T30          6
+#define CAL_ADC_25T85          7
+
+conv_t cal_mv_ref1_5v;
+conv_t cal_mv_ref2_5v;
+conv_t cal_mv_vcc;
+conv_t cal_temp_ref1_5v;
+conv_t cal_temp_ref2_5v;
+
+/*-------------------------------------------------------------
+ * Kis-endin sz olvassa bjtcmrl
+ *-------------------------------------------------------------*/
+static uint16_t tlv_word(const uint8_t *p) {
+  return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+}
+
+/*-------------------------------------------------------------
+ * Szorz normlsa 16 bitre: amg k nem fr el, a lptetst
+ * cskkentjk (b-t is felezve, hogy az arny megmaradjon).
+ *-------------------------------------------------------------*/
+static void conv_set(conv_t *p_conv, uint32_t k, int32_t b, uint8_t s) {
+  while(k > 0xFFFF && s > 0) {
+    k = (k + 1) >> 1;
+    b = b >> 1;
+    s--;
+  }
+  p_conv->k = (uint16_t)k;
+  p_conv->b = b;
+  p_conv->s = s;
+}
+
+/*-------------------------------------------------------------
+ * Nvleges mV egytthatk korrekcija ersts/ofszet/referencia
+ * hibval (fref = 0: nincs referencia korrekci, pl. VCC)
+ *-------------------------------------------------------------*/
+static void cal_mv(conv_t *p_cal, const conv_t *p_nom,
+                   uint16_t gain, int16_t offset, uint16_t fref) {
+  uint32_t k;
+  k = ((uint32_t)p_nom->k * gain + 0x4000) >> 15;
+  if(fref) k = (k * fref + 0x4000) >> 15;
+  conv_set(p_cal, k, p_nom->b + (int32_t)offset * p_nom->k, p_nom->s);
+}
+
+/*-------------------------------------------------------------
+ * Hmr egyenese a 30 C s 85 C gyri pontokbl (0,1 C)
+ *-------------------------------------------------------------*/
+static void cal_temp(conv_t *p_cal, const conv_t *p_nom,
+                     uint16_t t30, uint16_t t85) {
+  uint32_t k;
+  uint16_t d;
+  if(t85 <= t30 || t30 > 1023 || t85 > 1023) {
+    *p_cal = *p_nom;                   //Hasznlhatatlan pontok: nvleges
+    return;
+  }
+  d = t85 - t30;
+  k = ((550UL << 16) + d/2) / d;       //Meredeksg 2^16 egysgben
+  conv_set(p_cal, k, 0, 16);
+  p_cal->b = (300L << p_cal->s) - (int32_t)t30 * p_cal->k
+           + (1L << (p_cal->s - 1));   //Kerekts
+}
+
+/**------------------------------------------------------------
+ * A TLV beolvassa s a kalibrlt egytthatk kiszmtsa
+ *-------------------------------------------------------------
+ * p_tlv - a TLV terlet cme (a chipen: CALIB_TLV_ADDR)
+ * Visszatrsi rtk: CALIB_OK, CALIB_BAD_CHECKSUM vagy CALIB_NO_ADC_TAG
+ */
+uint8_t calib_init(const uint8_t *p_tlv) {
+  const uint8_t *p_adc;
+  uint16_t chk, i, len;                //16 bites: az i+2+len nem fordul krbe
+  cal_mv_ref1_5v = conv_mv_ref1_5v;    //Alaprtelmezs: nvleges rtkek
+  cal_mv_ref2_5v = conv_mv_ref2_5v;
+  cal_mv_vcc = conv_mv_vcc;
+  cal_temp_ref1_5v = conv_temp_ref1_5v;
+  cal_temp_ref2_5v = conv_temp_ref2_5v;
+//--- Ellenrzsszeg: a 0x10C2 - 0x10FF szavak XOR-jnak kettes komplemense
+  chk = 0;
+  for(i=2; i<CALIB_TLV_SIZE; i+=2) chk ^= tlv_word(p_tlv+i);
+  if((uint16_t)(chk + tlv_word(p_tlv)) != 0) return CALIB_BAD_CHECKSUM;
+//--- Az ADC10 kalibrcis blokk megkeresse a cmkk kztt ----------
+  p_adc = 0;
+  for(i=2; i+1<CALIB_TLV_SIZE; i+=2+len) {
+    len = p_tlv[i+1];
+    if(i+2+len > CALIB_TLV_SIZE) break; //A blokk tllgna: hibs hossz
+    if(p_tlv[i]==CALIB_TAG_ADC10_1 && len>=16) {
+      p_adc = p_tlv+i+2;
+      break;
+    }
+  }
+  if(!p_adc) return CALIB_NO_ADC_TAG;
+#define CAL(n) tlv_word(p_adc + 2*(n))
+  cal_mv(&cal_mv_ref1_5v, &conv_mv_ref1_5v, CAL(CAL_ADC_GAIN_FACTOR),
+         (int16_t)CAL(CAL_ADC_OFFSET), CAL(CAL_ADC_15VREF_FACTOR));
+  cal_mv(&cal_mv_ref2_5v, &conv_mv_ref2_5v, CAL(CAL_ADC_GAIN_FACTOR),
+         (int16_t)CAL(CAL_ADC_OFFSET), CAL(CAL_ADC_25VREF_FACTOR));
+  cal_mv(&cal_mv_vcc, &conv_mv_vcc, CAL(CAL_ADC_GAIN_FACTOR),
+         (int16_t)CAL(CAL_ADC_OFFSET), 0);
+  cal_temp(&cal_temp_ref1_5v, &conv_temp_ref1_5v,
+           CAL(CAL_ADC_15T30), CAL(CAL_ADC_15T85));
+  cal_temp(&cal_temp_ref2_5v, &conv_temp_ref2_5v,
+           CAL(CAL_ADC_25T30), CAL(CAL_ADC_25T85));
+#undef CAL
+  return CALIB_OK;
+}
@@ -0,0 +1,44 @@
+/**********************************************************************
+ *  calib.h
+ *
+ * Gyri kalibrcis adatok (TLV, Info A szegmens) felhasznlsa.
+ * Az MSP430G2452/G2553 TLV terletn az ADC10 ersts- s
+ * ofszethibja, a bels referencik hibja, valamint a bels
+ * hmr 30 C-on s 85 C-on mrt kdja tallhat (CAL_ADC_*).
+ *
+ * A calib_init() indulskor egyszer beolvassa s ellenrzi a TLV-t,
+ * majd ezekbl a convert.h szerinti (k, b, s) egytthatkat szmol,
+ * gy a mrsenknti korrekci egyetlen szorzs-lptets marad.
+ * rvnytelen vagy hinyz kalibrci esetn (pl. MSP430G2231)
+ * az egytthatk a nvleges rtkek (conv_mv_ref1_5v stb.) maradnak.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef CALIB_H
+#define CALIB_H
+
+#include "stdint.h"
+#include "convert.h"
+
+#ifndef CALIB_TLV_ADDR                 //(az emultorban: emu/io430.h)
+#define CALIB_TLV_ADDR     0x10C0      //A TLV terlet kezdcme
+#endif
+#define CALIB_TLV_SIZE     64          //A TLV terlet mrete (bjt)
+#define CALIB_TAG_ADC10_1  0x10        //Az ADC10 kalibrcis blokk cmkje
+
+//--- A calib_init() visszatrsi rtkei -----------------------------
+#define CALIB_OK           0           //Gyri kalibrci rvnyben
+#define CALIB_BAD_CHECKSUM 1           //Hibs TLV ellenrzsszeg
+#define CALIB_NO_ADC_TAG   2           //Nincs ADC10 kalibrcis blokk
+
+//--- Kalibrlt egytthatk (a calib_init() tlti ki) ------------------
+extern conv_t cal_mv_ref1_5v;          //mV, Vref = 1,5 V
+extern conv_t cal_mv_ref2_5v;          //mV, Vref = 2,5 V
+extern conv_t cal_mv_vcc;              //mV, Vref = VCC (csak ADC korrekci)
+extern conv_t cal_temp_ref1_5v;        //Bels hmr, 0,1 C, Vref = 1,5 V
+extern conv_t cal_temp_ref2_5v;        //Bels hmr, 0,1 C, Vref = 2,5 V
+
+uint8_t calib_init(const uint8_t *p_tlv);
+
+#endif
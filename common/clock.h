@@ -0,0 +1,46 @@
+/**********************************************************************
+ *  clock.h
+ *
+ * A DCO belltsa a gyrilag kalibrlt frekvencik egyikre, s az
+ * rajel frekvencija a tbbi modul szmra (sw_uart, tick, timing).
+ * A frekvencit a CLOCK_MHZ makrval vlaszthatjuk ki a projekt
+ * Preprocessor/Defined symbols mezjben (1, 8, 12 vagy 16).
+ *
+ * Megjegyzs: az MSP430G2231 csak 1 MHz-es kalibrcis adatot
+ * tartalmaz, a 8, 12 s 16 MHz a G2452 s G2553 tpusokon hasznlhat.
+ * 12 MHz felett legalbb 3,3 V tpfeszltsg kell.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#ifndef CLOCK_MHZ
+#define CLOCK_MHZ     1                //MCLK = SMCLK = DCO (MHz)
+#endif
+#define CLOCK_HZ      (CLOCK_MHZ * 1000000UL)
+
+#if CLOCK_MHZ == 1
+#define CLOCK_CALBC1  CALBC1_1MHZ
+#define CLOCK_CALDCO  CALDCO_1MHZ
+#elif CLOCK_MHZ == 8
+#define CLOCK_CALBC1  CALBC1_8MHZ
+#define CLOCK_CALDCO  CALDCO_8MHZ
+#elif CLOCK_MHZ == 12
+#define CLOCK_CALBC1  CALBC1_12MHZ
+#define CLOCK_CALDCO  CALDCO_12MHZ
+#elif CLOCK_MHZ == 16
+#define CLOCK_CALBC1  CALBC1_16MHZ
+#define CLOCK_CALDCO  CALDCO_16MHZ
+#else
+#error "CLOCK_MHZ: csak 1, 8, 12 vagy 16 lehet (gyri kalibrci)"
+#endif
+
+//--- DCO belltsa: elbb a legkisebb DCO, hogy tmenetileg se
+//--- lpjk tl a megengedett frekvencit (lsd a tpus hibalistjt)
+#define CLOCK_INIT()  do { DCOCTL = 0;                                \
+                           BCSCTL1 = CLOCK_CALBC1;                    \
+                           DCOCTL = CLOCK_CALDCO; } while (0)
+
+#endif
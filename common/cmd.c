@@ -0,0 +1,97 @@
+/**********************************************************************
+ *  cmd.c
+ *
+ * Soronknti parancsrtelmez (lsd cmd.h). A szmot oszts s
+ * knyvtri eljrs (atoi) nlkl alaktjuk t.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "cmd.h"
+
+/**------------------------------------------------------------
+ * rtelmez inicializlsa
+ *-------------------------------------------------------------
+ * p_cmd - az rtelmez llapota
+ * p_tab - a parancsok tblzata
+ * n - a parancsok szma
+ */
+void cmd_init(cmd_t *p_cmd, const cmd_entry_t *p_tab, uint8_t n) {
+  p_cmd->tab = p_tab;
+  p_cmd->n = n;
+  p_cmd->len = 0;
+  p_cmd->overflow = 0;
+}
+
+/*-------------------------------------------------------------
+ * Eljeles decimlis szm talaktsa (-32767 .. 32767)
+ * A -32768 nem megengedett, mert az a CMD_NOARG jelzs.
+ * Visszatrsi rtk: 1 = j szm, 0 = hibs
+ *-------------------------------------------------------------*/
+static uint8_t cmd_number(const char *p, int16_t *p_val) {
+  uint8_t neg = 0;
+  int32_t v = 0;
+  if (*p == '-') { neg = 1; p++; }
+  if (!*p) return 0;
+  while (*p) {
+    if (*p < '0' || *p > '9') return 0;
+    v = (v << 3) + (v << 1) + (*p++ - '0'); //v*10 szorzs nlkl
+    if (v > 32767L) return 0;
+  }
+  if (neg) v = -v;
+  *p_val = (int16_t)v;
+  return 1;
+}
+
+/*-------------------------------------------------------------
+ * Egy teljes sor rtelmezse s vgrehajtsa
+ *-------------------------------------------------------------*/
+static uint8_t cmd_exec(cmd_t *p_cmd) {
+  char *p = p_cmd->line;
+  char *arg;
+  const char *name;
+  int16_t val = CMD_NOARG;
+  uint8_t i;
+  while (*p == ' ') p++;               //Vezet szkzk
+  if (!*p) return CMD_NONE;            //res sor
+  for (arg = p; *arg && *arg != ' '; arg++);
+  if (*arg) {                          //Van paramter
+    *arg++ = 0;
+    while (*arg == ' ') arg++;
+    if (*arg && !cmd_number(arg, &val)) return CMD_BAD_ARG;
+  }
+  for (i = 0; i < p_cmd->n; i++) {
+    const char *q = p;
+    name = p_cmd->tab[i].name;
+    while (*name && *name == *q) { name++; q++; }
+    if (!*name && !*q) return p_cmd->tab[i].fn(val);
+  }
+  return CMD_UNKNOWN;
+}
+
+/**------------------------------------------------------------
+ * Egy berkezett karakter feldolgozsa
+ *-------------------------------------------------------------
+ * p_cmd - az rtelmez llapota
+ * c - a karakter
+ * Visszatrsi rtk: CMD_NONE, amg a sor nem teljes, utna a
+ * vgrehajts eredmnye (CMD_OK, CMD_UNKNOWN, CMD_BAD_ARG, CMD_TOO_LONG)
+ */
+uint8_t cmd_put(cmd_t *p_cmd, char c) {
+  uint8_t res;
+  if (c == '\r' || c == '\n') {        //Sor vge
+    p_cmd->line[p_cmd->len] = 0;
+    res = p_cmd->overflow ? CMD_TOO_LONG : cmd_exec(p_cmd);
+    p_cmd->len = 0;
+    p_cmd->overflow = 0;
+    return res;
+  }
+  if (c == '\b' || c == 0x7F) {        //Backspace: az utols karakter trlse
+    if (p_cmd->len) p_cmd->len--;
+  } else if (p_cmd->len < CMD_LINE_MAX) {
+    p_cmd->line[p_cmd->len++] = c;
+  } else {
+    p_cmd->overflow = 1;               //A sor vgig eldobjuk
+  }
+  return CMD_NONE;
+}
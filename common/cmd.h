@@ -0,0 +1,50 @@
+/**********************************************************************
+ *  cmd.h
+ *
+ * Soronknti parancsrtelmez a soros vonalon rkez belltsokhoz.
+ * Egy sor: "<nv> [<egsz szm>]", CR vagy LF zrja, a backspace
+ * trli az utols karaktert. A szm -32767 s 32767 kz eshet, a
+ * paramter nlkli parancs eljrsa CMD_NOARG rtket kap. A neveket
+ * a hv tblzata (cmd_entry_t) adja meg, a parancs eljrsa
+ * ellenrzi s belltja az rtket.
+ *
+ * A modul hardverfggetlen, karakterenknt etetjk (cmd_put), gy a
+ * vteli megszakts s a fprogram kztt nincs vrakozs.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef CMD_H
+#define CMD_H
+
+#include "stdint.h"
+
+#ifndef CMD_LINE_MAX
+#define CMD_LINE_MAX   12              //A sor leghosszabb hossza
+#endif
+#define CMD_NOARG      (-32767 - 1)    //Nem volt szmparamter (a -32768 hibs)
+
+//--- A cmd_put() s a parancseljrsok visszatrsi rtkei ---------
+#define CMD_NONE       0               //A sor mg nincs ksz (vagy res)
+#define CMD_OK         1               //Vgrehajtva
+#define CMD_UNKNOWN    2               //Ismeretlen parancs
+#define CMD_BAD_ARG    3               //Hibs vagy tartomnyon kvli paramter
+#define CMD_TOO_LONG   4               //Tl hossz sor (eldobtuk)
+
+typedef struct {
+  const char *name;                    //A parancs neve
+  uint8_t (*fn)(int16_t arg);          //Vgrehajts: CMD_OK vagy CMD_BAD_ARG
+} cmd_entry_t;
+
+typedef struct {
+  const cmd_entry_t *tab;              //A parancsok tblzata
+  uint8_t n;                           //s elemszma
+  uint8_t len;                         //Az eddig berkezett karakterek
+  uint8_t overflow;                    //1: a sor tl hossz volt
+  char line[CMD_LINE_MAX + 1];
+} cmd_t;
+
+void cmd_init(cmd_t *p_cmd, const cmd_entry_t *p_tab, uint8_t n);
+uint8_t cmd_put(cmd_t *p_cmd, char c);
+
+#endif
@@ -0,0 +1,63 @@
+/**********************************************************************
+ *  convert.c
+ *
+ * ADC kd tszmtsa mrnki egysgre oszts nlkl.
+ * Az egytthatkat gy vlasztottuk, hogy k 16 bites maradjon
+ * (a lehet legnagyobb s mellett), b pedig a korbbi egsz
+ * osztsos kpletek csonkolst kvesse.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "convert.h"
+
+//                                     k      b           s      eredeti kplet
+const conv_t conv_mv_ref1_5v   = { 48047,        13L, 15 };  //data*1500/1023
+const conv_t conv_mv_ref2_5v   = { 40039,        51L, 14 };  //data*2500/1023
+const conv_t conv_mv_vcc       = { 56054,       345L, 14 };  //data*3500/1023
+const conv_t conv_vdd_ref2_5v  = { 40039,        27L, 13 };  //data*5000/1023
+const conv_t conv_temp_ref1_5v = { 33836, -22753077L, 13 };  //(data*270687-182023932)>>16
+const conv_t conv_temp_ref2_5v = { 56384, -22752929L, 13 };  //(data*1762-711030)>>8
+const conv_t conv_temp_vcc     = { 39472, -11376473L, 12 };  //(data*2467-711030)>>8
+
+/*-------------------------------------------------------------
+ * Szorzs: code * k, a kd nbits bitjn elgazs nlkl
+ * (maszkolt sszeadssal), ezrt a futsid nem fgg a kdtl.
+ *-------------------------------------------------------------*/
+static uint32_t conv_mul(uint16_t k16, uint16_t code, uint8_t nbits) {
+  uint32_t acc, k;
+  acc = 0;
+  k = k16;
+  while(nbits--) {
+    acc += k & (0 - (uint32_t)(code & 1));  //k hozzadsa, ha a bit '1'
+    k <<= 1;
+    code >>= 1;
+  }
+  return acc;
+}
+
+/**------------------------------------------------------------
+ * tszmts: (code * k + b) >> s
+ * A szorzs a kd 10 bitjn halad vgig, elgazs nlkl,
+ * ezrt a futsid nem fgg a kdtl.
+ *-------------------------------------------------------------
+ * p_conv - az egytthatk cme
+ * code - az ADC konverzi eredmnye (0 - 1023)
+ */
+int32_t conv_apply(const conv_t *p_conv, uint16_t code) {
+  return ((int32_t)conv_mul(p_conv->k,code,10) + p_conv->b) >> p_conv->s;
+}
+
+/**------------------------------------------------------------
+ * tszmts tlmintavtelezett (10+n bites) kdra:
+ * (code * k + b * 2^n) >> (s + n)
+ * Ugyanazok az egytthatk hasznlhatk, a futsid csak n-tl fgg.
+ *-------------------------------------------------------------
+ * p_conv - az egytthatk cme
+ * code - a decimlt eredmny (0 - 2^(10+n)-1), lsd decimate()
+ * n - a tbbletbitek szma (0 - CONV_OS_NMAX)
+ */
+int32_t conv_apply_os(const conv_t *p_conv, uint16_t code, uint8_t n) {
+  return ((int32_t)conv_mul(p_conv->k,code,10+n) + p_conv->b * (1L << n))
+         >> (p_conv->s + n);
+}
@@ -0,0 +1,43 @@
+/**********************************************************************
+ *  convert.h
+ *
+ * ADC kd (0 - 1023) tszmtsa mrnki egysgre (mV, 0,1 C)
+ * oszts nlkl: eredmny = (kd * k + b) >> s
+ * A k, b, s egytthatk elre kiszmtott konstansok, a szorzst
+ * pedig rgztett lpsszm (10 bites) lptet-sszead eljrs
+ * vgzi, gy minden tszmts ugyanannyi ideig tart.
+ *
+ * Tlmintavtelezett (10+n bites, lsd stat.h decimate()) kdokra
+ * a conv_apply_os() ugyanezekkel az egytthatkkal szmol.
+ *
+ * Az egytthatk a mintaprogramok korbbi kpleteivel (pl.
+ * data*1500L/1023) mind az 1024 kdra legfeljebb 1 LSB eltrst adnak.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef CONVERT_H
+#define CONVERT_H
+
+#include "stdint.h"
+
+#define CONV_OS_NMAX  5                 //(10+n) bites kd * k mg elfr 31 biten
+
+typedef struct {
+  uint16_t k;                          //Szorz
+  int32_t  b;                          //Eltols (a lptets eltt)
+  uint8_t  s;                          //Jobbra lptets bitekben
+} conv_t;
+
+extern const conv_t conv_mv_ref1_5v;   //mV, Vref = 1,5 V
+extern const conv_t conv_mv_ref2_5v;   //mV, Vref = 2,5 V
+extern const conv_t conv_mv_vcc;       //mV, Vref = VCC (3,5 V)
+extern const conv_t conv_vdd_ref2_5v;  //VDD mV-ban a Chan 11-bl, Vref = 2,5 V
+extern const conv_t conv_temp_ref1_5v; //Bels hmr, 0,1 C, Vref = 1,5 V
+extern const conv_t conv_temp_ref2_5v; //Bels hmr, 0,1 C, Vref = 2,5 V
+extern const conv_t conv_temp_vcc;     //Bels hmr, 0,1 C, Vref = VCC
+
+int32_t conv_apply(const conv_t *p_conv, uint16_t code);
+int32_t conv_apply_os(const conv_t *p_conv, uint16_t code, uint8_t n);
+
+#endif
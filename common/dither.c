@@ -0,0 +1,43 @@
+/**********************************************************************
+ *  dither.c
+ *
+ * Hozzadott zaj (dither) ellltsa a Timer_A CCR0 megszaktsval.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "dither.h"
+#include "isr.h"
+
+static uint8_t dither_cnt;             //CCR0 esemnyek szmllja
+
+/**------------------------------------------------------------
+ * A dither kimenet belltsa s a CCR0 megszakts engedlyezse
+ *-------------------------------------------------------------*/
+void dither_init(void) {
+  P1OUT &= ~DITHER_PIN;                //Kezdllapot: alacsony szint
+  P1DIR |= DITHER_PIN;                 //Digitlis kimenet
+  dither_cnt = 0;
+  TACCTL0 |= CCIE;                     //CCR0 megszakts engedlyezse
+  __enable_interrupt();
+}
+
+/**------------------------------------------------------------
+ * A dither lelltsa, a kimenet alacsony szintre kerl
+ *-------------------------------------------------------------*/
+void dither_stop(void) {
+  TACCTL0 &= ~CCIE;                    //CCR0 megszakts tiltsa
+  P1OUT &= ~DITHER_PIN;
+}
+
+//----------------------------------------------------------------------
+// CCR0 megszakts: mintnknt kt esemny, fl peridusonknt vltunk
+//----------------------------------------------------------------------
+ISR(TIMER0_A0_VECTOR, TIMERA0_ISR)     //A jelzbit automatikusan trldik
+{
+  if (++dither_cnt >= DITHER_PERIOD) { //DITHER_PERIOD esemny = fl peridus
+    dither_cnt = 0;
+    P1OUT ^= DITHER_PIN;               //A dither kimenet tbillentse
+  }
+}
@@ -0,0 +1,37 @@
+/**********************************************************************
+ *  dither.h
+ *
+ * Hozzadott zaj (dither) a tlmintavtelezshez. Ha a mrt jel
+ * zaja 1 LSB-nl kisebb, a 4^n minta sszege nem hordoz tbblet
+ * informcit. Ilyenkor a DITHER_PIN kimenetet egy nagy ellenllssal
+ * (pl. 1 MOhm) ktjk az analg bemenetre (a bemenet s a fld kztt
+ * kondenztorral), a kimenetet pedig a Timer_A CCR0 megszaktsa
+ * DITHER_PERIOD mintnknt ki-be kapcsolja. Az RC tag hromszgszer,
+ * 1-2 LSB cscstl cscsig terjed jelet ad, amelynek tlaga egy teljes
+ * peridusra lland, ezrt az ofszetet nem vltoztatja meg.
+ *
+ * Felttelek:
+ *  - a mintavtelt Timer_A OUT0 indtja (SHS_2, OUTMOD_4, felfel
+ *    szmlls), azaz mintnknt kt CCR0 esemny trtnik
+ *  - a TIMER0_A0 megszaktsi vektor ez a modul
+ *  - DITHER_PERIOD a decimlt blokk (4^n minta) osztja legyen
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef DITHER_H
+#define DITHER_H
+
+#include "stdint.h"
+
+#ifndef DITHER_PIN
+#define DITHER_PIN     BIT4            //Dither kimenet (P1.4)
+#endif
+#ifndef DITHER_PERIOD
+#define DITHER_PERIOD  16              //A dither jel peridusa mintkban
+#endif
+
+void dither_init(void);
+void dither_stop(void);
+
+#endif
@@ -0,0 +1,1074 @@
+/**********************************************************************
+ *  emu/emu.c
+ *
+ * Gazdagpes perifriaemultor (lsd emu.h).
+ *
+ * Az id pikoszekundumban telik (64 bit, kb. 200 nap). A futs egy
+ * esemnyhurok: a kvetkez esemny a Timer_A legkzelebbi
+ * "rdekes" tse (komparls vagy tforduls, a kzbls tseket
+ * egyben lpjk t), az ACLK le (ha rgzts hasznlja), az RXD
+ * kvetkez le, az ADC konverzi vge s a WDT lejrata kzl a
+ * legkorbbi. Minden esemny utn, ha GIE = 1, kiszolgljuk a fgg
+ * megszaktsokat (priorits: WDT > TIMER0_A0 > TIMER0_A1 > ADC10).
+ *
+ * A program ltal bert rtkeket a regiszterek rnykmsolatval
+ * vetjk ssze a kvetkez elrsnl (sync), gy a mellkhatsok
+ * (ADC10SC, ENC, TACLR, P1OUT l) a bers pillanatban jelentkeznek.
+ * A DTC cmt (ADC10SA, 16 bit) a gazdagp cmtartomnyba kpezzk
+ * vissza: a statikus adatok vagy a verem 64 kB-os krnyezetbl.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "io430.h"
+#include "emu.h"
+
+#define PS_PER_S      1e12
+#define NEVER         UINT64_MAX
+#define NOREACH       0x20000UL        //A szmll nem ri el ezt az rtket
+#define DCO_RESET_HZ  1100000.0        //DCO kalibrls nlkl (RSEL = 7)
+#define ADC10OSC_HZ   5000000.0        //Nvleges rtk (3,7 - 6,3 MHz)
+#define XTAL_HZ       32768.0
+#define RX_FRAME      11               //Start + 8 adat + 2 stop bit
+#define ISR_ENTRY     6                //Megszakts elfogadsa (MCLK)
+#define ISR_RETI      5                //Visszatrs (MCLK)
+#define ISR_DEPTH     8                //Egymsba gyazott megszaktsok
+//--- Tipikus ramfelvtel 3 V-on (MSP430G2x31 adatlap) -----------------
+#define I_AM_UA_MHZ   220.0            //Aktv md, MHz-enknt
+#define I_LPM0_UA     56.0             //LPM0, 1 MHz-es DCO
+#define I_LPM3_UA     0.5              //LPM3, VLO
+#define I_ADC_UA      600.0            //ADC10 konverzi kzben
+#define I_REF_UA      250.0            //Bels referencia (REFON)
+
+emu_cfg_t emu_cfg = {
+  1.0, 3300.0, 25.0, 0.0, 12000.0, 0, 9600, 1, 0, 0.1, 0, {{0, 0, 0, 0}}
+};
+uint8_t emu_tlv[64];
+
+//--- A regiszterek s rnykmsolatuk --------------------------------
+static uint16_t reg16[EMU_N16], old16[EMU_N16];
+static uint8_t reg8[EMU_N8], old8[EMU_N8];
+static void (*vectors[16])(void);      //Az ISR() makr tlti ki (isr.h)
+
+//--- Gyri DCO kalibrci: BCSCTL1, DCOCTL, frekvencia ----------------
+static const struct { uint8_t bc1, dco; double hz; } dco_cal[4] = {
+  { 0x86, 0xA6, 1e6 }, { 0x8D, 0x92, 8e6 }, { 0x8E, 0x9D, 12e6 }, { 0x8F, 0x95, 16e6 }
+};
+
+static const char *const vec_name[16] = {
+  0, 0, "PORT1", "PORT2", 0, "ADC10", "USCIAB0TX", "USCIAB0RX",
+  "TIMER0_A1", "TIMER0_A0", "WDT", "COMPARATORA", 0, 0, "NMI", 0
+};
+
+static struct {
+  uint64_t now, limit;                 //Virtulis id, a futs vge (ps)
+  uint16_t sr;                         //Sttuszregiszter (GIE, LPM bitek)
+  uint16_t sr_stack[ISR_DEPTH];        //Megszaktskor elmentett SR
+  uint8_t depth;
+  double mclk_hz;
+  uint64_t mclk_ps, smclk_ps, aclk_ps; //Peridusidk
+//--- Timer_A
+  uint64_t ta_ps, ta_next;             //Egy ts ideje (0: ll), a kvetkez ts
+  uint8_t ta_out;                      //OUT0..OUT2
+  uint8_t ta_cci;                      //A CCIx bemenetek szintje
+  uint8_t ta_down;                     //Fel-le md: lefel szmll
+//--- ADC10 s DTC
+  uint8_t adc_busy, adc_ch;            //Konverzi folyik, csatornja
+  uint8_t adc_inseq, adc_seq;          //Sorozat kzben: a kvetkez csatorna
+  uint64_t adc_sample, adc_done;       //A mintavtel vge, a konverzi vge
+  uint16_t *dtc_base;
+  uint8_t dtc_on, dtc_idx, dtc_blk, dtc_arm;
+  uint8_t ref_warned;
+//--- WDT+
+  uint64_t wdt_ps, wdt_next;
+//--- P1 lbak, UART dekdols (TXD = P1.1), RXD jel (P1.2)
+  uint8_t pins;
+  uint64_t pin_t[8], pin_high[8];
+  uint32_t pin_edges[8];
+  uint64_t bit_ps;
+  uint8_t ux_busy, ux_bit, ux_data, ux_level;
+  uint64_t ux_t0;
+  uint32_t ux_frames, ux_errors;
+  const char *rx;
+  size_t rx_len;
+  uint64_t rx_t0;
+//--- Statisztika
+  uint64_t isr_ps, t_act, t_lpm0, t_lpm3, t_adc, t_ref;
+  double q_act;                        //Aktv tlts (uA * ps, MCLK szerint)
+  uint32_t n_conv, n_dtc, n_miss, n_irq[16], n_wake;
+  uint32_t rng;
+  uintptr_t data_lo, data_hi, stack_top;
+  struct timespec host0;
+  uint8_t finished;
+} emu;
+
+extern char __data_start[], _end[];    //A statikus adatok hatrai (ld)
+
+static void run(uint64_t t_end);
+static void irq(void);
+static void pins_update(void);
+static void ta_cci_update(void);
+
+/*-------------------------------------------------------------
+ * Segdeljrsok
+ *-------------------------------------------------------------*/
+static uint64_t ps_of(double hz) {
+  return (uint64_t)(PS_PER_S / hz + 0.5);
+}
+
+static void fail(const char *fmt, ...) {
+  va_list ap;
+  fflush(stdout);
+  fprintf(stderr, "emu: HIBA (%.6f s): ", emu.now / PS_PER_S);
+  va_start(ap, fmt);
+  vfprintf(stderr, fmt, ap);
+  va_end(ap);
+  fprintf(stderr, "\n");
+  emu_finish(2);
+}
+
+static void hw16(uint8_t r, uint16_t v) {  //A hardver rja: nem mellkhats
+  reg16[r] = old16[r] = v;
+}
+
+static void hw8(uint8_t r, uint8_t v) {
+  reg8[r] = old8[r] = v;
+}
+
+//--- Gauss zaj (xorshift32 + Box-Muller), ismtelhet sorozat ---------
+static double gauss(void) {
+  double u1, u2;
+  uint32_t x = emu.rng;
+  x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+  u1 = (x + 1.0) / 4294967296.0;
+  x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+  u2 = x / 4294967296.0;
+  emu.rng = x;
+  return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+/*-------------------------------------------------------------
+ * rajelek: DCO a kalibrcis konstans szerint, osztk, ACLK
+ *-------------------------------------------------------------*/
+static void clk_update(void) {
+  double dco = DCO_RESET_HZ, aclk;
+  uint64_t dco_ps;
+  uint8_t i;
+  for (i = 0; i < 4; i++) {
+    if ((reg8[EMU_BCSCTL1] & 0x8F) == dco_cal[i].bc1) dco = dco_cal[i].hz;
+  }
+  dco_ps = ps_of(dco);
+  emu.mclk_ps = dco_ps << ((reg8[EMU_BCSCTL2] >> 4) & 3);
+  emu.smclk_ps = dco_ps << ((reg8[EMU_BCSCTL2] >> 1) & 3);
+  emu.mclk_hz = PS_PER_S / emu.mclk_ps;
+  aclk = (emu_cfg.xtal && (reg8[EMU_BCSCTL3] & LFXT1S_3) == LFXT1S_0) ? XTAL_HZ : emu_cfg.vlo;
+  emu.aclk_ps = ps_of(aclk) << ((reg8[EMU_BCSCTL1] >> 4) & 3);
+}
+
+static uint8_t aclk_level(void) {      //Az ACLK ngyszgjel szintje
+  return ((emu.now / (emu.aclk_ps / 2)) & 1) == 0;
+}
+
+/*-------------------------------------------------------------
+ * RXD (P1.2): a megadott szveg keretei egyms utn
+ *-------------------------------------------------------------*/
+static uint8_t rx_bit(uint64_t k) {    //A k. bitid szintje
+  uint64_t ch = k / RX_FRAME;
+  uint8_t b = k % RX_FRAME;
+  if (ch >= emu.rx_len) return 1;
+  if (b == 0) return 0;                //Start bit
+  if (b <= 8) return (emu.rx[ch] >> (b - 1)) & 1;
+  return 1;                            //Stop bitek
+}
+
+static uint8_t rx_level(void) {
+  if (!emu.rx || emu.now < emu.rx_t0) return 1;
+  return rx_bit((emu.now - emu.rx_t0) / emu.bit_ps);
+}
+
+static uint64_t rx_next(void) {        //Az RXD kvetkez le
+  uint64_t k;
+  if (!emu.rx) return NEVER;
+  if (emu.now < emu.rx_t0) return emu.rx_t0;
+  for (k = (emu.now - emu.rx_t0) / emu.bit_ps + 1; k < emu.rx_len * RX_FRAME; k++) {
+    if (rx_bit(k) != rx_bit(k - 1)) return emu.rx_t0 + k * emu.bit_ps;
+  }
+  return NEVER;
+}
+
+/*-------------------------------------------------------------
+ * UART dekdols a TXD lbon: mintavtel a bitek kzepn, a start
+ * bit lefut ltl szmolva. A start bit kzepn is alacsony szint
+ * kell (a kimenet belltsakor keletkez tske nem keret), keretezsi
+ * hiba esetn nincs kirs. Az alacsonyan tartott lb (break, pl. a
+ * TXD-t nem hasznl mintkban) nem hiba.
+ *-------------------------------------------------------------*/
+static void uart_feed(uint64_t t, uint8_t level) {
+  while (emu.ux_busy) {
+    uint64_t s = emu.ux_t0 + (2 * emu.ux_bit + 1) * emu.bit_ps / 2;
+    if (s > t) break;
+    if (emu.ux_bit == 0) {             //A start bit kzepn mg alacsony?
+      emu.ux_busy = !emu.ux_level;     //Ha nem, tske volt
+      emu.ux_bit++;
+    } else if (emu.ux_bit <= 8) {
+      if (emu.ux_level) emu.ux_data |= 1 << (emu.ux_bit - 1);
+      emu.ux_bit++;
+    } else {                           //Stop bit
+      if (emu.ux_level) {
+        putchar(emu.ux_data);
+        emu.ux_frames++;
+      } else if (emu.ux_data) {        //A csupa 0 keret a vonal
+        emu.ux_errors++;               //alacsonyban tartsa (break)
+      }
+      emu.ux_busy = 0;
+    }
+  }
+  if (!emu.ux_busy && emu.ux_level && !level) {
+    emu.ux_busy = 1;                   //Start bit
+    emu.ux_t0 = t;
+    emu.ux_bit = 0;
+    emu.ux_data = 0;
+  }
+  emu.ux_level = level;
+}
+
+/*-------------------------------------------------------------
+ * P1 lbak: kimenet (P1OUT vagy a Timer_A kimenete), bemenet
+ *-------------------------------------------------------------*/
+static uint8_t pins_compute(void) {
+  uint8_t b, m, p = 0;
+  for (b = 0; b < 8; b++) {
+    m = 1 << b;
+    if (reg8[EMU_P1DIR] & m) {
+      if ((reg8[EMU_P1SEL] & m) && (b == 1 || b == 5)) {
+        if (emu.ta_out & BIT0) p |= m; //TA0.0
+      } else if ((reg8[EMU_P1SEL] & m) && (b == 2 || b == 6)) {
+        if (emu.ta_out & BIT1) p |= m; //TA0.1
+      } else if (reg8[EMU_P1OUT] & m) {
+        p |= m;
+      }
+    } else if (b == 2 && emu.rx) {
+      if (rx_level()) p |= m;          //RXD
+    } else if (!(reg8[EMU_P1REN] & m) || (reg8[EMU_P1OUT] & m)) {
+      p |= m;                          //Nyitott bemenet: magas (Launchpad)
+    }
+  }
+  return p;
+}
+
+static void pins_update(void) {
+  uint8_t p, d, b;
+  p = pins_compute();
+  d = p ^ emu.pins;
+  if (!d) return;
+  for (b = 0; b < 8; b++) {
+    if (!(d & (1 << b))) continue;
+    if (emu.pins & (1 << b)) emu.pin_high[b] += emu.now - emu.pin_t[b];
+    emu.pin_t[b] = emu.now;
+    emu.pin_edges[b]++;
+  }
+  emu.pins = p;
+  if (d & BIT1) uart_feed(emu.now, (p >> 1) & 1);
+  ta_cci_update();                     //P1.1, P1.2: CCI0A, CCI1A
+}
+
+/*-------------------------------------------------------------
+ * ADC10
+ *-------------------------------------------------------------*/
+static double analog(uint8_t ch, uint64_t t) {  //A bemenet (mV)
+  const emu_input_t *p = &emu_cfg.in[ch & 15];
+  double s = t / PS_PER_S, v;
+  if (ch == 10) {
+    v = (0.00355 * emu_cfg.temp + 0.986) * 1000.0;  //Bels hmr
+  } else if (ch >= 11) {
+    v = emu_cfg.vcc / 2;               //(VCC - VSS) / 2
+  } else if (p->kind == EMU_IN_RAMP) {
+    v = p->a + (p->c > 0 ? fmod(s, p->c) / p->c : 0) * (p->b - p->a);
+  } else if (p->kind == EMU_IN_SINE) {
+    v = p->a + p->b * sin(2 * M_PI * p->c * s);
+  } else {
+    v = p->a;
+  }
+  if (emu_cfg.noise > 0) v += emu_cfg.noise * gauss();
+  return v;
+}
+
+static uint16_t adc_code(uint8_t ch, uint64_t t) {
+  uint16_t ctl0 = reg16[EMU_ADC10CTL0];
+  double vp, vn, n;
+  switch ((ctl0 >> 13) & 3) {          //VR+
+  case 0:
+    vp = emu_cfg.vcc;
+    break;
+  case 1:
+    if (!(ctl0 & REFON)) {
+      if (!emu.ref_warned) fprintf(stderr, "emu: SREF_1, de REFON = 0\n");
+      emu.ref_warned = 1;
+      vp = 0;
+    } else {
+      vp = (ctl0 & REF2_5V) ? 2500.0 : 1500.0;
+    }
+    break;
+  default:
+    vp = analog(4, t);                 //VeREF+ = A4
+  }
+  vn = (ctl0 & SREF_4) ? analog(3, t) : 0;  //VeREF- = A3
+  n = vp > vn ? (analog(ch, t) - vn) * 1023.0 / (vp - vn) + 0.5 : 0;
+  if (n < 0) n = 0;
+  if (n > 1023) n = 1023;
+  if (reg16[EMU_ADC10CTL1] & ADC10DF) {
+    return (uint16_t)(((int16_t)n - 512) << 6);  //Kettes komplemens, balra igaztva
+  }
+  return (uint16_t)n;
+}
+
+static uint64_t adc_clk_ps(void) {
+  uint16_t ctl1 = reg16[EMU_ADC10CTL1];
+  uint64_t p;
+  switch ((ctl1 >> 3) & 3) {
+  case 0:  p = ps_of(ADC10OSC_HZ); break;
+  case 1:  p = emu.aclk_ps; break;
+  case 2:  p = emu.mclk_ps; break;
+  default: p = emu.smclk_ps;
+  }
+  return p * (((ctl1 >> 5) & 7) + 1);
+}
+
+static void adc_start(uint8_t ch) {
+  static const uint8_t sht[4] = { 4, 8, 16, 64 };
+  uint64_t p = adc_clk_ps();
+  emu.adc_busy = 1;
+  emu.adc_ch = ch;
+  emu.adc_sample = emu.now + sht[(reg16[EMU_ADC10CTL0] >> 11) & 3] * p;
+  emu.adc_done = emu.adc_sample + 13 * p;
+  hw16(EMU_ADC10CTL1, reg16[EMU_ADC10CTL1] | BUSY);
+}
+
+static void adc_stop(void) {
+  emu.adc_busy = 0;
+  emu.adc_inseq = 0;
+  hw16(EMU_ADC10CTL1, reg16[EMU_ADC10CTL1] & ~BUSY);
+}
+
+static void adc_trigger(void) {        //Az SHI jel felfut le
+  uint16_t ctl0 = reg16[EMU_ADC10CTL0];
+  if (!(ctl0 & ENC) || !(ctl0 & ADC10ON)) return;
+  if (emu.adc_busy) {
+    emu.n_miss++;                      //Konverzi kzben: elveszik
+    return;
+  }
+  if (((reg16[EMU_ADC10CTL1] >> 1) & 1) && emu.adc_inseq) {
+    adc_start(emu.adc_seq);            //Sorozat folytatsa
+  } else {
+    emu.adc_inseq = (reg16[EMU_ADC10CTL1] >> 1) & 1;
+    adc_start(reg16[EMU_ADC10CTL1] >> 12);
+  }
+}
+
+static uint16_t *host_ptr(uint16_t sa) {
+  uintptr_t lo[2], hi[2], c;
+  uint8_t i;
+  lo[0] = emu.data_lo;                 //Statikus adatok (a regiszterek is)
+  hi[0] = emu.data_hi;
+  lo[1] = emu.stack_top - 0xFFFF;      //A verem
+  hi[1] = emu.stack_top;
+  for (i = 0; i < 2; i++) {
+    c = (lo[i] & ~(uintptr_t)0xFFFF) | sa;
+    if (c < lo[i]) c += 0x10000;
+    if (c + 2 <= hi[i]) return (uint16_t *)c;
+  }
+  fail("ADC10SA = 0x%04X nem kepezheto le gazdagep cimre", sa);
+  return 0;
+}
+
+static void dtc_start(void) {          //ADC10SA rsa
+  if (!reg8[EMU_ADC10DTC1]) {
+    emu.dtc_on = 0;
+    return;
+  }
+  emu.dtc_base = host_ptr(reg16[EMU_ADC10SA]);
+  emu.dtc_on = 1;
+  emu.dtc_idx = 0;
+  emu.dtc_blk = 0;
+  hw8(EMU_ADC10DTC0, reg8[EMU_ADC10DTC0] & ~ADC10B1);
+}
+
+static void adc_result(uint16_t v) {   //ADC10MEM, DTC, ADC10IFG
+  uint8_t n = reg8[EMU_ADC10DTC1], dtc0 = reg8[EMU_ADC10DTC0];
+  hw16(EMU_ADC10MEM, v);
+  if (!n) {
+    hw16(EMU_ADC10CTL0, reg16[EMU_ADC10CTL0] | ADC10IFG);
+    return;
+  }
+  if (!emu.dtc_on) return;             //A blokk megtelt, nincs jraindtva
+  emu.dtc_base[(emu.dtc_blk ? n : 0) + emu.dtc_idx] = v;
+  emu.n_dtc++;
+  if (++emu.dtc_idx < n) return;
+  emu.dtc_idx = 0;
+  hw16(EMU_ADC10CTL0, reg16[EMU_ADC10CTL0] | ADC10IFG);
+  if (dtc0 & ADC10TB) {
+    if (!emu.dtc_blk) {
+      hw8(EMU_ADC10DTC0, dtc0 | ADC10B1);   //Az els blokk telt meg
+      emu.dtc_blk = 1;
+      return;
+    }
+    hw8(EMU_ADC10DTC0, dtc0 & ~ADC10B1);
+    emu.dtc_blk = 0;
+  }
+  if (!(dtc0 & ADC10CT)) emu.dtc_on = 0;
+}
+
+static void adc_done(void) {           //A konverzi vge
+  uint16_t ctl0, ctl1;
+  uint8_t conseq;
+  int next = -1;
+  emu.adc_busy = 0;
+  emu.n_conv++;
+  adc_result(adc_code(emu.adc_ch, emu.adc_sample));
+  ctl0 = reg16[EMU_ADC10CTL0];
+  ctl1 = reg16[EMU_ADC10CTL1];
+  conseq = (ctl1 >> 1) & 3;
+  if (conseq == 2) {
+    if ((ctl0 & ENC) && (ctl0 & MSC)) next = ctl1 >> 12;
+  } else if (conseq != 0 && emu.adc_ch > 0 && (ctl0 & ENC)) {
+    emu.adc_inseq = 1;                 //Sorozat: a kvetkez csatorna
+    emu.adc_seq = emu.adc_ch - 1;
+    if (ctl0 & MSC) next = emu.adc_seq;
+  } else {
+    emu.adc_inseq = 0;                 //A sorozat vge
+    if (conseq == 3 && (ctl0 & ENC) && (ctl0 & MSC)) {
+      emu.adc_inseq = 1;
+      next = ctl1 >> 12;
+    }
+  }
+  if (next >= 0) {
+    adc_start((uint8_t)next);
+  } else {
+    hw16(EMU_ADC10CTL1, ctl1 & ~BUSY);
+  }
+}
+
+/*-------------------------------------------------------------
+ * Timer_A3
+ *-------------------------------------------------------------*/
+static uint64_t ta_tick_ps(void) {     //Egy szmllts ideje, 0: ll
+  uint16_t ctl = reg16[EMU_TACTL];
+  uint8_t mc = (ctl >> 4) & 3;
+  uint64_t p;
+  if (mc == 0 || (mc != 2 && reg16[EMU_TACCR0] == 0)) return 0;
+  switch ((ctl >> 8) & 3) {
+  case 1:
+    if (emu.sr & OSCOFF) return 0;
+    p = emu.aclk_ps;
+    break;
+  case 2:
+    if (emu.sr & SCG1) return 0;       //LPM3: az SMCLK ll
+    p = emu.smclk_ps;
+    break;
+  default:
+    return 0;                          //Kls rajel: nincs bektve
+  }
+  return p << ((ctl >> 6) & 3);
+}
+
+static void ta_check(void) {           //rajel vlts, indts, lells
+  uint64_t p = ta_tick_ps();
+  if (p != emu.ta_ps) {
+    emu.ta_ps = p;
+    emu.ta_next = p ? emu.now + p : NEVER;
+  }
+}
+
+static uint32_t ta_dist(uint16_t v) {  //Hny ts mlva lesz TAR = v
+  uint16_t tar = reg16[EMU_TAR], c0 = reg16[EMU_TACCR0];
+  switch ((reg16[EMU_TACTL] >> 4) & 3) {
+  case 2:
+    return (uint16_t)(v - tar) ? (uint16_t)(v - tar) : 0x10000UL;
+  case 1:
+    if (tar >= c0) {                   //TACCR0-nl (vagy fltte): 0 kvetkezik
+      return v == 0 ? 1 : (v <= c0 ? 1UL + v : NOREACH);
+    }
+    if (v > tar && v <= c0) return v - tar;
+    return v <= c0 ? (uint32_t)(c0 - tar) + 1 + v : NOREACH;
+  default:
+    return 1;                          //Fel-le md: tsenknt
+  }
+}
+
+static uint32_t ta_min_dist(void) {    //A legkzelebbi esemny tvolsga
+  uint32_t d, dx;
+  uint8_t x;
+  d = ta_dist(0);
+  for (x = 0; x < 3; x++) {
+    if (reg16[EMU_TACCTL0 + x] & CAP) continue;
+    dx = ta_dist(reg16[EMU_TACCR0 + x]);
+    if (dx < d) d = dx;
+  }
+  return d;
+}
+
+static uint8_t ta_step(uint32_t d) {   //d ts (nem lpnk t esemnyt)
+  uint16_t tar = reg16[EMU_TAR], c0 = reg16[EMU_TACCR0];
+  switch ((reg16[EMU_TACTL] >> 4) & 3) {
+  case 2:
+    tar += d;
+    break;
+  case 1:
+    if (tar >= c0) tar = d - 1;
+    else if (tar + d <= c0) tar += d;
+    else tar = d - (c0 - tar) - 1;
+    break;
+  default:
+    if (!emu.ta_down && tar >= c0) emu.ta_down = 1;
+    else if (emu.ta_down && tar == 0) emu.ta_down = 0;
+    tar = emu.ta_down ? tar - 1 : tar + 1;
+    hw16(EMU_TAR, tar);
+    return tar == 0 && emu.ta_down;    //tforduls: lefel a 0-hoz rt
+  }
+  hw16(EMU_TAR, tar);
+  return tar == 0;
+}
+
+static void ta_set_out(uint8_t x, uint8_t level) {
+  uint16_t ctl1 = reg16[EMU_ADC10CTL1];
+  static const int8_t shs_out[4] = { -1, 1, 0, 2 };
+  if (((emu.ta_out >> x) & 1) == level) return;
+  emu.ta_out ^= 1 << x;
+  pins_update();
+  if (shs_out[(ctl1 >> 10) & 3] == x && (level ^ ((ctl1 & ISSH) != 0))) {
+    adc_trigger();                     //Az SHI felfut le
+  }
+}
+
+static void ta_action(uint8_t x, uint8_t eq0) {  //A kimeneti egysg
+  uint8_t mode = (reg16[EMU_TACCTL0 + x] >> 5) & 7;
+  uint8_t out = (emu.ta_out >> x) & 1;
+  if (!eq0) {                          //EQUx: TAR = TACCRx
+    switch (mode) {
+    case 1: case 3: out = 1; break;
+    case 2: case 4: case 6: out ^= 1; break;
+    case 5: case 7: out = 0; break;
+    }
+  } else {                             //EQU0: TAR = TACCR0 (x = 1, 2)
+    switch (mode) {
+    case 2: case 3: out = 0; break;
+    case 6: case 7: out = 1; break;
+    }
+  }
+  ta_set_out(x, out);
+}
+
+static uint8_t ta_cci_of(uint8_t x) {  //A CCIx bemenet pillanatnyi szintje
+  switch ((reg16[EMU_TACCTL0 + x] >> 12) & 3) {
+  case 0:                              //CCI0A = P1.1, CCI1A = P1.2
+    return x == 2 ? 0 : (emu.pins >> (x + 1)) & 1;
+  case 1:                              //CCI0B, CCI2B = ACLK, CCI1B = CAOUT
+    return x == 1 ? 0 : aclk_level();
+  case 2:
+    return 0;                          //GND
+  default:
+    return 1;                          //VCC
+  }
+}
+
+static void ta_cci_update(void) {      //CCI bit s rgzts az leknl
+  uint16_t cctl;
+  uint8_t x, c, cm;
+  for (x = 0; x < 3; x++) {
+    c = ta_cci_of(x);
+    if (((emu.ta_cci >> x) & 1) == c) continue;
+    emu.ta_cci ^= 1 << x;
+    cctl = (reg16[EMU_TACCTL0 + x] & ~CCI) | (c ? CCI : 0);
+    cm = cctl >> 14;
+    if ((cctl & CAP) && ((c && (cm & 1)) || (!c && (cm & 2)))) {
+      hw16(EMU_TACCR0 + x, reg16[EMU_TAR]);
+      if (cctl & CCIFG) cctl |= COV;   //Az elz rtket nem olvastk ki
+      cctl |= CCIFG;
+    }
+    hw16(EMU_TACCTL0 + x, cctl);
+  }
+}
+
+static void ta_events(uint8_t wrapped) {  //TAR elrte egy esemny rtkt
+  uint16_t tar = reg16[EMU_TAR], cctl;
+  uint8_t x;
+  if (wrapped) hw16(EMU_TACTL, reg16[EMU_TACTL] | TAIFG);
+  for (x = 0; x < 3; x++) {
+    cctl = reg16[EMU_TACCTL0 + x];
+    if ((cctl & CAP) || tar != reg16[EMU_TACCR0 + x]) continue;
+    cctl = (cctl & ~SCCI) | CCIFG | (((emu.ta_cci >> x) & 1) ? SCCI : 0);
+    hw16(EMU_TACCTL0 + x, cctl);       //SCCI: a CCI trolt rtke
+    ta_action(x, 0);
+  }
+  if (!(reg16[EMU_TACCTL0] & CAP) && tar == reg16[EMU_TACCR0]) {
+    ta_action(1, 1);
+    ta_action(2, 1);
+  }
+}
+
+static void ta_count(uint32_t n) {     //n ts, esemnyenknt
+  uint32_t d;
+  while (n) {
+    d = ta_min_dist();
+    if (n < d) {
+      ta_step(n);
+      return;
+    }
+    ta_events(ta_step(d));
+    n -= d;
+  }
+}
+
+static uint16_t ta_iv(void) {          //TAIV olvassa: a jelzbit trldik
+  static const uint8_t iv[2] = { 2, 4 };
+  uint16_t cctl;
+  uint8_t x;
+  for (x = 1; x < 3; x++) {
+    cctl = reg16[EMU_TACCTL0 + x];
+    if ((cctl & (CCIE | CCIFG)) == (CCIE | CCIFG)) {
+      hw16(EMU_TACCTL0 + x, cctl & ~CCIFG);
+      return iv[x - 1];
+    }
+  }
+  if ((reg16[EMU_TACTL] & (TAIE | TAIFG)) == (TAIE | TAIFG)) {
+    hw16(EMU_TACTL, reg16[EMU_TACTL] & ~TAIFG);
+    return 10;
+  }
+  return 0;
+}
+
+static uint8_t ta_need_aclk(void) {    //Rgzts az ACLK lein
+  uint8_t x;
+  uint16_t cctl;
+  for (x = 0; x < 3; x += 2) {
+    cctl = reg16[EMU_TACCTL0 + x];
+    if ((cctl & CAP) && (cctl & (CCIS_3)) == CCIS_1) return 1;
+  }
+  return 0;
+}
+
+/*-------------------------------------------------------------
+ * WDT+
+ *-------------------------------------------------------------*/
+static void wdt_config(void) {
+  static const uint16_t cnt[4] = { 32768, 8192, 512, 64 };
+  uint16_t ctl = reg16[EMU_WDTCTL];
+  if (ctl & WDTHOLD) {
+    emu.wdt_next = NEVER;
+    return;
+  }
+  emu.wdt_ps = ((ctl & WDTSSEL) ? emu.aclk_ps : emu.smclk_ps) * cnt[ctl & 3];
+  emu.wdt_next = emu.now + emu.wdt_ps;
+}
+
+static void wdt_expire(void) {
+  if (!(reg16[EMU_WDTCTL] & WDTTMSEL)) fail("PUC: lejart a watchdog");
+  hw8(EMU_IFG1, reg8[EMU_IFG1] | WDTIFG);
+  emu.wdt_next += emu.wdt_ps;
+}
+
+/*-------------------------------------------------------------
+ * A program ltal bert rtkek mellkhatsai
+ *-------------------------------------------------------------*/
+static void write16(uint8_t r, uint16_t o, uint16_t v) {
+  uint8_t x;
+  switch (r) {
+  case EMU_TACTL:
+    if (v & TACLR) {                   //TAR, oszt, irny trlse
+      v &= ~TACLR;
+      hw16(EMU_TAR, 0);
+      emu.ta_down = 0;
+      if (emu.ta_ps) emu.ta_next = emu.now + emu.ta_ps;
+    }
+    hw16(r, v);
+    break;
+  case EMU_TACCTL0: case EMU_TACCTL1: case EMU_TACCTL2:
+    x = r - EMU_TACCTL0;
+    hw16(r, (v & ~CCI) | (o & CCI));   //CCI csak olvashat
+    if (!(v & (7 << 5))) ta_set_out(x, (v & OUT) != 0);  //OUTMOD_0
+    ta_cci_update();                   //CCIS vlts: szoftveres rgzts
+    break;
+  case EMU_TAIV: case EMU_ADC10MEM:
+    hw16(r, o);                        //Csak olvashat
+    break;
+  case EMU_ADC10CTL0:
+    hw16(r, v & ~ADC10SC);             //ADC10SC magtl trldik
+    if (!(v & ADC10ON)) {
+      adc_stop();
+    } else if ((o & ENC) && !(v & ENC) && !(reg16[EMU_ADC10CTL1] & CONSEQ_3)) {
+      adc_stop();                      //CONSEQ_0: azonnali lells
+    }
+    if ((v & ADC10SC) && (v & ENC) && !(reg16[EMU_ADC10CTL1] & SHS_3)) {
+      adc_trigger();
+    }
+    break;
+  case EMU_ADC10CTL1:
+    hw16(r, (v & ~BUSY) | (emu.adc_busy ? BUSY : 0));
+    break;
+  case EMU_WDTCTL:
+    if ((v & 0xFF00) != WDTPW) fail("PUC: WDTCTL jelszohiba (0x%04X)", v);
+    hw16(r, 0x6900 | (v & 0xFF & ~WDTCNTCL));  //Olvasva 0x69, CNTCL = 0
+    wdt_config();
+    break;
+  default:
+    hw16(r, v);
+  }
+}
+
+static void write8(uint8_t r, uint8_t o, uint8_t v) {
+  switch (r) {
+  case EMU_P1OUT: case EMU_P1DIR: case EMU_P1SEL: case EMU_P1SEL2:
+  case EMU_P1REN:
+    hw8(r, v);
+    pins_update();
+    break;
+  case EMU_ADC10DTC0:
+    hw8(r, (v & ~ADC10B1) | (o & ADC10B1));
+    break;
+  case EMU_ADC10DTC1:
+    hw8(r, v);
+    if (!v) emu.dtc_on = 0;
+    break;
+  case EMU_DCOCTL: case EMU_BCSCTL1: case EMU_BCSCTL2: case EMU_BCSCTL3:
+    hw8(r, v);
+    clk_update();
+    break;
+  case EMU_P1IN:
+  case EMU_CALDCO_16MHZ: case EMU_CALBC1_16MHZ: case EMU_CALDCO_12MHZ:
+  case EMU_CALBC1_12MHZ: case EMU_CALDCO_8MHZ: case EMU_CALBC1_8MHZ:
+  case EMU_CALDCO_1MHZ: case EMU_CALBC1_1MHZ:
+    hw8(r, o);                         //Csak olvashat
+    break;
+  default:
+    hw8(r, v);
+  }
+}
+
+static void sync(void) {
+  uint8_t r;
+  if (memcmp(reg16, old16, sizeof(reg16)) || memcmp(reg8, old8, sizeof(reg8))) {
+    for (r = 0; r < EMU_N16; r++) {
+      if (reg16[r] != old16[r]) write16(r, old16[r], reg16[r]);
+    }
+    for (r = 0; r < EMU_N8; r++) {
+      if (reg8[r] != old8[r]) write8(r, old8[r], reg8[r]);
+    }
+  }
+  if (emu.dtc_arm) {                   //ADC10SA rsa indtja a DTC-t
+    emu.dtc_arm = 0;
+    dtc_start();
+  }
+}
+
+/*-------------------------------------------------------------
+ * Esemnyhurok
+ *-------------------------------------------------------------*/
+static uint64_t next_event(void) {
+  uint64_t t = NEVER, te, half;
+  ta_check();
+  if (emu.ta_ps) {
+    t = emu.ta_next + (ta_min_dist() - 1) * emu.ta_ps;
+  }
+  if (ta_need_aclk()) {
+    half = emu.aclk_ps / 2;
+    te = (emu.now / half + 1) * half;
+    if (te < t) t = te;
+  }
+  te = rx_next();
+  if (te < t) t = te;
+  if (emu.adc_busy && emu.adc_done < t) t = emu.adc_done;
+  if (emu.wdt_next < t) t = emu.wdt_next;
+  return t;
+}
+
+static void step_to(uint64_t t) {
+  uint64_t n;
+  uint8_t last = 0;
+  if (t >= emu.limit) {
+    t = emu.limit;
+    last = 1;
+  }
+  if (!(emu.sr & CPUOFF)) {
+    emu.t_act += t - emu.now;
+    emu.q_act += (t - emu.now) * I_AM_UA_MHZ * emu.mclk_hz / 1e6;
+  }
+  else if (emu.sr & SCG1) emu.t_lpm3 += t - emu.now;
+  else emu.t_lpm0 += t - emu.now;
+  if (emu.adc_busy) emu.t_adc += t - emu.now;
+  if (reg16[EMU_ADC10CTL0] & REFON) emu.t_ref += t - emu.now;
+  emu.now = t;
+  if (emu.ta_next <= t) {
+    n = (t - emu.ta_next) / emu.ta_ps + 1;
+    emu.ta_next += n * emu.ta_ps;
+    ta_count((uint32_t)n);
+  }
+  if (emu.rx) pins_update();           //RXD l
+  ta_cci_update();                     //ACLK l
+  if (emu.adc_busy && emu.adc_done <= t) adc_done();
+  if (emu.wdt_next <= t) wdt_expire();
+  if (last) emu_finish(0);
+}
+
+static int irq_pending(void) {         //A legmagasabb priorits krs
+  uint8_t x;
+  if ((reg8[EMU_IFG1] & WDTIFG) && (reg8[EMU_IE1] & WDTIE)) return WDT_VECTOR / 2;
+  if ((reg16[EMU_TACCTL0] & (CCIE | CCIFG)) == (CCIE | CCIFG)) return TIMER0_A0_VECTOR / 2;
+  for (x = 1; x < 3; x++) {
+    if ((reg16[EMU_TACCTL0 + x] & (CCIE | CCIFG)) == (CCIE | CCIFG)) return TIMER0_A1_VECTOR / 2;
+  }
+  if ((reg16[EMU_TACTL] & (TAIE | TAIFG)) == (TAIE | TAIFG)) return TIMER0_A1_VECTOR / 2;
+  if ((reg16[EMU_ADC10CTL0] & (ADC10IE | ADC10IFG)) == (ADC10IE | ADC10IFG)) return ADC10_VECTOR / 2;
+  return -1;
+}
+
+static void irq(void) {
+  uint64_t t0;
+  int v;
+  while ((emu.sr & GIE) && (v = irq_pending()) >= 0) {
+    switch (v) {                       //Egyforrs krs: a jelzbit trldik
+    case WDT_VECTOR / 2:
+      hw8(EMU_IFG1, reg8[EMU_IFG1] & ~WDTIFG);
+      break;
+    case TIMER0_A0_VECTOR / 2:
+      hw16(EMU_TACCTL0, reg16[EMU_TACCTL0] & ~CCIFG);
+      break;
+    case ADC10_VECTOR / 2:
+      hw16(EMU_ADC10CTL0, reg16[EMU_ADC10CTL0] & ~ADC10IFG);
+      break;
+    }
+    if (!vectors[v]) fail("nincs kiszolgalo: %s_VECTOR", vec_name[v]);
+    if (emu.depth >= ISR_DEPTH) fail("tul melyen egymasba agyazott megszakitasok");
+    emu.n_irq[v]++;
+    t0 = emu.now;
+    emu.sr_stack[emu.depth++] = emu.sr;
+    emu.sr &= SCG0;                    //GIE = 0, a CPU fut
+    run(emu.now + ISR_ENTRY * emu.mclk_ps);
+    vectors[v]();
+    sync();
+    run(emu.now + ISR_RETI * emu.mclk_ps);
+    emu.sr = emu.sr_stack[--emu.depth];
+    emu.isr_ps += emu.now - t0;
+  }
+}
+
+/*-------------------------------------------------------------
+ * Futs aktv CPU-val t_end-ig. A kzben lefut megszaktsok
+ * ideje nem a fprogramtl megy el (kslelteti t_end-et).
+ *-------------------------------------------------------------*/
+static void run(uint64_t t_end) {
+  uint64_t isr0 = emu.isr_ps, end, t;
+  irq();
+  for (;;) {
+    end = t_end + (emu.isr_ps - isr0);
+    if (emu.now >= end) break;
+    t = next_event();
+    step_to(t < end ? t : end);
+    irq();
+  }
+}
+
+static void cycles(unsigned long n) {
+  sync();
+  run(emu.now + n * emu.mclk_ps);
+}
+
+/*-------------------------------------------------------------
+ * Regiszterelrs (emu/io430.h)
+ *-------------------------------------------------------------*/
+volatile uint16_t *emu_reg16(uint8_t r) {
+  cycles(EMU_ACCESS_CYCLES);
+  if (r == EMU_TAIV) hw16(r, ta_iv());
+  if (r == EMU_ADC10SA) emu.dtc_arm = 1;
+  return &reg16[r];
+}
+
+volatile uint8_t *emu_reg8(uint8_t r) {
+  cycles(EMU_ACCESS_CYCLES);
+  if (r == EMU_P1IN) hw8(r, emu.pins & ~reg8[EMU_ADC10AE0]);
+  return &reg8[r];
+}
+
+void emu_vector(unsigned vec, void (*isr)(void)) {
+  vectors[(vec / 2) & 15] = isr;
+}
+
+/*-------------------------------------------------------------
+ * Beptett fggvnyek
+ *-------------------------------------------------------------*/
+void __delay_cycles(unsigned long n) {
+  cycles(n);
+}
+
+void __no_operation(void) {
+  cycles(1);
+}
+
+void __enable_interrupt(void) {
+  sync();
+  emu.sr |= GIE;
+  irq();
+}
+
+void __disable_interrupt(void) {
+  sync();
+  emu.sr &= ~GIE;
+}
+
+unsigned short __get_interrupt_state(void) {
+  return emu.sr & GIE;
+}
+
+void __set_interrupt_state(unsigned short s) {
+  sync();
+  emu.sr = (emu.sr & ~GIE) | (s & GIE);
+  irq();
+}
+
+void __bis_SR_register(unsigned short bits) {
+  uint64_t t;
+  sync();
+  emu.sr |= bits;
+  irq();
+  while (emu.sr & CPUOFF) {            //Alvs: csak a perifrik jrnak
+    t = next_event();
+    step_to(t == NEVER ? emu.limit : t);
+    irq();
+  }
+}
+
+void __bic_SR_register_on_exit(unsigned short bits) {
+  sync();
+  if (emu.depth == 1 && (emu.sr_stack[0] & bits & CPUOFF)) emu.n_wake++;
+  if (emu.depth) emu.sr_stack[emu.depth - 1] &= ~bits;
+}
+
+/*-------------------------------------------------------------
+ * Indts: a regiszterek bekapcsolsi rtke, TLV
+ *-------------------------------------------------------------*/
+static void tlv_init(void) {
+  uint16_t w[8], chk;
+  double t30, t85;
+  uint8_t i;
+  t30 = (0.00355 * 30 + 0.986) * 1023 / 1.5;  //A bels hmr kdjai
+  t85 = (0.00355 * 85 + 0.986) * 1023 / 1.5;
+  w[0] = 0x8000;                       //Ersts: 1,0
+  w[1] = 0;                            //Ofszet
+  w[2] = 0x8000;                       //1,5 V-os referencia: pontos
+  w[3] = (uint16_t)(t30 + 0.5);
+  w[4] = (uint16_t)(t85 + 0.5);
+  w[5] = 0x8000;                       //2,5 V-os referencia: pontos
+  w[6] = (uint16_t)(t30 * 1.5 / 2.5 + 0.5);
+  w[7] = (uint16_t)(t85 * 1.5 / 2.5 + 0.5);
+  memset(emu_tlv, 0xFF, sizeof(emu_tlv));
+  emu_tlv[2] = 0x10;                   //ADC10 kalibrci, 16 bjt
+  emu_tlv[3] = 16;
+  for (i = 0; i < 8; i++) {
+    emu_tlv[4 + 2*i] = w[i] & 0xFF;
+    emu_tlv[5 + 2*i] = w[i] >> 8;
+  }
+  emu_tlv[20] = 0xFE;                  //res terlet a vgig
+  emu_tlv[21] = sizeof(emu_tlv) - 22;
+  chk = 0;
+  for (i = 2; i < sizeof(emu_tlv); i += 2) chk ^= emu_tlv[i] | (emu_tlv[i+1] << 8);
+  chk = -chk;
+  emu_tlv[0] = chk & 0xFF;
+  emu_tlv[1] = chk >> 8;
+}
+
+/**------------------------------------------------------------
+ * Az emultor indtsa (a mintaprogram main() hvsa eltt)
+ *-------------------------------------------------------------
+ * stack_top - egy helyi vltoz cme a hvban: a veremben lev
+ *             DTC bufferek cmnek visszakpzshez
+ */
+void emu_start(void *stack_top) {
+  uint8_t i;
+  emu.data_lo = (uintptr_t)__data_start;
+  emu.data_hi = (uintptr_t)_end;
+  emu.stack_top = (uintptr_t)stack_top;
+  emu.limit = (uint64_t)(emu_cfg.t_end * PS_PER_S);
+  emu.bit_ps = ps_of(emu_cfg.baud);
+  emu.rng = emu_cfg.seed ? emu_cfg.seed : 1;
+  if (emu_cfg.rx_text) {
+    emu.rx = emu_cfg.rx_text;
+    emu.rx_len = strlen(emu_cfg.rx_text);
+    emu.rx_t0 = (uint64_t)(emu_cfg.rx_at * PS_PER_S);
+  }
+  tlv_init();
+  reg16[EMU_WDTCTL] = 0x6900;          //Bekapcsolskor a watchdog jr
+  reg8[EMU_BCSCTL1] = 0x87;
+  reg8[EMU_DCOCTL] = 0x60;
+  reg8[EMU_BCSCTL3] = 0x05;
+  for (i = 0; i < 4; i++) {
+    reg8[EMU_CALBC1_1MHZ - 2*i] = dco_cal[i].bc1;
+    reg8[EMU_CALDCO_1MHZ - 2*i] = dco_cal[i].dco;
+  }
+  memcpy(old16, reg16, sizeof(reg16));
+  memcpy(old8, reg8, sizeof(reg8));
+  clk_update();
+  wdt_config();
+  emu.ta_next = NEVER;
+  emu.wdt_next = emu.now + emu.wdt_ps;
+  emu.pins = pins_compute();
+  emu.ux_level = (emu.pins >> 1) & 1;
+  for (i = 0; i < 3; i++) emu.ta_cci |= ta_cci_of(i) << i;
+  clock_gettime(CLOCK_MONOTONIC, &emu.host0);
+}
+
+/**------------------------------------------------------------
+ * A futs vge: UART kimenet lezrsa, sszests, kilps
+ *-------------------------------------------------------------
+ * code - kilpsi kd (0: rendben, 2: a program hibt okozott)
+ */
+void emu_finish(int code) {
+  struct timespec t1;
+  double vt, ht, all;
+  uint32_t n;
+  uint8_t b, v;
+  if (emu.finished) exit(code);
+  emu.finished = 1;
+  uart_feed(emu.now, emu.ux_level);
+  emu.ux_busy = 0;                     //A flbeszakadt keret nem hiba
+  fflush(stdout);
+  if (emu_cfg.quiet) exit(code);
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  vt = emu.now / PS_PER_S;
+  ht = (t1.tv_sec - emu.host0.tv_sec) + (t1.tv_nsec - emu.host0.tv_nsec) * 1e-9;
+  all = emu.now ? (double)emu.now : 1.0;
+  fprintf(stderr, "emu: %.3f s virtualis ido, %.3f s futasido (%.0fx)\n",
+          vt, ht, ht > 0 ? vt / ht : 0.0);
+  fprintf(stderr, "emu: MCLK %.3f MHz, CPU aktiv %.1f%%, LPM0 %.1f%%, LPM3 %.1f%%\n",
+          emu.mclk_hz / 1e6, 100 * emu.t_act / all, 100 * emu.t_lpm0 / all,
+          100 * emu.t_lpm3 / all);
+  for (v = 0, n = 0; v < 16; v++) n += emu.n_irq[v];
+  fprintf(stderr, "emu: megszakitas %.1f/s, ebredes (LPM -> foprogram) %.1f/s\n",
+          n / (all / PS_PER_S), emu.n_wake / (all / PS_PER_S));
+  fprintf(stderr, "emu: atlagos aram kb. %.1f uA (adatlapi tipikus ertekek, ADC %.2f%%, REF %.2f%%)\n",
+          (emu.q_act + emu.t_lpm0 * I_LPM0_UA + emu.t_lpm3 * I_LPM3_UA
+           + emu.t_adc * I_ADC_UA + emu.t_ref * I_REF_UA) / all,
+          100 * emu.t_adc / all, 100 * emu.t_ref / all);
+  fprintf(stderr, "emu: ADC10 konverzio %lu, DTC atvitel %lu, elmaradt inditas %lu\n",
+          (unsigned long)emu.n_conv, (unsigned long)emu.n_dtc, (unsigned long)emu.n_miss);
+  fprintf(stderr, "emu: megszakitasok:");
+  for (v = 15; v > 0; v--) {
+    if (emu.n_irq[v]) fprintf(stderr, " %s %lu", vec_name[v], (unsigned long)emu.n_irq[v]);
+  }
+  fprintf(stderr, "\n");
+  if (emu.ux_frames || emu.ux_errors) {
+    fprintf(stderr, "emu: UART (P1.1) %lu karakter, %lu keretezesi hiba\n",
+            (unsigned long)emu.ux_frames, (unsigned long)emu.ux_errors);
+  }
+  for (b = 0; b < 8; b++) {            //A kimenetek kitltse
+    if (!(reg8[EMU_P1DIR] & (1 << b)) || !emu.pin_edges[b]) continue;
+    if (emu.pins & (1 << b)) emu.pin_high[b] += emu.now - emu.pin_t[b];
+    fprintf(stderr, "emu: P1.%u kitoltes %.2f%% (%lu el)\n", b,
+            100 * emu.pin_high[b] / all, (unsigned long)emu.pin_edges[b]);
+  }
+  exit(code);
+}
@@ -0,0 +1,74 @@
+/**********************************************************************
+ *  emu/emu.h
+ *
+ * Gazdagpes perifriaemultor a mintaprogramokhoz: ADC10 + DTC,
+ * Timer_A3, WDT+, P1 port s az rajelek modellje, virtulis idben.
+ * A mintaprogram main() s megszaktskiszolgl eljrsai
+ * vltozatlanul futnak (tools/emu_main.c), a vals idnl sokkal
+ * gyorsabban.
+ *
+ * Modellezett:
+ *  - rajelek: DCO a betlttt kalibrcis konstans szerint (1, 8, 12,
+ *    16 MHz), DIVM/DIVS, ACLK = VLO (vagy 32768 Hz-es kristly), DIVA
+ *  - Timer_A: felfel, folytonos s fel-le md, komparls s
+ *    rgzts (CCI0B/CCI2B = ACLK, CCI1A = P1.2, GND/VCC), OUTMOD_0-7,
+ *    TAIV, az OUT0/OUT1/OUT2 felfut le indthatja az ADC-t
+ *  - ADC10: CONSEQ_0-3, MSC, SHT, ADC10DIV, ADC10SSEL, ADC10DF, ISSH,
+ *    referencik (VCC, 1,5/2,5 V, VeREF+ = A4, VeREF- = A3), bels
+ *    hmr (A10) s VCC/2 (A11); az ENC trlse CONSEQ_0 mellett
+ *    azonnal lellt, egybknt az ppen fut konverzi vgn
+ *  - DTC: egy- s ktblokkos md, folyamatos tvitel, ADC10B1
+ *  - WDT+: intervallum md (WDTIFG), watchdog mdban a lejrat PUC
+ *  - LPM0/LPM3: LPM3-ban az SMCLK (s az arrl jr Timer_A) ll
+ *  - ramfelvtel: becsls az zemmdok, az ADC konverzik s a bels
+ *    referencia idejbl, az adatlap tipikus rtkeivel (3 V)
+ *  - P1: a TXD lb (P1.1) jelt UART-knt dekdoljuk (szabvnyos
+ *    kimenet), az RXD lbra (P1.2) szveget kldhetnk
+ *
+ * A CPU utastsok ideje nincs modellezve: az id a regiszter-
+ * elrsekkel (EMU_ACCESS_CYCLES), a megszaktsok be- s kilpsvel
+ * s a __delay_cycles() hvsokkal telik. A perifrik idztse (a
+ * mintavtel teme, a DTC blokkok, a PWM, a UART bitidk) pontos, a
+ * szmtsok ideje nem: a futsid mrshez a bench (mspdebug sim)
+ * val. Nincs USCI, Comparator_A s P1/P2 megszakts.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef EMU_H
+#define EMU_H
+
+#include <stdint.h>
+
+#define EMU_NCHAN       16             //Az ADC10 csatorni (INCH)
+
+//--- Egy analg bemenet jelalakja ------------------------------------
+enum { EMU_IN_CONST, EMU_IN_RAMP, EMU_IN_SINE };
+
+typedef struct {
+  uint8_t kind;                        //EMU_IN_CONST, _RAMP vagy _SINE
+  double a, b, c;                      //mV, mV, s vagy Hz (lsd emu_main.c)
+} emu_input_t;
+
+//--- A futs belltsai (az emu_start() eltt kell kitlteni) --------
+typedef struct {
+  double t_end;                        //A futs hossza (virtulis s)
+  double vcc;                          //Tpfeszltsg (mV)
+  double temp;                         //A chip hmrsklete (C)
+  double noise;                        //Az analg bemenetek zaja (mV, RMS)
+  double vlo;                          //A VLO frekvencija (Hz)
+  uint8_t xtal;                        //1: 32768 Hz-es kristly az LFXT1-en
+  uint32_t baud;                       //A TXD/RXD dekdols sebessge
+  uint32_t seed;                       //A zajgenertor kezdrtke
+  const char *rx_text;                 //Az RXD lbra kldtt szveg (vagy 0)
+  double rx_at;                        //A klds kezdete (s)
+  uint8_t quiet;                       //1: nincs sszests a vgn
+  emu_input_t in[EMU_NCHAN];           //Az analg bemenetek
+} emu_cfg_t;
+
+extern emu_cfg_t emu_cfg;
+
+void emu_start(void *stack_top);
+void emu_finish(int code);
+
+#endif
@@ -0,0 +1,340 @@
+/**********************************************************************
+ *  emu/io430.h
+ *
+ * Az IAR io430.h helyettestje a gazdagpes emultorhoz (emu.c).
+ * Csak az emullt (EMU_HOST) fordtsnl van az include tvonalon a
+ * common knyvtr eltt (CMake: <minta>-emu programok).
+ *
+ * Minden regiszter egy fggvnyhvs: az emu_reg16()/emu_reg8() elbb
+ * feldolgozza az elz elrs ta bert rtkeket (ADC10SC, ENC,
+ * TACLR, P1OUT stb.), majd EMU_ACCESS_CYCLES rajellel lpteti a
+ * virtulis idt, s csak utna adja vissza a regiszter cmt. gy a
+ * "while (ADC10CTL1 & BUSY);" tpus vrakozsok is vget rnek, a
+ * megszaktsok pedig a regiszterelrsek s a beptett fggvnyek
+ * (__delay_cycles, __low_power_mode_x) kztt futnak le.
+ *
+ * A bitdefincik rtkei megegyeznek a gyriakkal (SLAU144).
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef EMU_IO430_H
+#define EMU_IO430_H
+
+#include <stdint.h>
+
+#define EMU_ACCESS_CYCLES  4           //Egy regiszterelrs ideje (MCLK)
+
+//--- A bit banging UART bitenknti sajt ideje az emultorban: a
+//--- TXBIT kt P1OUT elrse (sw_uart.c), gy a bitidk pontosak
+#define SW_UART_LOOP_CYCLES  (2 * EMU_ACCESS_CYCLES)
+
+//--- A gyri kalibrcis adatok (TLV) emullt pldnya (emu.c) --------
+extern uint8_t emu_tlv[64];
+#define CALIB_TLV_ADDR  emu_tlv
+
+//--- A regiszterek sorszmai -----------------------------------------
+enum {
+  EMU_TACTL, EMU_TAR, EMU_TACCTL0, EMU_TACCTL1, EMU_TACCTL2,
+  EMU_TACCR0, EMU_TACCR1, EMU_TACCR2, EMU_TAIV,
+  EMU_ADC10CTL0, EMU_ADC10CTL1, EMU_ADC10MEM, EMU_ADC10SA, EMU_WDTCTL,
+  EMU_N16
+};
+enum {
+  EMU_P1IN, EMU_P1OUT, EMU_P1DIR, EMU_P1IFG, EMU_P1IES, EMU_P1IE,
+  EMU_P1SEL, EMU_P1SEL2, EMU_P1REN, EMU_ADC10AE0, EMU_ADC10DTC0,
+  EMU_ADC10DTC1, EMU_DCOCTL, EMU_BCSCTL1, EMU_BCSCTL2, EMU_BCSCTL3,
+  EMU_IE1, EMU_IFG1,
+  EMU_CALDCO_16MHZ, EMU_CALBC1_16MHZ, EMU_CALDCO_12MHZ, EMU_CALBC1_12MHZ,
+  EMU_CALDCO_8MHZ, EMU_CALBC1_8MHZ, EMU_CALDCO_1MHZ, EMU_CALBC1_1MHZ,
+  EMU_N8
+};
+
+volatile uint16_t *emu_reg16(uint8_t r);
+volatile uint8_t *emu_reg8(uint8_t r);
+
+//--- Timer_A ---------------------------------------------------------
+#define TACTL         (*emu_reg16(EMU_TACTL))
+#define TAR           (*emu_reg16(EMU_TAR))
+#define TACCTL0       (*emu_reg16(EMU_TACCTL0))
+#define TACCTL1       (*emu_reg16(EMU_TACCTL1))
+#define TACCTL2       (*emu_reg16(EMU_TACCTL2))
+#define TACCR0        (*emu_reg16(EMU_TACCR0))
+#define TACCR1        (*emu_reg16(EMU_TACCR1))
+#define TACCR2        (*emu_reg16(EMU_TACCR2))
+#define TAIV          (*emu_reg16(EMU_TAIV))
+#define TA0CTL        TACTL
+#define TA0R          TAR
+#define TA0CCTL0      TACCTL0
+#define TA0CCTL1      TACCTL1
+#define TA0CCTL2      TACCTL2
+#define TA0CCR0       TACCR0
+#define TA0CCR1       TACCR1
+#define TA0CCR2       TACCR2
+#define TA0IV         TAIV
+#define CCTL0         TACCTL0
+#define CCTL1         TACCTL1
+#define CCTL2         TACCTL2
+#define CCR0          TACCR0
+#define CCR1          TACCR1
+#define CCR2          TACCR2
+
+//--- ADC10 -----------------------------------------------------------
+#define ADC10CTL0     (*emu_reg16(EMU_ADC10CTL0))
+#define ADC10CTL1     (*emu_reg16(EMU_ADC10CTL1))
+#define ADC10MEM      (*emu_reg16(EMU_ADC10MEM))
+#define ADC10SA       (*emu_reg16(EMU_ADC10SA))
+#define ADC10AE0      (*emu_reg8(EMU_ADC10AE0))
+#define ADC10DTC0     (*emu_reg8(EMU_ADC10DTC0))
+#define ADC10DTC1     (*emu_reg8(EMU_ADC10DTC1))
+
+//--- Watchdog, port, rajel, megszakts engedlyezs ----------------
+#define WDTCTL        (*emu_reg16(EMU_WDTCTL))
+#define P1IN          (*emu_reg8(EMU_P1IN))
+#define P1OUT         (*emu_reg8(EMU_P1OUT))
+#define P1DIR         (*emu_reg8(EMU_P1DIR))
+#define P1IFG         (*emu_reg8(EMU_P1IFG))
+#define P1IES         (*emu_reg8(EMU_P1IES))
+#define P1IE          (*emu_reg8(EMU_P1IE))
+#define P1SEL         (*emu_reg8(EMU_P1SEL))
+#define P1SEL2        (*emu_reg8(EMU_P1SEL2))
+#define P1REN         (*emu_reg8(EMU_P1REN))
+#define DCOCTL        (*emu_reg8(EMU_DCOCTL))
+#define BCSCTL1       (*emu_reg8(EMU_BCSCTL1))
+#define BCSCTL2       (*emu_reg8(EMU_BCSCTL2))
+#define BCSCTL3       (*emu_reg8(EMU_BCSCTL3))
+#define IE1           (*emu_reg8(EMU_IE1))
+#define IFG1          (*emu_reg8(EMU_IFG1))
+#define CALDCO_16MHZ  (*emu_reg8(EMU_CALDCO_16MHZ))
+#define CALBC1_16MHZ  (*emu_reg8(EMU_CALBC1_16MHZ))
+#define CALDCO_12MHZ  (*emu_reg8(EMU_CALDCO_12MHZ))
+#define CALBC1_12MHZ  (*emu_reg8(EMU_CALBC1_12MHZ))
+#define CALDCO_8MHZ   (*emu_reg8(EMU_CALDCO_8MHZ))
+#define CALBC1_8MHZ   (*emu_reg8(EMU_CALBC1_8MHZ))
+#define CALDCO_1MHZ   (*emu_reg8(EMU_CALDCO_1MHZ))
+#define CALBC1_1MHZ   (*emu_reg8(EMU_CALBC1_1MHZ))
+
+//--- Bitek -----------------------------------------------------------
+#define BIT0          0x0001
+#define BIT1          0x0002
+#define BIT2          0x0004
+#define BIT3          0x0008
+#define BIT4          0x0010
+#define BIT5          0x0020
+#define BIT6          0x0040
+#define BIT7          0x0080
+#define BIT8          0x0100
+#define BIT9          0x0200
+#define BITA          0x0400
+#define BITB          0x0800
+#define BITC          0x1000
+#define BITD          0x2000
+#define BITE          0x4000
+#define BITF          0x8000
+
+//--- Sttuszregiszter ------------------------------------------------
+#define GIE           0x0008
+#define CPUOFF        0x0010
+#define OSCOFF        0x0020
+#define SCG0          0x0040
+#define SCG1          0x0080
+#define LPM0_bits     (CPUOFF)
+#define LPM1_bits     (SCG0 + CPUOFF)
+#define LPM2_bits     (SCG1 + CPUOFF)
+#define LPM3_bits     (SCG1 + SCG0 + CPUOFF)
+#define LPM4_bits     (SCG1 + SCG0 + OSCOFF + CPUOFF)
+
+//--- TACTL -----------------------------------------------------------
+#define TASSEL_0      (0 << 8)         //TACLK
+#define TASSEL_1      (1 << 8)         //ACLK
+#define TASSEL_2      (2 << 8)         //SMCLK
+#define TASSEL_3      (3 << 8)         //INCLK
+#define ID_0          (0 << 6)
+#define ID_1          (1 << 6)
+#define ID_2          (2 << 6)
+#define ID_3          (3 << 6)
+#define MC_0          (0 << 4)         //ll
+#define MC_1          (1 << 4)         //Felfel (TACCR0-ig)
+#define MC_2          (2 << 4)         //Folytonos
+#define MC_3          (3 << 4)         //Fel-le
+#define TACLR         0x0004
+#define TAIE          0x0002
+#define TAIFG         0x0001
+
+//--- TACCTLx ---------------------------------------------------------
+#define CM_0          (0 << 14)
+#define CM_1          (1 << 14)        //Felfut l
+#define CM_2          (2 << 14)        //Lefut l
+#define CM_3          (3 << 14)        //Mindkt l
+#define CCIS_0        (0 << 12)        //CCIxA
+#define CCIS_1        (1 << 12)        //CCIxB
+#define CCIS_2        (2 << 12)        //GND
+#define CCIS_3        (3 << 12)        //VCC
+#define SCS           0x0800
+#define SCCI          0x0400
+#define CAP           0x0100
+#define OUTMOD_0      (0 << 5)
+#define OUTMOD_1      (1 << 5)
+#define OUTMOD_2      (2 << 5)
+#define OUTMOD_3      (3 << 5)
+#define OUTMOD_4      (4 << 5)
+#define OUTMOD_5      (5 << 5)
+#define OUTMOD_6      (6 << 5)
+#define OUTMOD_7      (7 << 5)
+#define CCIE          0x0010
+#define CCI           0x0008
+#define OUT           0x0004
+#define COV           0x0002
+#define CCIFG         0x0001
+
+//--- ADC10CTL0 -------------------------------------------------------
+#define SREF_0        (0 << 13)        //VR+ = AVCC, VR- = AVSS
+#define SREF_1        (1 << 13)        //VR+ = VREF+
+#define SREF_2        (2 << 13)        //VR+ = VeREF+
+#define SREF_3        (3 << 13)
+#define SREF_4        (4 << 13)        //VR- = VREF-/VeREF-
+#define SREF_5        (5 << 13)
+#define SREF_6        (6 << 13)
+#define SREF_7        (7 << 13)
+#define ADC10SHT_0    (0 << 11)        //4 ADC10CLK
+#define ADC10SHT_1    (1 << 11)        //8 ADC10CLK
+#define ADC10SHT_2    (2 << 11)        //16 ADC10CLK
+#define ADC10SHT_3    (3 << 11)        //64 ADC10CLK
+#define ADC10SR       0x0400
+#define REFOUT        0x0200
+#define REFBURST      0x0100
+#define MSC           0x0080
+#define REF2_5V       0x0040
+#define REFON         0x0020
+#define ADC10ON       0x0010
+#define ADC10IE       0x0008
+#define ADC10IFG      0x0004
+#define ENC           0x0002
+#define ADC10SC       0x0001
+
+//--- ADC10CTL1 -------------------------------------------------------
+#define INCH_0        (0 << 12)
+#define INCH_1        (1 << 12)
+#define INCH_2        (2 << 12)
+#define INCH_3        (3 << 12)
+#define INCH_4        (4 << 12)
+#define INCH_5        (5 << 12)
+#define INCH_6        (6 << 12)
+#define INCH_7        (7 << 12)
+#define INCH_8        (8 << 12)
+#define INCH_9        (9 << 12)
+#define INCH_10       (10 << 12)       //Bels hmr
+#define INCH_11       (11 << 12)       //(VCC - VSS) / 2
+#define INCH_12       (12 << 12)
+#define INCH_13       (13 << 12)
+#define INCH_14       (14 << 12)
+#define INCH_15       (15 << 12)
+#define SHS_0         (0 << 10)        //ADC10SC
+#define SHS_1         (1 << 10)        //TA OUT1
+#define SHS_2         (2 << 10)        //TA OUT0
+#define SHS_3         (3 << 10)        //TA OUT2
+#define ADC10DF       0x0200
+#define ISSH          0x0100
+#define ADC10DIV_0    (0 << 5)
+#define ADC10DIV_1    (1 << 5)
+#define ADC10DIV_2    (2 << 5)
+#define ADC10DIV_3    (3 << 5)
+#define ADC10DIV_4    (4 << 5)
+#define ADC10DIV_5    (5 << 5)
+#define ADC10DIV_6    (6 << 5)
+#define ADC10DIV_7    (7 << 5)
+#define ADC10SSEL_0   (0 << 3)         //ADC10OSC
+#define ADC10SSEL_1   (1 << 3)         //ACLK
+#define ADC10SSEL_2   (2 << 3)         //MCLK
+#define ADC10SSEL_3   (3 << 3)         //SMCLK
+#define CONSEQ_0      (0 << 1)
+#define CONSEQ_1      (1 << 1)
+#define CONSEQ_2      (2 << 1)
+#define CONSEQ_3      (3 << 1)
+#define ADC10BUSY     0x0001
+#define BUSY          ADC10BUSY
+
+//--- ADC10DTC0 -------------------------------------------------------
+#define ADC10TB       0x08
+#define ADC10CT       0x04
+#define ADC10B1       0x02
+#define ADC10FETCH    0x01
+
+//--- WDTCTL ----------------------------------------------------------
+#define WDTPW         0x5A00
+#define WDTHOLD       0x0080
+#define WDTNMIES      0x0040
+#define WDTNMI        0x0020
+#define WDTTMSEL      0x0010
+#define WDTCNTCL      0x0008
+#define WDTSSEL       0x0004
+#define WDTIS1        0x0002
+#define WDTIS0        0x0001
+#define WDT_MDLY_32   (WDTPW+WDTTMSEL+WDTCNTCL)
+#define WDT_MDLY_8    (WDTPW+WDTTMSEL+WDTCNTCL+WDTIS0)
+#define WDT_MDLY_0_5  (WDTPW+WDTTMSEL+WDTCNTCL+WDTIS1)
+#define WDT_MDLY_0_064 (WDTPW+WDTTMSEL+WDTCNTCL+WDTIS1+WDTIS0)
+#define WDT_ADLY_1000 (WDTPW+WDTTMSEL+WDTCNTCL+WDTSSEL)
+#define WDT_ADLY_250  (WDTPW+WDTTMSEL+WDTCNTCL+WDTSSEL+WDTIS0)
+#define WDT_ADLY_16   (WDTPW+WDTTMSEL+WDTCNTCL+WDTSSEL+WDTIS1)
+#define WDT_ADLY_1_9  (WDTPW+WDTTMSEL+WDTCNTCL+WDTSSEL+WDTIS1+WDTIS0)
+#define WDT_MRST_32   (WDTPW+WDTCNTCL)
+#define WDT_ARST_1000 (WDTPW+WDTCNTCL+WDTSSEL)
+
+//--- IE1, IFG1 -------------------------------------------------------
+#define WDTIE         0x01
+#define WDTIFG        0x01
+
+//--- rajel modul ----------------------------------------------------
+#define XT2OFF        0x80
+#define DIVA_0        (0 << 4)
+#define DIVA_1        (1 << 4)
+#define DIVA_2        (2 << 4)
+#define DIVA_3        (3 << 4)
+#define DIVM_0        (0 << 4)
+#define DIVM_1        (1 << 4)
+#define DIVM_2        (2 << 4)
+#define DIVM_3        (3 << 4)
+#define DIVS_0        (0 << 1)
+#define DIVS_1        (1 << 1)
+#define DIVS_2        (2 << 1)
+#define DIVS_3        (3 << 1)
+#define LFXT1S_0      (0 << 4)         //32768 Hz kristly
+#define LFXT1S_2      (2 << 4)         //VLO
+#define LFXT1S_3      (3 << 4)
+#define XCAP_0        (0 << 2)
+#define XCAP_1        (1 << 2)
+#define XCAP_2        (2 << 2)
+#define XCAP_3        (3 << 2)
+
+//--- Megszaktsvektorok (a vektortbla szcme, mint az IAR-nl) ----
+#define PORT1_VECTOR       (2 * 2u)
+#define PORT2_VECTOR       (3 * 2u)
+#define ADC10_VECTOR       (5 * 2u)
+#define USCIAB0TX_VECTOR   (6 * 2u)
+#define USCIAB0RX_VECTOR   (7 * 2u)
+#define TIMER0_A1_VECTOR   (8 * 2u)
+#define TIMER0_A0_VECTOR   (9 * 2u)
+#define WDT_VECTOR         (10 * 2u)
+#define COMPARATORA_VECTOR (11 * 2u)
+#define NMI_VECTOR         (14 * 2u)
+#define TIMERA1_VECTOR     TIMER0_A1_VECTOR
+#define TIMERA0_VECTOR     TIMER0_A0_VECTOR
+
+void emu_vector(unsigned vec, void (*isr)(void));
+
+//--- Beptett fggvnyek --------------------------------------------
+void __delay_cycles(unsigned long n);
+void __enable_interrupt(void);
+void __disable_interrupt(void);
+void __no_operation(void);
+unsigned short __get_interrupt_state(void);
+void __set_interrupt_state(unsigned short s);
+void __bis_SR_register(unsigned short bits);
+void __bic_SR_register_on_exit(unsigned short bits);
+#define __low_power_mode_0()            __bis_SR_register(LPM0_bits + GIE)
+#define __low_power_mode_3()            __bis_SR_register(LPM3_bits + GIE)
+#define __low_power_mode_off_on_exit()  __bic_SR_register_on_exit(LPM4_bits)
+#define __even_in_range(x, y)           (x)
+
+#endif
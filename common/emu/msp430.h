@@ -0,0 +1,15 @@
+/**********************************************************************
+ *  emu/msp430.h
+ *
+ * Az msp430.h helyettestje a gazdagpes emultorhoz: a regiszterek
+ * s a beptett fggvnyek az emu/io430.h-ban vannak.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef EMU_MSP430_H
+#define EMU_MSP430_H
+
+#include "io430.h"
+
+#endif
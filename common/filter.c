@@ -0,0 +1,157 @@
+/**********************************************************************
+ *  filter.c
+ *
+ * Egsz aritmetikj szrk (mozgtlag, CIC, egyplus IIR).
+ * Oszts csak az inicializl eljrsokban fordul el.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "filter.h"
+
+/*-------------------------------------------------------------
+ * Normls elksztse: G-vel val oszts helyett ellptets
+ * (ps) s reciprok, ahol G >> ps <= 8. A szorzat gy 15 bites
+ * bemenetre sem csordul tl, 10 bites bemenetnl a hiba 1/4 LSB
+ * alatt marad.
+ *-------------------------------------------------------------*/
+static void norm_init(filt_norm_t *p_n, uint32_t g) {
+  uint8_t ps = 0;
+  while ((g >> ps) > 8) ps++;
+  p_n->ps = ps;
+  p_n->recip = (uint16_t)(((1UL << (16 + ps)) + g/2) / g);
+}
+
+static uint16_t norm_apply(const filt_norm_t *p_n, uint32_t x) {
+  if (p_n->ps) x += 1UL << (p_n->ps - 1);  //Kerekts az ellptetsnl
+  return (uint16_t)(((x >> p_n->ps) * p_n->recip + 0x8000) >> 16);
+}
+
+/**------------------------------------------------------------
+ * Mozgtlag inicializlsa (a buffer nullzdik)
+ *-------------------------------------------------------------
+ * p_f - a szr llapota
+ * pbuf - len elem buffer a mintk trolsra
+ * len - az tlagolt mintk szma (2 - 255)
+ */
+void filt_ma_init(filt_ma_t *p_f, uint16_t *pbuf, uint8_t len) {
+  uint8_t i;
+  for(i=0; i<len; i++) pbuf[i] = 0;
+  p_f->buf = pbuf;
+  p_f->sum = 0;
+  p_f->len = len;
+  p_f->idx = 0;
+  norm_init(&p_f->norm, len);
+}
+
+/**------------------------------------------------------------
+ * Egy minta a mozgtlagba, visszatrsi rtk az j tlag
+ * (az els len minta alatt a kimenet mg felfut)
+ *-------------------------------------------------------------*/
+uint16_t filt_ma_put(filt_ma_t *p_f, uint16_t x) {
+  p_f->sum += x;
+  p_f->sum -= p_f->buf[p_f->idx];      //A legrgebbi minta kiesik
+  p_f->buf[p_f->idx] = x;
+  if (++p_f->idx >= p_f->len) p_f->idx = 0;
+  return norm_apply(&p_f->norm, p_f->sum);
+}
+
+/**------------------------------------------------------------
+ * n minta a mozgtlagba, visszatrsi rtk az utols tlag
+ *-------------------------------------------------------------*/
+uint16_t filt_ma_block(filt_ma_t *p_f, const uint16_t *pbuf, uint8_t n) {
+  uint16_t y = 0;
+  while (n--) y = filt_ma_put(p_f, *pbuf++);
+  return y;
+}
+
+/**------------------------------------------------------------
+ * CIC decimtor inicializlsa
+ *-------------------------------------------------------------
+ * p_f - a szr llapota
+ * r - decimlsi arny (a kimenet fs/r tem), a hlzati zavar
+ *     kioltshoz r = FILT_MAINS_LEN(fs,50) vagy annak tbbszrse
+ */
+void filt_cic_init(filt_cic_t *p_f, uint8_t r) {
+  uint8_t i;
+  uint32_t g = 1;
+  for(i=0; i<FILT_CIC_ORDER; i++) {
+    p_f->integ[i] = 0;
+    p_f->comb[i] = 0;
+    g *= r;                            //Ersts: r^FILT_CIC_ORDER
+  }
+  p_f->r = r;
+  p_f->cnt = 0;
+  norm_init(&p_f->norm, g);
+}
+
+/**------------------------------------------------------------
+ * Egy minta a CIC szrbe
+ *-------------------------------------------------------------
+ * Visszatrsi rtk: 1, ha minden r-edik mintnl j kimenet
+ * kerlt *p_out-ba, egybknt 0. A tlcsorduls az integrtorokban
+ * megengedett, a fsszrk klnbsgkpzse korriglja.
+ */
+uint8_t filt_cic_put(filt_cic_t *p_f, uint16_t x, uint16_t *p_out) {
+  uint8_t i;
+  uint32_t y, t;
+  y = x;
+  for(i=0; i<FILT_CIC_ORDER; i++) {    //Integrtorok (fs temben)
+    p_f->integ[i] += y;
+    y = p_f->integ[i];
+  }
+  if (++p_f->cnt < p_f->r) return 0;
+  p_f->cnt = 0;
+  for(i=0; i<FILT_CIC_ORDER; i++) {    //Fsszrk (fs/r temben)
+    t = y;
+    y -= p_f->comb[i];
+    p_f->comb[i] = t;
+  }
+  *p_out = norm_apply(&p_f->norm, y);
+  return 1;
+}
+
+/**------------------------------------------------------------
+ * n minta a CIC szrbe, a kimenetek p_out-tl kezdve kerlnek
+ * trolsra. Visszatrsi rtk: a kimenetek szma.
+ *-------------------------------------------------------------*/
+uint8_t filt_cic_block(filt_cic_t *p_f, const uint16_t *pbuf, uint8_t n, uint16_t *p_out) {
+  uint8_t cnt = 0;
+  while (n--) {
+    if (filt_cic_put(p_f, *pbuf++, p_out)) {
+      p_out++;
+      cnt++;
+    }
+  }
+  return cnt;
+}
+
+/**------------------------------------------------------------
+ * Egyplus IIR szr inicializlsa
+ *-------------------------------------------------------------
+ * p_f - a szr llapota
+ * k - idlland 2^k mintban (1 - 16)
+ * x0 - a kimenet kezdrtke (pl. az els minta)
+ */
+void filt_iir_init(filt_iir_t *p_f, uint8_t k, uint16_t x0) {
+  p_f->k = k;
+  p_f->acc = (uint32_t)x0 << k;
+}
+
+/**------------------------------------------------------------
+ * Egy minta az IIR szrbe: acc += x - acc/2^k
+ *-------------------------------------------------------------*/
+uint16_t filt_iir_put(filt_iir_t *p_f, uint16_t x) {
+  p_f->acc -= p_f->acc >> p_f->k;
+  p_f->acc += x;
+  return (uint16_t)(p_f->acc >> p_f->k); //acc/2^k nyugalomban x s x+1 kztt
+}
+
+/**------------------------------------------------------------
+ * n minta az IIR szrbe, visszatrsi rtk az utols kimenet
+ *-------------------------------------------------------------*/
+uint16_t filt_iir_block(filt_iir_t *p_f, const uint16_t *pbuf, uint8_t n) {
+  uint16_t y = 0;
+  while (n--) y = filt_iir_put(p_f, *pbuf++);
+  return y;
+}
@@ -0,0 +1,75 @@
+/**********************************************************************
+ *  filter.h
+ *
+ * Egsz aritmetikj szrk mintavtelezett jelekhez:
+ *  - mozgtlag (MA): ha a hossza a hlzati peridus egsz
+ *    szm tbbszrse, az 50/60 Hz-es zavart s felharmonikusait
+ *    teljesen kioltja (pl. 500 Hz-es mintavtelnl 10 minta = 20 ms)
+ *  - CIC decimtor: FILT_CIC_ORDER darab egyms utni mozgsszeg,
+ *    R-szeres decimlssal, a zrushelyek R*k/fs-nl vannak
+ *  - egyplus IIR (exponencilis tlag): y += (x - y) / 2^k
+ *
+ * Minden szrnek van mintnknti (..._put) eljrsa, ez az ADC10
+ * megszaktsbl is hvhat, s blokkos (..._block) vltozata a DTC
+ * ltal megtlttt bufferekhez. A szrk llapota a hv ltal
+ * lefoglalt struktrban van (MA: 8 bjt + 2*len bjt buffer,
+ * CIC: 8*FILT_CIC_ORDER + 6 bjt, IIR: 6 bjt).
+ *
+ * A CIC integrtorai 32 bitesek: 15 + FILT_CIC_ORDER*log2(R) <= 32.
+ * A bemenet legfeljebb 15 bites lehet (pl. 10 bites ADC kd, vagy
+ * a decimate() eredmnye), a kimenet a bemenettel azonos sklj.
+ * A nem 2 hatvny ersts normlst az inicializlskor kiszmolt
+ * reciprokkal vgezzk, mintnknt nincs oszts.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef FILTER_H
+#define FILTER_H
+
+#include "stdint.h"
+
+#ifndef FILT_CIC_ORDER
+#define FILT_CIC_ORDER  2              //A CIC szr fokszma
+#endif
+
+//--- A hlzati peridus mintkban (fs/fmains egsz legyen!) ---------
+#define FILT_MAINS_LEN(fs,fmains)  ((fs)/(fmains))
+
+typedef struct {                       //Normls: x/G = ((x >> ps) * recip) >> 16
+  uint16_t recip;
+  uint8_t  ps;
+} filt_norm_t;
+
+typedef struct {                       //Mozgtlag
+  uint16_t *buf;                       //len elem krbuffer (a hv)
+  uint32_t sum;                        //A bufferben lv mintk sszege
+  filt_norm_t norm;                    //Oszts len-nel
+  uint8_t  len, idx;
+} filt_ma_t;
+
+typedef struct {                       //CIC decimtor
+  uint32_t integ[FILT_CIC_ORDER];      //Integrtorok (modulo 2^32)
+  uint32_t comb[FILT_CIC_ORDER];       //A fsszrk ksleltetett rtkei
+  filt_norm_t norm;                    //Oszts R^FILT_CIC_ORDER-rel
+  uint8_t  r, cnt;
+} filt_cic_t;
+
+typedef struct {                       //Egyplus IIR
+  uint32_t acc;                        //y * 2^k
+  uint8_t  k;                          //Idlland: 2^k minta
+} filt_iir_t;
+
+void filt_ma_init(filt_ma_t *p_f, uint16_t *pbuf, uint8_t len);
+uint16_t filt_ma_put(filt_ma_t *p_f, uint16_t x);
+uint16_t filt_ma_block(filt_ma_t *p_f, const uint16_t *pbuf, uint8_t n);
+
+void filt_cic_init(filt_cic_t *p_f, uint8_t r);
+uint8_t filt_cic_put(filt_cic_t *p_f, uint16_t x, uint16_t *p_out);
+uint8_t filt_cic_block(filt_cic_t *p_f, const uint16_t *pbuf, uint8_t n, uint16_t *p_out);
+
+void filt_iir_init(filt_iir_t *p_f, uint8_t k, uint16_t x0);
+uint16_t filt_iir_put(filt_iir_t *p_f, uint16_t x);
+uint16_t filt_iir_block(filt_iir_t *p_f, const uint16_t *pbuf, uint8_t n);
+
+#endif
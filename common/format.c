@@ -0,0 +1,85 @@
+/**********************************************************************
+ *  format.c
+ *
+ * Szmok szvegg alaktsa oszts nlkl.
+ * A decimlis szmjegyeket a tzhatvnyok ismtelt kivonsval
+ * hatrozzuk meg (szmjegyenknt legfeljebb 9 kivons), gy nincs
+ * szksg a lass 32 bites osztsra s maradkkpzsre.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "format.h"
+
+static const uint32_t pow10_tab[10] = {
+  1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+  10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+static const char hex_tab[16] = {
+  '0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F'
+};
+
+/**------------------------------------------------------------
+ * Decimlis formzs adott szm tizedesjegyre.
+ * Az eredmny megegyezik a korbbi sw_uart_outdec() kimenetvel:
+ * eljel (' ' vagy '-'), a tizedespont eltt legalbb egy szmjegy
+ * (tizedesjegyek nlkl legalbb kt szmjegy).
+ *-------------------------------------------------------------
+ * p_buf - a kimeneti buffer (legalbb FMT_DEC_SIZE bjt)
+ * data - a kirand szm (eljelesen)
+ * ndigits - a kirand tizedesek szma (0 - 9)
+ * Visszatrsi rtk: a karakterfzr hossza (lezr nulla nlkl)
+ */
+uint8_t fmt_dec(char *p_buf, int32_t data, uint8_t ndigits) {
+  const uint32_t *p_pow;
+  uint32_t u;
+  uint8_t n, nmin;
+  char c, *p;
+  p = p_buf;
+  u = (uint32_t)data;
+  if(data<0) {                         //Az eljel meghatrozsa
+    *p++ = '-';
+    u = 0 - u;
+  } else {
+    *p++ = ' ';
+  }
+  nmin = ndigits ? ndigits+1 : 2;      //A kirand szmjegyek minimlis szma
+  n = 10;
+  p_pow = pow10_tab;
+  while(n>nmin && u<*p_pow) {          //Vezet nullk tlpse
+    n--;
+    p_pow++;
+  }
+  while(n) {
+    c = '0';
+    while(u >= *p_pow) {               //Szmjegy = a kivonsok szma
+      u -= *p_pow;
+      c++;
+    }
+    if(n==ndigits) *p++ = '.';         //A tizedespont beszrsa
+    *p++ = c;
+    p_pow++;
+    n--;
+  }
+  *p = 0;
+  return (uint8_t)(p - p_buf);
+}
+
+/**------------------------------------------------------------
+ * Eljel nlkli szm formzsa 4 hexadecimlis jeggyel.
+ * A jegyeket a hex_tab tblzatbl vesszk, a kimenet megegyezik
+ * a korbbi sw_uart_out4hex() kimenetvel (nagybets A-F).
+ *-------------------------------------------------------------
+ * p_buf - a kimeneti buffer (legalbb FMT_HEX_SIZE bjt)
+ * t - a formzand szm (uint16_t tpus)
+ * Visszatrsi rtk: a karakterfzr hossza (mindig 4)
+ */
+uint8_t fmt_hex4(char *p_buf, uint16_t t) {
+  p_buf[0] = hex_tab[(t >> 12) & 0x0F];
+  p_buf[1] = hex_tab[(t >> 8) & 0x0F];
+  p_buf[2] = hex_tab[(t >> 4) & 0x0F];
+  p_buf[3] = hex_tab[t & 0x0F];
+  p_buf[4] = 0;
+  return 4;
+}
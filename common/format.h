@@ -0,0 +1,26 @@
+/**********************************************************************
+ *  format.h
+ *
+ * Szmok szvegg alaktsa oszts nlkl. Az MSP430G2xxx tpusokban
+ * nincs hardveres szorz, a 32 bites '/' s '%' mveletek hossz
+ * knyvtri eljrsok. Itt helyettk tzhatvnyok kivonst hasznljuk.
+ * A hexadecimlis jegyeket tblzatbl vesszk (nincs elgazs).
+ * A formzs a hv ltal megadott bufferbe trtnik.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include "stdint.h"
+
+//--- Buffermret: eljel + 10 szmjegy + tizedespont + lezr nulla --
+#define FMT_DEC_SIZE  13
+//--- Buffermret: 4 hexa jegy + lezr nulla -------------------------
+#define FMT_HEX_SIZE  5
+
+uint8_t fmt_dec(char *p_buf, int32_t data, uint8_t ndigits);
+uint8_t fmt_hex4(char *p_buf, uint16_t t);
+
+#endif
@@ -0,0 +1,16 @@
+/**********************************************************************
+ *  gcc/io430.h
+ *
+ * Az IAR io430.h helyettestje msp430-elf-gcc fordtshoz:
+ * a regiszterdefincikat s a kompatibilitsi makrkat a
+ * gcc/msp430.h adja.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef GCC_IO430_COMPAT_H
+#define GCC_IO430_COMPAT_H
+
+#include "msp430.h"
+
+#endif
@@ -0,0 +1,30 @@
+/**********************************************************************
+ *  gcc/msp430.h
+ *
+ * IAR kompatibilitsi rteg az msp430-elf-gcc fordthoz.
+ * Csak a GCC fordtsnl van az include tvonalon (CMake), az IAR
+ * projektek a sajt msp430.h s io430.h fejlceiket hasznljk.
+ * Az IAR specifikus beptett fggvnyeket a GCC megfelelire kpezi le.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef GCC_MSP430_COMPAT_H
+#define GCC_MSP430_COMPAT_H
+
+#include_next <msp430.h>
+
+#ifndef __low_power_mode_0
+#define __low_power_mode_0()            __bis_SR_register(LPM0_bits | GIE)
+#endif
+#ifndef __low_power_mode_3
+#define __low_power_mode_3()            __bis_SR_register(LPM3_bits | GIE)
+#endif
+#ifndef __low_power_mode_off_on_exit
+#define __low_power_mode_off_on_exit()  __bic_SR_register_on_exit(LPM4_bits)
+#endif
+#ifndef __even_in_range
+#define __even_in_range(x, y)           (x)
+#endif
+
+#endif
@@ -0,0 +1,36 @@
+/**********************************************************************
+ *  isr.h
+ *
+ * Megszaktskiszolgl eljrsok fordtfggetlen megadsa.
+ * IAR esetn a #pragma vector = ... s __interrupt kulcssz,
+ * GCC (msp430-elf) esetn az interrupt attribtum keletkezik.
+ * A gazdagpes emultorban (EMU_HOST, common/emu) az eljrs kznsges
+ * fggvny, amelyet egy konstruktor bejegyez a vektortblba.
+ *
+ * Hasznlat:
+ *   ISR(ADC10_VECTOR, ADC10_ISR)
+ *   {
+ *     ...
+ *   }
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef ISR_H
+#define ISR_H
+
+#if defined(EMU_HOST)
+#include "io430.h"
+#define ISR(vec, name)   void name (void);                             \
+  static void __attribute__((constructor)) name##_vector (void) {     \
+    emu_vector(vec, name);                                            \
+  }                                                                   \
+  void name (void)
+#elif defined(__GNUC__)
+#define ISR(vec, name)   void __attribute__((interrupt(vec))) name (void)
+#else
+#define ISR_PRAGMA(x)    _Pragma(#x)
+#define ISR(vec, name)   ISR_PRAGMA(vector = vec) __interrupt void name (void)
+#endif
+
+#endif
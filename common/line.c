@@ -0,0 +1,86 @@
+/**********************************************************************
+ *  line.c
+ *
+ * Egy kirand sor (rekord) sszelltsa RAM bufferben.
+ * A szmokat, ha elfrnek, kzvetlenl a sor bufferbe formzzuk
+ * (a lezr nullt a kvetkez hozzfzs fellrja), csak a sor
+ * vgn hasznlunk ideiglenes buffert.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "line.h"
+#include "format.h"
+
+/**------------------------------------------------------------
+ *  A sor trlse (j rekord kezdse)
+ *-------------------------------------------------------------*/
+void line_clear(line_t *p_line) {
+  p_line->len = 0;
+}
+
+/**------------------------------------------------------------
+ *  Adott szm karakter hozzfzse
+ *-------------------------------------------------------------
+ * p_line - a sor
+ * p_str - a karakterek cme
+ * n - a karakterek szma (ami nem fr el, elvsz)
+ */
+void line_put(line_t *p_line, const char *p_str, uint8_t n) {
+  char *p;
+  uint8_t room;
+  room = p_line->size - p_line->len;
+  if (n > room) n = room;
+  p = p_line->buf + p_line->len;
+  p_line->len += n;
+  while (n--) *p++ = *p_str++;
+}
+
+/**------------------------------------------------------------
+ *  Nullval lezrt karakterfzr hozzfzse
+ *-------------------------------------------------------------
+ * p_str - karakterfzr mutat (szvegkonstanshoz: line_label)
+ */
+void line_str(line_t *p_line, const char *p_str) {
+  uint8_t n;
+  for (n = 0; p_str[n]; n++);
+  line_put(p_line,p_str,n);
+}
+
+/**------------------------------------------------------------
+ *  Egy karakter hozzfzse
+ *-------------------------------------------------------------*/
+void line_char(line_t *p_line, char c) {
+  if (p_line->len < p_line->size) {
+    p_line->buf[p_line->len++] = c;
+  }
+}
+
+/**------------------------------------------------------------
+ *  Eljel nlkli szm hozzfzse 4 hexadecimlis jeggyel
+ *-------------------------------------------------------------
+ * t - a kirand szm (uint16_t tpus)
+ */
+void line_hex4(line_t *p_line, uint16_t t) {
+  char s[FMT_HEX_SIZE];
+  if (p_line->size - p_line->len >= FMT_HEX_SIZE) {
+    p_line->len += fmt_hex4(p_line->buf + p_line->len,t);
+  } else {
+    line_put(p_line,s,fmt_hex4(s,t));  //A sor vgn: ami elfr
+  }
+}
+
+/**------------------------------------------------------------
+ *  Decimlis szm hozzfzse adott szm tizedesjegyre
+ *-------------------------------------------------------------
+ * data - a kirand szm (eljelesen)
+ * ndigits - a kirand tizedesek szma (0 - 9)
+ */
+void line_dec(line_t *p_line, int32_t data, uint8_t ndigits) {
+  char s[FMT_DEC_SIZE];
+  if (p_line->size - p_line->len >= FMT_DEC_SIZE) {
+    p_line->len += fmt_dec(p_line->buf + p_line->len,data,ndigits);
+  } else {
+    line_put(p_line,s,fmt_dec(s,data,ndigits)); //A sor vgn: ami elfr
+  }
+}
@@ -0,0 +1,46 @@
+/**********************************************************************
+ *  line.h
+ *
+ * Egy kirand sor (rekord) sszelltsa RAM bufferben. A cmkk,
+ * hexa s decimlis szmok egyms utn a bufferbe kerlnek, a ksz
+ * sort pedig egyetlen hvssal adjuk t az adnak (sw_uart_send(),
+ * sw_uart_write()). gy nincs karakterenknti eljrshvs, s egy
+ * rekord kirsnak ideje elre kiszmthat.
+ *
+ *  - a cmkk (szvegkonstansok) hosszt a fordt szmolja ki
+ *    (line_label), futs kzben nem kell a lezr nullt keresni
+ *  - hexa kirs tblzatbl (fmt_hex4), decimlis oszts nlkl
+ *    (fmt_dec), mindkett kzvetlenl a sor bufferbe
+ *  - a buffer nem nullval lezrt, a hosszt a len mez adja
+ *  - ami nem fr el, az elvsz (a sor csonkul, nem rdik tl)
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef LINE_H
+#define LINE_H
+
+#include "stdint.h"
+
+typedef struct {
+  char *buf;                           //A sor trhelye
+  uint8_t size;                        //A trhely mrete
+  uint8_t len;                         //Az eddig bert karakterek szma
+} line_t;
+
+//--- Sor definilsa statikus trhellyel ------------------------------
+#define LINE_DEFINE(name,size) \
+  static char name##_buf[size]; \
+  line_t name = { name##_buf, (size), 0 }
+
+//--- Szvegkonstans hozzfzse (a hosszt a fordt szmolja) --------
+#define line_label(p_line,str)  line_put(p_line, str, sizeof(str) - 1)
+
+void line_clear(line_t *p_line);
+void line_put(line_t *p_line, const char *p_str, uint8_t n);
+void line_str(line_t *p_line, const char *p_str);
+void line_char(line_t *p_line, char c);
+void line_hex4(line_t *p_line, uint16_t t);
+void line_dec(line_t *p_line, int32_t data, uint8_t ndigits);
+
+#endif
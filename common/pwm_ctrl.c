@@ -0,0 +1,84 @@
+/**********************************************************************
+ *  pwm_ctrl.c
+ *
+ * Szablyoz fokozat az ADC kd s a PWM kitlts kztt: IIR simts,
+ * holtsv s CIE fnyessg-korrekci tblzatbl.
+ * A bemenet s a kimenet is 10 bites (0 - 1023), a tblzat i. pontja
+ * az i * 8 bemen kdhoz tartozik, a teljes sklnl levgva. Az utols
+ * pont tlmutat a skln, gy az 1023-as kd ppen teljes kitltst ad.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "pwm_ctrl.h"
+
+//--- CIE 1976 L* -> kitlts (bench/cie_table.py) ----------------------
+static const uint16_t cie_tab[PWM_CTRL_TAB_N + 1] = {
+     0,    1,    2,    3,    4,    4,    5,    6,    7,    8,
+     9,   10,   11,   12,   13,   14,   15,   16,   18,   19,
+    21,   22,   24,   26,   28,   29,   31,   34,   36,   38,
+    40,   43,   45,   48,   51,   53,   56,   59,   63,   66,
+    69,   73,   76,   80,   84,   88,   92,   96,  101,  105,
+   110,  114,  119,  124,  129,  135,  140,  146,  151,  157,
+   163,  169,  176,  182,  189,  196,  203,  210,  217,  224,
+   232,  240,  248,  256,  264,  273,  281,  290,  299,  308,
+   318,  327,  337,  347,  357,  368,  378,  389,  400,  411,
+   422,  434,  446,  458,  470,  482,  495,  508,  521,  534,
+   548,  562,  576,  590,  604,  619,  634,  649,  664,  680,
+   696,  712,  728,  745,  762,  779,  796,  814,  832,  850,
+   869,  887,  906,  925,  945,  965,  985, 1005, 1026
+};
+
+/**------------------------------------------------------------
+ *  A szablyoz inicializlsa
+ *-------------------------------------------------------------
+ * p_c - a szablyoz llapota
+ * k - a simts idllandja: 2^k mrs (0: nincs simts)
+ * band - holtsv LSB-ben (0: nincs holtsv)
+ * x0 - kezdeti ADC kd (pl. az els mrs)
+ */
+void pwm_ctrl_init(pwm_ctrl_t *p_c, uint8_t k, uint8_t band, uint16_t x0) {
+  filt_iir_init(&p_c->iir,k,x0);
+  p_c->level = x0;
+  p_c->band = band;
+}
+
+/**------------------------------------------------------------
+ *  Fnyessg-korrekci: tblzat s lineris interpolci
+ *-------------------------------------------------------------
+ * code - az rzkelt vilgossg (0 - 1023)
+ * Visszatrsi rtk: a PWM kitlts (0 - 1023)
+ * A szorzst (klnbsg * trtrsz, 3 bit) hrom feltteles
+ * sszeads helyettesti, mert a G2xx tpusokban nincs szorz.
+ */
+uint16_t pwm_ctrl_cie(uint16_t code) {
+  const uint16_t *p;
+  uint16_t d, acc;
+  uint8_t f;
+  if (code > 1023) code = 1023;
+  p = &cie_tab[code >> 3];
+  f = code & 7;
+  d = p[1] - p[0];                     //A tblzat monoton nvekv
+  acc = 0;
+  if (f & 1) acc += d;
+  if (f & 2) acc += d << 1;
+  if (f & 4) acc += d << 2;
+  return p[0] + (acc >> 3);
+}
+
+/**------------------------------------------------------------
+ *  Egy ADC mrs feldolgozsa
+ *-------------------------------------------------------------
+ * p_c - a szablyoz llapota
+ * code - az ADC konverzi eredmnye (0 - 1023)
+ * Visszatrsi rtk: a PWM kitlts (TACCR1)
+ */
+uint16_t pwm_ctrl_put(pwm_ctrl_t *p_c, uint16_t code) {
+  uint16_t y;
+  y = filt_iir_put(&p_c->iir,code);    //Simts
+  if (y > p_c->level + p_c->band || y + p_c->band < p_c->level
+      || y == 0 || y == 1023) {        //A skla vgei mindig elrhetk
+    p_c->level = y;                    //A holtsvon kvl: kvetjk
+  }
+  return pwm_ctrl_cie(p_c->level);
+}
@@ -0,0 +1,47 @@
+/**********************************************************************
+ *  pwm_ctrl.h
+ *
+ * Szablyoz fokozat az ADC kd s a PWM kitlts (TACCR1) kztt,
+ * LED fnyer vezrlshez (4_ADC_pwm1, 4_ADC_pwm2):
+ *  1. egyplus IIR simts (filter.c): az ADC zaja nem jut a
+ *     kitltsbe, idlland 2^k mrs
+ *  2. holtsv (hiszterzis): a kimenet csak akkor vltozik, ha a
+ *     simtott rtk tbb mint 'band' LSB-vel eltr az utoljra
+ *     elfogadottl, gy a legkisebb helyirtk billegse nem
+ *     ltszik villogsknt
+ *  3. fnyessg-korrekci: a kd az rzkelt vilgossg (CIE L*),
+ *     a kimenet a hozz tartoz kitlts. A 129 pontos tblzat a
+ *     flash-ben van (bench/cie_table.py lltja el), a pontok kztt
+ *     linerisan interpollunk, szorzs nlkl.
+ *
+ * A pwm_ctrl_put() az ADC10 (vagy a CCR0) megszaktsbl hvhat.
+ * Ciklusigny (MCLK): a PWM_CTRL_BUDGET (k = 3) becsls a forrskd
+ * alapjn, nem mrt rtk; 1 MHz-en, 1:8 osztssal s 1024 lpses
+ * PWM-mel a peridus (8192 ciklus) kb. 3%-a. A run_bench a bench 17
+ * mrst veti ssze vele, tllpsnl hibval ll le.
+ * Ha a CPU-t egyltaln nem akarjuk hasznlni, a DTC kzvetlenl
+ * is rhatja a TACCR1-et (4_ADC_pwm3), ekkor nincs simts.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef PWM_CTRL_H
+#define PWM_CTRL_H
+
+#include "stdint.h"
+#include "filter.h"
+
+#define PWM_CTRL_TAB_N   128           //A korrekcis tblzat szakaszai
+#define PWM_CTRL_BUDGET  250           //Ciklusigny becslt fels korltja (k = 3)
+
+typedef struct {
+  filt_iir_t iir;                      //Simts
+  uint16_t level;                      //Az utoljra elfogadott (simtott) kd
+  uint8_t band;                        //Holtsv (LSB)
+} pwm_ctrl_t;
+
+void pwm_ctrl_init(pwm_ctrl_t *p_c, uint8_t k, uint8_t band, uint16_t x0);
+uint16_t pwm_ctrl_put(pwm_ctrl_t *p_c, uint16_t code);
+uint16_t pwm_ctrl_cie(uint16_t code);
+
+#endif
@@ -0,0 +1,73 @@
+/**********************************************************************
+ *  queue.c
+ *
+ * Egy termel - egy fogyaszt krbuffer zrols nlkl.
+ * A termel elbb az elemet rja be, csak utna lpteti az indexet,
+ * gy a fogyaszt sosem lt flig bert elemet.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "queue.h"
+
+/**------------------------------------------------------------
+ * Sor inicializlsa (a sor legyen res, senki ne hasznlja)
+ *-------------------------------------------------------------
+ * p_q - a sor lerja
+ * p_items - az elemek trhelye
+ * size - az elemek szma (2 hatvnya, legfeljebb 128)
+ */
+void queue_init(queue_t *p_q, queue_item_t *p_items, uint8_t size) {
+  p_q->items = p_items;
+  p_q->mask = size - 1;
+  p_q->head = p_q->tail = 0;
+  p_q->maxfill = 0;
+  p_q->overruns = 0;
+}
+
+/**------------------------------------------------------------
+ * Elem bersa (csak a termel hvhatja, nem blokkol)
+ *-------------------------------------------------------------
+ * p_q - a sor lerja
+ * data - az adat
+ * stamp - az idblyeg
+ * Visszatrsi rtk: 1 = sikerlt, 0 = tele a sor (overruns n)
+ */
+uint8_t queue_put(queue_t *p_q, uint16_t data, uint16_t stamp) {
+  uint8_t head, fill;
+  head = p_q->head;
+  fill = (head - p_q->tail) & p_q->mask;
+  if (fill == p_q->mask) {             //Tele: egy hely mindig res
+    p_q->overruns++;
+    return 0;
+  }
+  p_q->items[head].data = data;
+  p_q->items[head].stamp = stamp;
+  p_q->head = (head + 1) & p_q->mask;  //Az elem csak most vlik lthatv
+  if (++fill > p_q->maxfill) p_q->maxfill = fill;
+  return 1;
+}
+
+/**------------------------------------------------------------
+ * Elem kivtele (csak a fogyaszt hvhatja, nem blokkol)
+ *-------------------------------------------------------------
+ * p_q - a sor lerja
+ * p_item - ide msoljuk a kivett elemet
+ * Visszatrsi rtk: 1 = volt elem, 0 = res a sor
+ */
+uint8_t queue_get(queue_t *p_q, queue_item_t *p_item) {
+  uint8_t tail;
+  tail = p_q->tail;
+  if (tail == p_q->head) return 0;     //res
+  p_item->data = p_q->items[tail].data;
+  p_item->stamp = p_q->items[tail].stamp;
+  p_q->tail = (tail + 1) & p_q->mask;  //A hely csak most szabadul fel
+  return 1;
+}
+
+/**------------------------------------------------------------
+ * A sorban vrakoz elemek szma (pillanatkp)
+ *-------------------------------------------------------------*/
+uint8_t queue_count(const queue_t *p_q) {
+  return (p_q->head - p_q->tail) & p_q->mask;
+}
@@ -0,0 +1,50 @@
+/**********************************************************************
+ *  queue.h
+ *
+ * Egy termel - egy fogyaszt (SPSC) krbuffer zrols nlkl, a
+ * feldolgozsi lnc fokozatainak sszekapcsolsra. A termel s a
+ * fogyaszt lehet megszakts is: az rsi indexet (head) csak a
+ * termel, az olvassi indexet (tail) csak a fogyaszt rja, a 8 bites
+ * indexek rsa pedig oszthatatlan, ezrt nem kell letiltani a
+ * megszaktsokat.
+ *
+ * Minden elem egy adatot s egy idblyeget hordoz (pl. a blokk
+ * sorszma vagy tick_ms()), ebbl a fogyaszt a ksleltetst szmolja.
+ *
+ * Felttelek:
+ *  - a mret 2 hatvnya (legfeljebb 128), egy hely mindig res marad
+ *  - egy sorba csak egy helyrl runk s csak egy helyrl olvasunk
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include "stdint.h"
+
+typedef struct {
+  uint16_t data;                       //Az adat
+  uint16_t stamp;                      //Idblyeg (a termel egysgben)
+} queue_item_t;
+
+typedef struct {
+  volatile queue_item_t *items;        //Az elemek trhelye
+  uint8_t mask;                        //mret - 1
+  volatile uint8_t head;               //rsi index (csak a termel rja)
+  volatile uint8_t tail;               //Olvassi index (csak a fogyaszt rja)
+  uint8_t maxfill;                     //Az eddigi legnagyobb teltettsg
+  uint16_t overruns;                   //Tele sor miatt eldobott elemek
+} queue_t;
+
+//--- Sor definilsa statikus trhellyel (size: 2 hatvnya) ----------
+#define QUEUE_DEFINE(name,size) \
+  static queue_item_t name##_items[size]; \
+  queue_t name = { name##_items, (size) - 1, 0, 0, 0, 0 }
+
+void queue_init(queue_t *p_q, queue_item_t *p_items, uint8_t size);
+uint8_t queue_put(queue_t *p_q, uint16_t data, uint16_t stamp);
+uint8_t queue_get(queue_t *p_q, queue_item_t *p_item);
+uint8_t queue_count(const queue_t *p_q);
+
+#endif
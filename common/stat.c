@@ -0,0 +1,140 @@
+/**********************************************************************
+ *  stat.c
+ *
+ * Mrsi adatsorok feldolgozsa (tlagols, tlmintavtelezs).
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "stat.h"
+
+//--- Ngyzettblzat a stat_block() eljrshoz: sq[i] = i^2, i = 0..62 --
+static const uint16_t sq[63] = {
+     0,    1,    4,    9,   16,   25,   36,   49,   64,   81,  100,  121,
+   144,  169,  196,  225,  256,  289,  324,  361,  400,  441,  484,  529,
+   576,  625,  676,  729,  784,  841,  900,  961, 1024, 1089, 1156, 1225,
+  1296, 1369, 1444, 1521, 1600, 1681, 1764, 1849, 1936, 2025, 2116, 2209,
+  2304, 2401, 2500, 2601, 2704, 2809, 2916, 3025, 3136, 3249, 3364, 3481,
+  3600, 3721, 3844
+};
+
+/**------------------------------------------------------------
+ * Adatok tlagolsa (szmtani kzp)
+ *-------------------------------------------------------------
+ * pbuf - az adatok trhelynek cme
+ * n - az tlagolni kvnt adatok szma
+ */
+uint16_t avg(const uint16_t *pbuf, uint8_t n) {
+  uint8_t i;
+  uint16_t sum;
+  sum = 0;
+  for(i=0; i<n; i++) sum += *pbuf++;
+  return (sum/n);
+}
+
+/**------------------------------------------------------------
+ * Tlmintavtelezs s decimls: 4^n minta sszege, kerektve
+ * n bittel jobbra lptetve, (10+n) bites eredmny oszts nlkl
+ *-------------------------------------------------------------
+ * pbuf - az adatok trhelynek cme (legalbb OS_NSAMPLES(n) adat)
+ * n - a tbbletbitek szma (0 - STAT_OS_NMAX)
+ */
+uint16_t decimate(const uint16_t *pbuf, uint8_t n) {
+  uint16_t i, cnt;
+  cnt = OS_NSAMPLES(n);
+  if(n <= 3) {                         //64 * 1023 = 65472: 16 bit elg
+    uint16_t sum = 0;
+    for(i=0; i<cnt; i++) sum += *pbuf++;
+    return n ? (sum >> n) + ((sum >> (n-1)) & 1) : sum;
+  } else {                             //1024 * 1023 < 2^20: 32 bit kell
+    uint32_t sum = 0;
+    for(i=0; i<cnt; i++) sum += *pbuf++;
+    return (uint16_t)((sum + (1UL << (n-1))) >> n);
+  }
+}
+
+/**------------------------------------------------------------
+ * Az adatok terjedelme (a legnagyobb s a legkisebb klnbsge)
+ *-------------------------------------------------------------
+ * pbuf - az adatok trhelynek cme
+ * n - az adatok szma (legalbb 1)
+ */
+uint16_t spread(const uint16_t *pbuf, uint8_t n) {
+  uint16_t lo, hi, x;
+  lo = hi = *pbuf++;
+  while(--n) {
+    x = *pbuf++;
+    if(x < lo) lo = x;
+    if(x > hi) hi = x;
+  }
+  return hi - lo;
+}
+
+/*-------------------------------------------------------------
+ * Egsz ngyzetgyk (lefel kerektve), bitenknt
+ *-------------------------------------------------------------*/
+static uint16_t isqrt32(uint32_t v) {
+  uint32_t r = 0, bit = 1UL << 30;
+  while (bit > v) bit >>= 2;
+  while (bit) {
+    if (v >= r + bit) {
+      v -= r + bit;
+      r = (r >> 1) + bit;
+    } else {
+      r >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint16_t)r;
+}
+
+//--- Egy minta feldolgozsa: szls rtkek, sszeg, ngyzetsszeg rszei
+#define STAT_STEP()  do {                                             \
+    x = *pbuf++;                                                      \
+    if (x < lo) lo = x;                                               \
+    if (x > hi) hi = x;                                               \
+    s += x;                                                           \
+    a = x >> 5;                                                       \
+    b = x & 31;                                                       \
+    saa += sq[a];                                                     \
+    sbb += sq[b];                                                     \
+    sab += sq[a + b] - sq[(a > b) ? a - b : b - a];                   \
+  } while (0)
+
+/**------------------------------------------------------------
+ * Blokkstatisztika egy menetben (min, max, tlag, szrsngyzet,
+ * szrs, ngyzetes kzp), ngyesvel kifejtett ciklussal
+ *-------------------------------------------------------------
+ * pbuf - a mintk cme (10 bites ADC kdok, 0 - 1023)
+ * k - a mintk szma 2^k (STAT_K_MIN - STAT_K_MAX)
+ * p_st - ide kerl az eredmny
+ * A gyjtk 32 bitesek: 256 * 1023^2 < 2^28. A blokk vgn az
+ * tlag ngyzett S = q*2^k + r alakban, 32 biten szmoljuk:
+ * S^2 / 2^k = q^2 * 2^k + 2qr + r^2 / 2^k.
+ */
+void stat_block(const uint16_t *pbuf, uint8_t k, stat_block_t *p_st) {
+  uint16_t i, x, lo, hi, q, r;
+  uint8_t a, b;
+  uint32_t s, saa, sbb, sab, sxx, s2;
+  lo = 0xFFFF;
+  hi = 0;
+  s = saa = sbb = sab = 0;
+  for(i = 1U << (k - 2); i; i--) {
+    STAT_STEP();
+    STAT_STEP();
+    STAT_STEP();
+    STAT_STEP();
+  }
+  sxx = (saa << 10) + (sab << 4) + sbb; //Ngyzetsszeg: 1024a^2 + 16*4ab + b^2
+  q = (uint16_t)(s >> k);              //Az tlag egsz rsze
+  r = (uint16_t)s & ((1U << k) - 1);   //s maradka
+  s2 = ((uint32_t)q * q << k) + ((uint32_t)q * r << 1) + (((uint32_t)r * r) >> k);
+  p_st->min = lo;
+  p_st->max = hi;
+  p_st->mean = (uint16_t)(((s << STAT_FRAC) + (1U << (k - 1))) >> k);
+  p_st->var = ((sxx - s2) << STAT_FRAC) >> k;
+  p_st->sd = isqrt32(p_st->var << STAT_FRAC);
+  sxx <<= STAT_FRAC;                   //256 * sxx / 2^k csonkts nlkl
+  sxx = (k >= STAT_FRAC) ? sxx >> (k - STAT_FRAC) : sxx << (STAT_FRAC - k);
+  p_st->rms = isqrt32(sxx);
+}
@@ -0,0 +1,56 @@
+/**********************************************************************
+ *  stat.h
+ *
+ * Mrsi adatsorok feldolgozsa (tlagols, tlmintavtelezs).
+ *
+ * decimate(): 4^n minta sszegbl n bittel jobbra lptetve
+ * (10+n) bites eredmnyt ad. A tbbletfelbontshoz legalbb 1 LSB
+ * nagysg zaj kell a jelen, ha ez nincs, lsd dither.h.
+ * Az sszegz szlessge: 4^n * 1023 < 2^(10+2n), gy n <= 3 esetn
+ * 16 bit elg, felette 32 bites sszegzvel szmolunk.
+ * spread(): a mintk terjedelme (max - min), a zaj vagy a blokkon belli
+ * vltozs olcs mrtke (pl. az adapt.h aktivitsfigyelshez).
+ * stat_block(): egy 2^k mints blokk (pl. egy ksz DTC flbuffer)
+ * minimuma, maximuma, tlaga, szrsngyzete, szrsa s ngyzetes
+ * kzprtke egyetlen menetben, szorzs nlkl. A ngyzetsszeg a
+ * 10 bites x = 32a + b felbontsbl jn: x^2 = 1024a^2 + 64ab + b^2, ahol
+ * 4ab = (a+b)^2 - (a-b)^2, gy mintnknt csak egy 63 elem
+ * ngyzettblzatot olvasunk, a lptetsek a blokk vgre maradnak.
+ * A trt eredmnyek 4 trt bitesek (STAT_FRAC): az rtk 16-szorosa.
+ * Ciklusigny: 500 Hz-es mintavtelnl 1 MHz-en mintnknt 2000 MCLK
+ * ciklus jut a teljes feldolgozsra, ebbl a stat_block() a blokk vgi
+ * szmtsokkal (szorzsok, kt ngyzetgyk) egytt legfeljebb
+ * STAT_BLOCK_BUDGET ciklust hasznlhat mintnknt. Ez tervezsi korlt,
+ * nem mrt rtk: a bench 18-19 (32 s 128 minta) mrst a run_bench
+ * veti ssze vele, s kirja a tartalkot (2000 - mrt ciklus/minta).
+ * Gazdagpes ellenrzs lebegpontos referencival: tools/stat_check.c.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef STAT_H
+#define STAT_H
+
+#include "stdint.h"
+
+#define STAT_OS_NMAX      5            //Legfeljebb 1024 minta, 15 bites eredmny
+#define OS_NSAMPLES(n)    (1U << (2*(n)))  //A szksges mintk szma (4^n)
+#define STAT_FRAC         4            //stat_block(): trt bitek szma
+#define STAT_K_MIN        2            //stat_block(): legalbb 4 minta
+#define STAT_K_MAX        8            //stat_block(): legfeljebb 256 minta
+#define STAT_BLOCK_BUDGET 400          //stat_block(): ciklus/minta korlt (bench 18-19)
+
+typedef struct {
+  uint16_t min, max;                   //A legkisebb s a legnagyobb minta
+  uint16_t mean;                       //tlag * 16
+  uint16_t sd;                         //Szrs (vltakoz RMS) * 16
+  uint16_t rms;                        //Ngyzetes kzp (egyenszinttel) * 16
+  uint32_t var;                        //Szrsngyzet (LSB^2) * 16
+} stat_block_t;
+
+uint16_t avg(const uint16_t *pbuf, uint8_t n);
+uint16_t decimate(const uint16_t *pbuf, uint8_t n);
+uint16_t spread(const uint16_t *pbuf, uint8_t n);
+void stat_block(const uint16_t *pbuf, uint8_t k, stat_block_t *p_st);
+
+#endif
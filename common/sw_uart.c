@@ -0,0 +1,153 @@
+/**********************************************************************
+ *  sw_uart.c
+ *
+ * Egyirny szoftveres UART kezels (csak adatklds).
+ * A karakterklds alaprtelmezetten bit banging mdszerrel,
+ * SW_UART_USE_TIMER esetn a Timer_A megszaktsos adval, SW_UART_USE_USCI
+ * esetn (a G2553-on alaprtelmezs) az USCI_A0 hardveres UART-tal trtnik.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "sw_uart.h"
+#include "format.h"
+#if defined(SW_UART_USE_USCI)
+#include "usci_uart.h"
+#define TX_WRITE   usci_uart_write       //Nem blokkol bers a krbufferbe
+#define TX_WAKE    usci_uart_wake        //breszts krse helyfelszabadulskor
+#elif defined(SW_UART_USE_TIMER)
+#include "sw_uart_tx.h"
+#define TX_WRITE   sw_uart_write
+#define TX_WAKE    sw_uart_tx_wake
+#elif SW_UART_SMCLK / SW_UART_BAUD <= SW_UART_LOOP_CYCLES
+#error "SW_UART_BAUD: ehhez az rajelhez tl nagy adatsebessg"
+#endif
+
+#if !defined(SW_UART_USE_TIMER) && !defined(SW_UART_USE_USCI)
+//--- A TXD szintje a bit rtke szerint: elgazs nlkl, gy a '0' s
+//--- az '1' bit kirsa ugyanannyi ideig tart (nem halmozdik a hiba)
+static const uint8_t tx_level[2] = { 0, SW_UART_TXD };
+
+//--- Egy bit kirsa, majd vrakozs a kvetkez bitlig -------------
+//--- (kifejtett ciklus: minden bithez sajt, fordtskor szmolt ksleltets)
+#define TXBIT(k)  P1OUT = (P1OUT & ~SW_UART_TXD) | tx_level[TXData & 1]; \
+                  TXData >>= 1;                                          \
+                  __delay_cycles(SW_UART_DELAY(k,(k)+1))
+#endif
+
+/**------------------------------------------------------------
+ *   A TXD kimenet inicializlsa (alaphelyzet: mark)
+ *-------------------------------------------------------------*/
+void sw_uart_init(void) {
+#if defined(SW_UART_USE_USCI)
+  usci_uart_init();                    //USCI_A0, UCA0TXD a P1.2 lbon
+#elif defined(SW_UART_USE_TIMER)
+  sw_uart_tx_init();                   //TXD, Timer_A s az adsi buffer
+#else
+  P1DIR |= SW_UART_TXD;                //TXD legyen digitlis kimenet
+  P1OUT |= SW_UART_TXD;                //TXD alaphelyzete: mark
+#endif
+}
+
+/**------------------------------------------------------------
+ *   Egy karakter kikldse a soros portra
+ *   SW_UART: 9600 bit/s, 8, N, 2 formtum (alaprtelmezs)
+ *   A bitidk a SW_UART_EDGE() tblzatbl jnnek, a bitenknti
+ *   sajt idt (SW_UART_LOOP_CYCLES) levonjuk bellk.
+ *-------------------------------------------------------------
+ * c - a kikldeni kvnt karakter kdja
+ */
+void sw_uart_putc(char c) {
+#if defined(SW_UART_USE_USCI)
+  usci_uart_putc(c);                   //Bufferbe rs, az USCI kldi ki
+#elif defined(SW_UART_USE_TIMER)
+  sw_uart_tx_putc(c);                  //Bufferbe rs, a Timer_A kldi ki
+#else
+  uint16_t TXData;                     //Adatregiszter
+  TXData = (uint16_t)(uint8_t)c << 1;  //Start bit (space) + adatbitek
+  TXBIT(0); TXBIT(1); TXBIT(2); TXBIT(3); TXBIT(4);
+  TXBIT(5); TXBIT(6); TXBIT(7); TXBIT(8);
+  P1OUT |= SW_UART_TXD;                //Stop bit(ek), egyben az alaphelyzet
+  __delay_cycles(SW_UART_EDGE(SW_UART_NBITS) - SW_UART_EDGE(9)); //Inkbb hosszabb
+#endif
+}
+
+/**------------------------------------------------------------
+ *  Adott hosszsg buffer kirsa egyetlen hvssal
+ *-------------------------------------------------------------
+ * Megszaktsos adnl (USCI, Timer_A) a buffer egyben kerl az adsi
+ * krbufferbe, ha elfr; ha nem, a maradkot LPM0-ban vrakozva,
+ * a hely felszabadulsval adjuk t. Bit banging esetn
+ * karakterenknt kldjk ki.
+ * p_buf - a kikldend karakterek (nem kell lezr nulla)
+ * len - a karakterek szma
+ */
+void sw_uart_send(const char *p_buf, uint8_t len) {
+#if defined(SW_UART_USE_USCI) || defined(SW_UART_USE_TIMER)
+  uint8_t n;
+  __disable_interrupt();
+  while (len) {
+    n = TX_WRITE(p_buf,len);           //Ami elfr, a krbufferbe kerl
+    p_buf += n;
+    len -= n;
+    if (len && TX_WAKE()) {
+      __low_power_mode_0();            //Alvs, amg hely szabadul fel
+      __disable_interrupt();
+    }
+  }
+  __enable_interrupt();
+#else
+  while (len--) sw_uart_putc(*p_buf++);
+#endif
+}
+
+/**------------------------------------------------------------
+ *  Karakterfzr kirsa a soros portra
+ *-------------------------------------------------------------
+ * p_str - karakterfzr mutat (nullval lezrt stringre mutat)
+ */
+void sw_uart_puts(const char *p_str) {
+  uint8_t n;
+  while (*p_str) {
+    for (n = 0; p_str[n] && n < 255; n++); //A hossz (legfeljebb 255-svel)
+    sw_uart_send(p_str,n);
+    p_str += n;
+  }
+}
+
+/**------------------------------------------------------------
+ *  Vrakozs a kirs befejezsig
+ *-------------------------------------------------------------
+ * Megszaktsos ad (USCI, Timer_A) esetn alvs (LPM3) eltt
+ * kell hvni, mert ott az SMCLK, s vele az ad is lell.
+ * Bit banging esetn a sw_uart_putc() eleve kivrja a keretet.
+ */
+void sw_uart_flush(void) {
+#if defined(SW_UART_USE_USCI)
+  usci_uart_flush();
+#elif defined(SW_UART_USE_TIMER)
+  sw_uart_tx_flush();
+#endif
+}
+
+/**------------------------------------------------------------
+ * Eljel nlkli egsz szm kirsa hexadecimlis formban
+ *-------------------------------------------------------------
+ * t - a kirand szm (uint16_t tpus)
+ */
+void sw_uart_out4hex(uint16_t t) {
+  char s[FMT_HEX_SIZE];
+  sw_uart_send(s,fmt_hex4(s,t));       //Tblzatos formzs, egy tads
+}
+
+/**------------------------------------------------------------
+ * Decimlis kirats adott szm tizedesjegyre.
+ *-------------------------------------------------------------
+ * data - a kirand szm (eljelesen)
+ * ndigits - a kirand tizedesek szma
+ */
+void sw_uart_outdec(int32_t data, uint8_t ndigits) {
+  char s[FMT_DEC_SIZE];
+  sw_uart_send(s,fmt_dec(s,data,ndigits)); //Formzs oszts nlkl, egy tads
+}
@@ -0,0 +1,89 @@
+/**********************************************************************
+ *  sw_uart.h
+ *
+ * Egyirny szoftveres UART kezels (csak adatklds) a TXD lbon.
+ * Alaprtelmezs: 9600 baud, 8 adatbit, nincs paritsbit, 2 stopbit,
+ * DCO = CLOCK_HZ (1 MHz). A belltsokat a projektben definilt
+ * makrkkal (Preprocessor/Defined symbols) mdosthatjuk:
+ *
+ *  SW_UART_BAUD       - adatsebessg (legfeljebb 115200, ha az rajel elg)
+ *  SW_UART_STOPBITS   - stop bitek szma (1 vagy 2)
+ *  SW_UART_LOOP_CYCLES - a bit banging bitenknti sajt ideje (ciklus)
+ *  SW_UART_USE_TIMER  - ha definilt, a kirs a Timer_A CCR1
+ *                       megszaktsos adn keresztl trtnik
+ *                       (ekkor a sw_uart_tx.c-t is a projekthez kell adni)
+ *  SW_UART_USE_USCI   - ha definilt, a kirs a hardveres USCI_A0 adn
+ *                       keresztl trtnik (usci_uart.c, TXD = P1.2,
+ *                       sebessg: USCI_UART_BAUD). MSP430G2553 esetn
+ *                       ez az alaprtelmezs, a SW_UART_NO_USCI tiltja.
+ *
+ * Bitidzts: a k. bitl idelis idpontja k * SMCLK / BAUD rats,
+ * ennek kerektse a SW_UART_EDGE(k) tblzat. Az egyes bitek hossza
+ * (SW_UART_BITLEN) ezrt egy ratssel eltrhet, a trtrsz okozta
+ * hiba nem halmozdik a kereten bell: minden l legfeljebb fl
+ * ratsnyire van az idelistl. Az ellenrzs minden rajel s
+ * adatsebessg prra: tools/uart_timing_check.c (ctest).
+ * A bit banging sajt ideje (SW_UART_LOOP_CYCLES, a TXBIT() kirsa s
+ * lptetse) a fordttl fgg, az alaprtk (15) a kdbl becslt,
+ * nem mrt rtk. Mrse: a bench 1 (sw_uart_putc, alapbelltssal)
+ * ciklusszma N = SW_UART_EDGE(SW_UART_NBITS) + NBITS * (valdi sajt
+ * id - SW_UART_LOOP_CYCLES) + a hvs sajt ideje, gy a valdi rtk
+ * SW_UART_LOOP_CYCLES + (N - SW_UART_EDGE(NBITS)) / NBITS, a hvs
+ * sajt idejt elhanyagolva (bitenknt legfeljebb 2 - 3 ciklus). A
+ * run_bench kiszmolja, s hibt ad, ha a keret rvidebb a
+ * SW_UART_EDGE(NBITS)-nl, vagy bitenknt 3 ciklusnl tbbel hosszabb.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef SW_UART_H
+#define SW_UART_H
+
+#include "stdint.h"
+#include "clock.h"
+
+//--- Httr kivlasztsa tpus szerint: a G2553-on hardveres UART -----
+#if defined(__MSP430G2553__) && !defined(SW_UART_NO_USCI) && !defined(SW_UART_USE_TIMER)
+#define SW_UART_USE_USCI
+#endif
+
+#ifndef SW_UART_TXD
+#define SW_UART_TXD        BIT1        //TXD a P1.1 lbon
+#endif
+#ifndef SW_UART_SMCLK
+#define SW_UART_SMCLK      CLOCK_HZ    //rajel (Hz), bit bangingnl MCLK
+#endif
+#ifndef SW_UART_BAUD
+#define SW_UART_BAUD       9600UL      //Adatsebessg (bit/s)
+#endif
+#ifndef SW_UART_STOPBITS
+#define SW_UART_STOPBITS   2           //Stop bitek szma (1 vagy 2)
+#endif
+#ifndef SW_UART_LOOP_CYCLES
+#define SW_UART_LOOP_CYCLES 15         //Bitenknti sajt id (becsls, mrse: bench 1)
+#endif
+
+//--- Egy keret bitjeinek szma: start + 8 adat + stop ----------------
+#define SW_UART_NBITS      (1 + 8 + SW_UART_STOPBITS)
+//--- A stop bitek helye az adatregiszterben (a start bit eltt) ------
+#define SW_UART_STOPMASK   (((1 << SW_UART_STOPBITS) - 1) << 8)
+
+//--- Bitidztsi tblzat (ratsekben, fordtsi idben szmolva) -
+//--- SW_UART_EDGE(k): a k. bitl a start bit elejtl, kerektve
+#define SW_UART_EDGE(k)    (((k) * SW_UART_SMCLK + SW_UART_BAUD/2) / SW_UART_BAUD)
+//--- SW_UART_BITLEN(k): a k. bit hossza (a start bit a 0.)
+#define SW_UART_BITLEN(k)  (SW_UART_EDGE((k) + 1) - SW_UART_EDGE(k))
+//--- SW_UART_MID(k): a k. bit kzepe (a vev itt mintavtelez)
+#define SW_UART_MID(k)     (((2*(k) + 1) * SW_UART_SMCLK + SW_UART_BAUD) / (2*SW_UART_BAUD))
+//--- SW_UART_DELAY(a,b): vrakozs az a. bit kirsa utn a b. lig
+#define SW_UART_DELAY(a,b) (SW_UART_EDGE(b) - SW_UART_EDGE(a) - SW_UART_LOOP_CYCLES)
+
+void sw_uart_init(void);
+void sw_uart_putc(char c);
+void sw_uart_puts(const char *p_str);
+void sw_uart_send(const char *p_buf, uint8_t len);
+void sw_uart_flush(void);
+void sw_uart_out4hex(uint16_t t);
+void sw_uart_outdec(int32_t data, uint8_t ndigits);
+
+#endif
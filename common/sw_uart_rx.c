@@ -0,0 +1,134 @@
+/**********************************************************************
+ *  sw_uart_rx.c
+ *
+ * Megszaktsos szoftveres UART vev, Timer_A CCR1 rgzts +
+ * komparls. llapotok (rx_bit):
+ *   0xFF - lre vr (rgzt md, lefut l)
+ *   0    - a start bit kzepe: ellenrzs
+ *   1..8 - adatbitek (legkisebb helyirtk ell)
+ *   9    - stop bit: ha alacsony, keretezsi hiba
+ * A mintavteli idpontok a rgztett lhez kpest a SW_UART_MID()
+ * tblzatbl jnnek, gy a trtrsz nem halmozdik.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "sw_uart_rx.h"
+#include "sw_uart_tx.h"
+
+#define RXD        SW_UART_RXD
+#define RXBUF_MASK (SW_UART_RXBUF_SIZE - 1)
+#define RX_IDLE    0xFF
+//--- Rgzts: lefut l, CCI1A, szinkronizlt, megszaktssal -------
+#define RX_CAPTURE (CM_2 | CCIS_0 | SCS | CAP | CCIE)
+
+volatile uint8_t sw_uart_rx_errors;    //Keretezsi hibk s tlcsordulsok
+static char rx_buf[SW_UART_RXBUF_SIZE]; //Vteli krbuffer
+static volatile uint8_t rx_head;       //rsi index (megszakts)
+static volatile uint8_t rx_tail;       //Olvassi index (fprogram)
+static uint8_t rx_bit;                 //Az llapot (a kvetkez bit sorszma)
+static uint8_t rx_data;                //A berkez bjt
+
+//--- A kvetkez mintavtelig htralev id bitenknt (rats) ------
+static const uint16_t rx_step[10] = {
+  SW_UART_MID(0),
+  SW_UART_MID(1) - SW_UART_MID(0), SW_UART_MID(2) - SW_UART_MID(1),
+  SW_UART_MID(3) - SW_UART_MID(2), SW_UART_MID(4) - SW_UART_MID(3),
+  SW_UART_MID(5) - SW_UART_MID(4), SW_UART_MID(6) - SW_UART_MID(5),
+  SW_UART_MID(7) - SW_UART_MID(6), SW_UART_MID(8) - SW_UART_MID(7),
+  SW_UART_MID(9) - SW_UART_MID(8)
+};
+
+/**------------------------------------------------------------
+ *   A vev inicializlsa: P1.2 a CCR1 rgzt bemenete
+ *-------------------------------------------------------------*/
+void sw_uart_rx_init(void) {
+  P1DIR &= ~RXD;                       //RXD bemenet
+  P1SEL |= RXD;                        //TA0.1 (CCI1A) funkci
+  rx_head = rx_tail = 0;
+  rx_bit = RX_IDLE;
+  sw_uart_rx_errors = 0;
+  TACCTL1 = RX_CAPTURE;                //Vrakozs a start bit lre
+  __enable_interrupt();
+}
+
+/**------------------------------------------------------------
+ *  Egy vett karakter kivtele a bufferbl (nem blokkol)
+ *-------------------------------------------------------------
+ * p_c - ide kerl a karakter
+ * Visszatrsi rtk: 1 = volt karakter, 0 = res a buffer
+ */
+uint8_t sw_uart_rx_get(char *p_c) {
+  uint8_t tail = rx_tail;
+  if (tail == rx_head) return 0;
+  *p_c = rx_buf[tail];
+  rx_tail = (tail + 1) & RXBUF_MASK;
+  return 1;
+}
+
+/**------------------------------------------------------------
+ *  Lekrdezs: van-e vett karakter a bufferben?
+ *-------------------------------------------------------------*/
+uint8_t sw_uart_rx_avail(void) {
+  return rx_tail != rx_head;
+}
+
+/**------------------------------------------------------------
+ *  Egy karakter beolvassa (res buffer esetn LPM0-ban vr)
+ *-------------------------------------------------------------*/
+char sw_uart_getc(void) {
+  char c;
+  __disable_interrupt();
+  while (!sw_uart_rx_get(&c)) {
+    __low_power_mode_0();              //A ksz bjt felbreszt
+    __disable_interrupt();
+  }
+  __enable_interrupt();
+  return c;
+}
+
+/**------------------------------------------------------------
+ *  CCR1 esemny (a TIMER0_A1 megszaktsbl, lsd sw_uart_tx.c)
+ *-------------------------------------------------------------
+ * Visszatrsi rtk: 1, ha egy bjt megrkezett (a megszakts
+ * ekkor felbreszti a CPU-t)
+ */
+uint8_t sw_uart_rx_isr(void) {
+  uint8_t next;
+  uint16_t cctl = TACCTL1;
+  if (rx_bit == RX_IDLE) {             //Start bit le: TACCR1 = az l ideje
+    rx_bit = 0;
+    TACCR1 = sw_uart_tnext(TACCR1,rx_step[0]);
+    TACCTL1 = CCIS_0 | SCS | CCIE;     //Komparls, SCCI = a minta
+    return 0;
+  }
+  if (rx_bit == 0) {                   //A start bit kzepe
+    if (cctl & SCCI) {                 //Mr magas: tske volt
+      rx_bit = RX_IDLE;
+      TACCTL1 = RX_CAPTURE;
+      return 0;
+    }
+  } else if (rx_bit <= 8) {            //Adatbit
+    rx_data >>= 1;
+    if (cctl & SCCI) rx_data |= 0x80;
+  } else {                             //Stop bit
+    if (!(cctl & SCCI)) {
+      sw_uart_rx_errors++;             //Keretezsi hiba
+    } else {
+      next = (rx_head + 1) & RXBUF_MASK;
+      if (next == rx_tail) {
+        sw_uart_rx_errors++;           //Tlcsorduls: a bjt elveszett
+      } else {
+        rx_buf[rx_head] = (char)rx_data;
+        rx_head = next;
+      }
+    }
+    rx_bit = RX_IDLE;
+    TACCTL1 = RX_CAPTURE;              //Vrakozs a kvetkez start bitre
+    return 1;
+  }
+  rx_bit++;
+  TACCR1 = sw_uart_tnext(TACCR1,rx_step[rx_bit]);
+  return 0;
+}
@@ -0,0 +1,48 @@
+/**********************************************************************
+ *  sw_uart_rx.h
+ *
+ * Megszaktsos szoftveres UART vev a P1.2 (RXD) lbon, Timer_A
+ * CCR1 rgztssel. A start bit lefut lt a CCR1 rgzt mdban
+ * (CCI1A = P1.2) pontosan idblyegzi, ezutn a CCR1 kompartor
+ * mdba vlt, s minden bit kzepn (SW_UART_MID tblzat) az SCCI
+ * bitbl mintavtelez. Ha a start bit a kzepn mr magas, tsknek
+ * tekintjk, s jra lre vrunk. A ksz bjt a vteli krbufferbe
+ * kerl, s a megszakts felbreszti a CPU-t.
+ *
+ * Felttelek:
+ *  - a projektben SW_UART_RX definilt, s a sw_uart_tx.c is rsze
+ *    (a kzs TIMER0_A1 megszaktst az ad kezeli, az ad ekkor a
+ *    CCR2-t hasznlja)
+ *  - Timer_A3 kell (MSP430G2452, MSP430G2553), a G2231-ben nincs CCR2
+ *  - a sw_uart_tx_init() utn hvand (a Timer_A ekkor mr fut)
+ *  - a sebessget s a keretformtumot a sw_uart.h makri adjk meg
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef SW_UART_RX_H
+#define SW_UART_RX_H
+
+#include "stdint.h"
+#include "sw_uart.h"
+
+#ifndef SW_UART_RXD
+#define SW_UART_RXD        BIT2        //RXD a P1.2 lbon (TA0.1 = CCI1A)
+#endif
+#ifndef SW_UART_RXBUF_SIZE
+#define SW_UART_RXBUF_SIZE 8           //Vteli buffer mrete (2 hatvnya!)
+#endif
+
+#if defined(__MSP430G2231__)
+#error "sw_uart_rx: a vevhz Timer_A3 kell (MSP430G2452, MSP430G2553)"
+#endif
+
+extern volatile uint8_t sw_uart_rx_errors; //Keretezsi hibk s tlcsordulsok
+
+void sw_uart_rx_init(void);
+uint8_t sw_uart_rx_get(char *p_c);
+uint8_t sw_uart_rx_avail(void);
+char sw_uart_getc(void);
+uint8_t sw_uart_rx_isr(void);
+
+#endif
@@ -0,0 +1,225 @@
+/**********************************************************************
+ *  sw_uart_tx.c
+ *
+ * Megszaktsos szoftveres UART ad, Timer_A CCR1 temezssel.
+ * A CCR1 megszaktsban elszr a soron kvetkez bitet rjuk ki
+ * a TXD lbra, s csak utna szmoljuk ki a kvetkezt. gy minden
+ * lnl azonos a megszakts ksleltetse, a bitid pontos marad.
+ * Az utols stop bit utn mg egy bitidt vrunk, mieltt a
+ * megszaktst letiltjuk, hogy a stop bit hossza mindig meglegyen.
+ * SW_UART_RX esetn a CCR1 a vev (P1.2 = CCI1A bemenet), az ad
+ * ekkor a CCR2-t hasznlja, s a kzs TIMER0_A1 megszakts a
+ * vev esemnyeit a sw_uart_rx_isr() eljrsnak adja tovbb.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "sw_uart_tx.h"
+#include "isr.h"
+#ifdef SW_UART_RX
+#include "sw_uart_rx.h"
+#endif
+
+#define TXD        SW_UART_TXD          //TXD a P1.1 lbon
+#define TXBUF_MASK (SW_UART_TXBUF_SIZE - 1)
+
+#ifdef SW_UART_RX                       //CCR1 a vev, az ad a CCR2-n
+#define TX_CCR     TACCR2
+#define TX_CCTL    TACCTL2
+#define TX_TAIV    4                    //TAIV: CCR2 esemny
+#else
+#define TX_CCR     TACCR1
+#define TX_CCTL    TACCTL1
+#define TX_TAIV    2                    //TAIV: CCR1 esemny
+#endif
+
+static char tx_buf[SW_UART_TXBUF_SIZE]; //Adsi krbuffer
+static volatile uint8_t tx_head;        //rsi index (fprogram)
+static volatile uint8_t tx_tail;        //Olvassi index (megszakts)
+static volatile uint8_t tx_active;      //0: ll, 1: keret megy, 2: utols stop bit
+static volatile uint8_t tx_wait;        //A fprogram LPM0-ban vr
+static uint16_t tx_shift;               //Adatregiszter (start+adat+stop)
+static uint8_t tx_bits;                 //A keretbl htralev bitek szma
+
+//--- Bitenknti hosszak (rats), a trtrsz egyenletesen elosztva --
+static const uint16_t tx_bitlen[SW_UART_NBITS] = {
+  SW_UART_BITLEN(0), SW_UART_BITLEN(1), SW_UART_BITLEN(2), SW_UART_BITLEN(3),
+  SW_UART_BITLEN(4), SW_UART_BITLEN(5), SW_UART_BITLEN(6), SW_UART_BITLEN(7),
+  SW_UART_BITLEN(8), SW_UART_BITLEN(9)
+#if SW_UART_STOPBITS > 1
+  , SW_UART_BITLEN(10)
+#endif
+};
+
+/*-------------------------------------------------------------
+ * Kvetkez karakter betltse a krbufferbl az adatregiszterbe
+ *-------------------------------------------------------------*/
+static void tx_load(void) {
+  tx_shift = ((uint16_t)(uint8_t)tx_buf[tx_tail] | SW_UART_STOPMASK) << 1;
+  tx_tail = (tx_tail + 1) & TXBUF_MASK;
+  tx_bits = SW_UART_NBITS;
+  tx_active = 1;
+}
+
+/**------------------------------------------------------------
+ * Kvetkez komparlsi idpont: 'base' + 'len' rats.
+ * Felfel szmll mdban a TACCR0 peridusra tekernk vissza.
+ * (A vev is ezt hasznlja.)
+ *-------------------------------------------------------------*/
+uint16_t sw_uart_tnext(uint16_t base, uint16_t len) {
+  uint16_t t = base + len;
+  if ((TACTL & MC_3) == MC_1 && t > TACCR0) {
+    t -= TACCR0 + 1;
+  }
+  return t;
+}
+
+/**------------------------------------------------------------
+ *   Az ad inicializlsa
+ *-------------------------------------------------------------
+ * Ha Timer_A mg nem fut, akkor SMCLK rajellel, folytonos
+ * szmll mdban elindtjuk. Egy mr fut idztt (pl. az ADC
+ * triggerelst) nem konfigurlunk t.
+ */
+void sw_uart_tx_init(void) {
+  P1OUT |= TXD;                        //TXD alaphelyzete: mark
+  P1DIR |= TXD;                        //TXD legyen digitlis kimenet
+  tx_head = tx_tail = 0;
+  tx_active = 0;
+  TX_CCTL = 0;                         //Compare md, megszakts tiltva
+  if ((TACTL & MC_3) == 0) {
+    TACTL = TASSEL_2 | ID_0 | MC_2 | TACLR; //SMCLK, folytonos szmlls
+  }
+  __enable_interrupt();
+}
+
+/**------------------------------------------------------------
+ *  Adatok bersa az adsi bufferbe (nem blokkol)
+ *-------------------------------------------------------------
+ * p_buf - a kikldend adatok cme
+ * len - a kikldend bjtok szma
+ * Visszatrsi rtk: a bufferbe tnylegesen bert bjtok szma
+ */
+uint8_t sw_uart_write(const char *p_buf, uint8_t len) {
+  uint8_t n, next;
+  for (n = 0; n < len; n++) {
+    next = (tx_head + 1) & TXBUF_MASK;
+    if (next == tx_tail) break;        //Megtelt a buffer
+    tx_buf[tx_head] = p_buf[n];
+    tx_head = next;
+  }
+  if (n && !tx_active) {               //ll az ad: elindtjuk
+    tx_load();
+    TX_CCR = sw_uart_tnext(TAR,SW_UART_BITTIME);
+    TX_CCTL = CCIE;                    //CCIFG trlse, megszakts engedlyezse
+  }
+  return n;
+}
+
+/**------------------------------------------------------------
+ *   Egy karakter kikldse (tele buffer esetn LPM0-ban vr)
+ *-------------------------------------------------------------
+ * c - a kikldeni kvnt karakter kdja
+ */
+void sw_uart_tx_putc(char c) {
+  __disable_interrupt();
+  while (!sw_uart_write(&c, 1)) {
+    tx_wait = 1;
+    __low_power_mode_0();              //Alvs, amg hely szabadul fel
+    __disable_interrupt();
+  }
+  __enable_interrupt();
+}
+
+/**------------------------------------------------------------
+ *  Karakterfzr kirsa a soros portra
+ *-------------------------------------------------------------
+ * p_str - karakterfzr mutat (nullval lezrt stringre mutat)
+ */
+void sw_uart_tx_puts(const char *p_str) {
+  char c;
+  while ((c = *p_str)) {
+    sw_uart_tx_putc(c);
+    p_str++;
+  }
+}
+
+/**------------------------------------------------------------
+ *  Vrakozs (LPM0-ban) az adsi buffer kirlsig
+ *-------------------------------------------------------------*/
+void sw_uart_tx_flush(void) {
+  __disable_interrupt();
+  while (tx_active) {
+    tx_wait = 1;
+    __low_power_mode_0();              //Alvs az utols stop bit vgig
+    __disable_interrupt();
+  }
+  __enable_interrupt();
+}
+
+/**------------------------------------------------------------
+ *  Lekrdezs: folyamatban van-e mg ads?
+ *-------------------------------------------------------------*/
+uint8_t sw_uart_tx_busy(void) {
+  return tx_active != 0;
+}
+
+/**------------------------------------------------------------
+ *  breszts krse, ha hely szabadul fel a bufferben
+ *-------------------------------------------------------------
+ * Letiltott megszaktsok mellett, az LPM0 alvs eltt kell hvni,
+ * ha a fprogram a sw_uart_write() utn megmaradt rszt ksbb
+ * maga akarja berni.
+ * Visszatrsi rtk: 1 = az ad felbreszt, 0 = az ad ll, nem
+ * bresztene (ilyenkor nem szabad elaludni)
+ */
+uint8_t sw_uart_tx_wake(void) {
+  if (!tx_active) return 0;
+  tx_wait = 1;
+  return 1;
+}
+
+//----------------------------------------------------------------------
+// CCR1 (CCR2) megszakts: a soron kvetkez bit kikldse a TXD lbra
+//----------------------------------------------------------------------
+ISR(TIMER0_A1_VECTOR, TIMERA1_ISR)
+{
+  uint8_t bit;
+  uint16_t iv = TAIV;                  //Olvasskor a jelzbit trldik
+#ifdef SW_UART_RX
+  if (iv == 2) {                       //CCR1: a vev esemnye
+    if (sw_uart_rx_isr()) {
+      __low_power_mode_off_on_exit();  //Ksz bjt: felbresztjk a CPU-t
+    }
+    return;
+  }
+#endif
+  if (iv != TX_TAIV) return;           //Csak az ad forrst kezeljk
+  if (tx_shift & 0x01) {               //Kirs elsknt: lland ksleltets
+    P1OUT |= TXD;                      //Ha '1'
+  } else {
+    P1OUT &= ~TXD;                     //Ha '0'
+  }
+  bit = SW_UART_NBITS - tx_bits;       //A most kirt bit sorszma
+  tx_shift = tx_shift >> 1;            //Adatregiszter lptets jobbra
+  if (--tx_bits == 0) {                //A keret utols bitje is kiment
+    if (tx_tail != tx_head) {
+      tx_load();                       //Folytats a kvetkez karakterrel
+    } else if (tx_active == 1) {
+      tx_shift = 0x01;                 //Mg egy bitid: az utols stop bit
+      tx_bits = 1;
+      tx_active = 2;
+    } else {
+      TX_CCTL &= ~CCIE;                //Kirlt a buffer: az ad lell
+      tx_active = 0;
+    }
+    if (tx_wait) {                     //Hely szabadult fel, vagy lelltunk
+      tx_wait = 0;
+      __low_power_mode_off_on_exit();  //Felbresztjk az alv CPU-t
+    }
+  }
+  if (tx_active) {
+    TX_CCR = sw_uart_tnext(TX_CCR,tx_bitlen[bit]); //A kvetkez l idpontja
+  }
+}
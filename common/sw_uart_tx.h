@@ -0,0 +1,50 @@
+/**********************************************************************
+ *  sw_uart_tx.h
+ *
+ * Megszaktsos szoftveres UART ad, Timer_A CCR1 temezssel.
+ * A biteket a CCR1 kompartor megszaktsa lpteti ki a TXD (P1.1)
+ * kimenetre, a kikldend karakterek egy krbufferbe kerlnek.
+ * gy a CPU a bitek kztt LPM0 mdban alhat, a bitid pedig
+ * nem fgg a fprogram futstl.
+ *
+ * Felttelek:
+ *  - Timer_A rajele SMCLK, oszts nlkl (ID_0)
+ *  - Timer_A folytonos (MC_2) vagy felfel szmll (MC_1) mdban fut,
+ *    felfel szmllsnl a peridus (TACCR0+1) nagyobb a bitidnl
+ *  - CCR1 s a TIMER0_A1 megszaktsi vektor az ad (SW_UART_RX
+ *    esetn a CCR2, a CCR1 a vev, lsd sw_uart_rx.h)
+ *
+ * A sebessget s a keretformtumot a sw_uart.h makri adjk meg.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef SW_UART_TX_H
+#define SW_UART_TX_H
+
+#include "stdint.h"
+#include "sw_uart.h"                  //SW_UART_SMCLK, SW_UART_BAUD, SW_UART_STOPBITS
+
+#ifndef SW_UART_TXBUF_SIZE
+#define SW_UART_TXBUF_SIZE 32          //Adsi buffer mrete (2 hatvnya!)
+#endif
+
+//--- Bitid Timer_A ratsekben (kerektve) -------------------------
+#define SW_UART_BITTIME  ((uint16_t)SW_UART_EDGE(1))
+//--- A megszakts kiszolglshoz legalbb ennyi rats kell bitenknt
+#define SW_UART_TX_MINBIT  60
+
+#if SW_UART_SMCLK / SW_UART_BAUD < SW_UART_TX_MINBIT
+#error "SW_UART_BAUD: ehhez az rajelhez tl nagy adatsebessg (Timer_A ad)"
+#endif
+
+void sw_uart_tx_init(void);
+uint8_t sw_uart_write(const char *p_buf, uint8_t len);
+void sw_uart_tx_putc(char c);
+void sw_uart_tx_puts(const char *p_str);
+void sw_uart_tx_flush(void);
+uint8_t sw_uart_tx_busy(void);
+uint8_t sw_uart_tx_wake(void);
+uint16_t sw_uart_tnext(uint16_t base, uint16_t len);
+
+#endif
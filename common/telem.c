@@ -0,0 +1,120 @@
+/**********************************************************************
+ *  telem.c
+ *
+ * Binris mrsi keret sszelltsa s ellenrzse (lsd telem.h).
+ * A CRC-8 tblzat nlkl, bitenknt szmoldik: lassabb, de egy
+ * 9 bjtos keretnl ez kevesebb, mint egy karakter kikldsi ideje,
+ * s nem foglal 256 bjt flash memrit.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "telem.h"
+
+/**------------------------------------------------------------
+ * CRC-8 szmtsa (polinom: x^8+x^2+x+1, kezdrtk 0)
+ *-------------------------------------------------------------
+ * p_buf - az adatok cme
+ * len - az adatok szma
+ */
+uint8_t telem_crc8(const uint8_t *p_buf, uint8_t len) {
+  uint8_t crc = 0;
+  uint8_t i;
+  while (len--) {
+    crc ^= *p_buf++;
+    for (i = 0; i < 8; i++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**------------------------------------------------------------
+ * A maszkban kijellt csatornk szma
+ *-------------------------------------------------------------*/
+uint8_t telem_nchan(uint16_t mask) {
+  uint8_t n = 0;
+  while (mask) {
+    mask &= mask - 1;                  //A legals 1-es bit trlse
+    n++;
+  }
+  return n;
+}
+
+/**------------------------------------------------------------
+ * Keret sszelltsa
+ *-------------------------------------------------------------
+ * p_buf - ide kerl a keret (legalbb TELEM_FRAME_SIZE(n) bjt)
+ * seq - a keret sorszma
+ * mask - csatornamaszk (k. bit = Ak csatorna)
+ * p_data - a mintk cskken csatornasorrendben (n = telem_nchan(mask))
+ * Visszatrsi rtk: a keret hossza bjtokban
+ */
+uint8_t telem_pack(uint8_t *p_buf, uint8_t seq, uint16_t mask,
+                   const uint16_t *p_data) {
+  uint8_t *p = p_buf;
+  uint8_t n, nbits;
+  uint32_t acc;                        //Legfeljebb 7+10 bit: 16 nem elg
+  n = telem_nchan(mask);
+  *p++ = TELEM_SYNC;
+  *p++ = seq;
+  *p++ = (uint8_t)mask;
+  *p++ = (uint8_t)(mask >> 8);
+  acc = 0;
+  nbits = 0;
+  while (n--) {
+    acc |= (uint32_t)(*p_data++ & 0x3FF) << nbits;
+    nbits += 10;
+    while (nbits >= 8) {
+      *p++ = (uint8_t)acc;
+      acc >>= 8;
+      nbits -= 8;
+    }
+  }
+  if (nbits) *p++ = (uint8_t)acc;      //A maradk bitek, 0-val kiegsztve
+  *p = telem_crc8(p_buf + 1, (uint8_t)(p - p_buf - 1));
+  return (uint8_t)(p - p_buf + 1);
+}
+
+/**------------------------------------------------------------
+ * Keret ellenrzse s kicsomagolsa
+ *-------------------------------------------------------------
+ * p_buf - a keret els bjtja (szinkron bjt)
+ * len - a rendelkezsre ll bjtok szma
+ * p_seq, p_mask - ide kerl a sorszm s a csatornamaszk
+ * p_data - ide kerlnek a mintk (legalbb TELEM_NCHAN_MAX hely)
+ * p_size - ide kerl a keret hossza (TELEM_OK esetn)
+ * Visszatrsi rtk: TELEM_OK, TELEM_SHORT, TELEM_BAD_SYNC vagy
+ * TELEM_BAD_CRC
+ */
+uint8_t telem_parse(const uint8_t *p_buf, uint8_t len, uint8_t *p_seq,
+                    uint16_t *p_mask, uint16_t *p_data, uint8_t *p_size) {
+  const uint8_t *p;
+  uint8_t n, nbits, size;
+  uint16_t mask;
+  uint32_t acc;                        //Legfeljebb 9+8 bit
+  if (len < 1) return TELEM_SHORT;
+  if (p_buf[0] != TELEM_SYNC) return TELEM_BAD_SYNC;
+  if (len < 4) return TELEM_SHORT;
+  mask = p_buf[2] | ((uint16_t)p_buf[3] << 8);
+  n = telem_nchan(mask);
+  size = TELEM_FRAME_SIZE(n);
+  if (len < size) return TELEM_SHORT;
+  if (telem_crc8(p_buf + 1, size - 2) != p_buf[size - 1]) return TELEM_BAD_CRC;
+  *p_seq = p_buf[1];
+  *p_mask = mask;
+  *p_size = size;
+  p = p_buf + 4;
+  acc = 0;
+  nbits = 0;
+  while (n--) {
+    while (nbits < 10) {
+      acc |= (uint32_t)*p++ << nbits;
+      nbits += 8;
+    }
+    *p_data++ = (uint16_t)acc & 0x3FF;
+    acc >>= 10;
+    nbits -= 10;
+  }
+  return TELEM_OK;
+}
@@ -0,0 +1,46 @@
+/**********************************************************************
+ *  telem.h
+ *
+ * Binris mrsi keret a szveges kirats helyett. Egy 3 csatorns
+ * mrs szvegesen kb. 50 karakter, binris keretben 9 bjt, gy
+ * ugyanazon a vonalon tbb mint tszr annyi mrs fr t.
+ *
+ * A keret felptse:
+ *   0xA5       szinkron bjt
+ *   seq        sorszm (modulo 256, a kimaradt keretek felismershez)
+ *   mask       csatornamaszk, 2 bjt (elbb az als): k. bit = Ak csatorna
+ *   adatok     a 10 bites mintk cskken csatornasorrendben (mint a
+ *              psztz mrs bufferben), szorosan pakolva, a legkisebb
+ *              helyirtk bittl kezdve: n minta (10*n+7)/8 bjt
+ *   crc        CRC-8 (x^8+x^2+x+1, kezdrtk 0) a seq-tl az adatok vgig
+ *
+ * A modul hardverfggetlen, a gazdagpen a dekdol is ezt hasznlja
+ * (tools/telem_decode.c).
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef TELEM_H
+#define TELEM_H
+
+#include "stdint.h"
+
+#define TELEM_SYNC         0xA5        //Szinkron bjt
+#define TELEM_NCHAN_MAX    16          //Az ADC10 csatorninak szma
+//--- A keret hossza n minta esetn: sync+seq+mask(2)+adatok+crc -------
+#define TELEM_FRAME_SIZE(n)  (5 + (10*(n) + 7) / 8)
+
+//--- A telem_parse() visszatrsi rtkei ----------------------------
+#define TELEM_OK           0           //p keret
+#define TELEM_SHORT        1           //Mg nem rkezett meg a teljes keret
+#define TELEM_BAD_SYNC     2           //Az els bjt nem szinkron bjt
+#define TELEM_BAD_CRC      3           //Hibs ellenrz sszeg
+
+uint8_t telem_crc8(const uint8_t *p_buf, uint8_t len);
+uint8_t telem_nchan(uint16_t mask);
+uint8_t telem_pack(uint8_t *p_buf, uint8_t seq, uint16_t mask,
+                   const uint16_t *p_data);
+uint8_t telem_parse(const uint8_t *p_buf, uint8_t len, uint8_t *p_seq,
+                    uint16_t *p_mask, uint16_t *p_data, uint8_t *p_size);
+
+#endif
@@ -0,0 +1,135 @@
+/**********************************************************************
+ *  tick.c
+ *
+ * Kis fogyaszts idzts: WDT intervallum megszakts ACLK = VLO
+ * rajellel, alvs LPM3 mdban, periodikus feladatok temezse.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "tick.h"
+#include "isr.h"
+
+#define TICK_VLO_DIV   64              //WDT_ADLY_1_9: ACLK/64
+#define TICK_CAL_N     8               //Ennyi VLO peridust mrnk
+
+static volatile uint16_t tick_now;     //Ezredmsodperc-szmll
+static volatile uint16_t tick_wake_at; //bresztsi idpont (ms)
+static volatile uint8_t tick_sleeping; //1: a fprogram alszik
+static uint16_t tick_us;               //Egy tick hossza (us)
+static uint16_t tick_frac;             //Az ezredmsodperc trtrsze (us)
+
+/*-------------------------------------------------------------
+ * A VLO peridusnak mrse Timer_A-val: CCR0 rgzti ACLK
+ * (CCI0B) felfut leit, a szmll SMCLK temben jr.
+ * Visszatrsi rtk: TICK_CAL_N VLO peridus SMCLK temben.
+ *-------------------------------------------------------------*/
+static uint16_t vlo_measure(void) {
+  uint16_t t0;
+  uint8_t i;
+  TACCTL0 = CM_1 | CCIS_1 | CAP;       //Felfut l, CCI0B = ACLK, rgzts
+  TACTL = TASSEL_2 | MC_2 | TACLR;     //SMCLK, folytonos szmlls
+  while (!(TACCTL0 & CCIFG));          //Az els l (szinkronizls)
+  TACCTL0 &= ~CCIFG;
+  t0 = TACCR0;
+  for(i=0; i<TICK_CAL_N; i++) {
+    while (!(TACCTL0 & CCIFG));
+    TACCTL0 &= ~CCIFG;
+  }
+  t0 = TACCR0 - t0;
+  TACTL = 0;                           //Timer_A lelltsa
+  TACCTL0 = 0;
+  return t0;
+}
+
+/**------------------------------------------------------------
+ * Az idalap indtsa: ACLK = VLO, kalibrls, WDT intervallum md
+ *-------------------------------------------------------------*/
+void tick_init(void) {
+  uint32_t t;
+  BCSCTL3 = (BCSCTL3 & ~LFXT1S_3) | LFXT1S_2; //ACLK forrsa a VLO
+  t = vlo_measure();                   //TICK_CAL_N peridus SMCLK temben
+  t = (t * (TICK_VLO_DIV / TICK_CAL_N) * 1000UL) / (TICK_SMCLK / 1000); //us
+  if (t < 1000 || t > 0xFFFF)          //Hihetetlen rtk: nvleges VLO
+    t = (TICK_VLO_DIV * 1000000UL) / TICK_VLO_HZ;
+  tick_us = (uint16_t)t;
+  tick_now = 0;
+  tick_frac = 0;
+  tick_sleeping = 0;
+  WDTCTL = WDT_ADLY_1_9;               //Intervallum md, ACLK/64
+  IE1 |= WDTIE;                        //WDT megszakts engedlyezse
+  __enable_interrupt();
+}
+
+/**------------------------------------------------------------
+ * Az indts ta eltelt id ezredmsodpercben (16 bites, krbefordul)
+ *-------------------------------------------------------------*/
+uint16_t tick_ms(void) {
+  return tick_now;
+}
+
+/**------------------------------------------------------------
+ * Vrakozs LPM3 mdban
+ *-------------------------------------------------------------
+ * ms - a vrakozs ideje (legfeljebb 32767 ms), a felbonts egy tick
+ */
+void sleep_ms(uint16_t ms) {
+  __disable_interrupt();
+  tick_wake_at = tick_now + ms;
+  while ((int16_t)(tick_now - tick_wake_at) < 0) {
+    tick_sleeping = 1;
+    __low_power_mode_3();              //Alvs az bresztsi idpontig
+    __disable_interrupt();
+  }
+  tick_sleeping = 0;
+  __enable_interrupt();
+}
+
+/**------------------------------------------------------------
+ * Periodikus feladatok futtatsa (nem tr vissza)
+ *-------------------------------------------------------------
+ * p_tasks - a feladatok tblzata (TICK_TASK() bejegyzsek)
+ * n - a feladatok szma
+ * Minden feladat elszr az indtskor fut le, utna peridusonknt.
+ */
+void tick_run(tick_task_t *p_tasks, uint8_t n) {
+  uint16_t now, wait;
+  uint8_t i;
+  now = tick_ms();
+  for(i=0; i<n; i++) p_tasks[i].next = now;
+  while(1) {
+    wait = 0xFFFF;
+    for(i=0; i<n; i++) {
+      now = tick_ms();
+      if ((int16_t)(now - p_tasks[i].next) >= 0) {
+        p_tasks[i].fn();
+        p_tasks[i].next += p_tasks[i].period; //Csszsmentes temezs
+        if ((int16_t)(now - p_tasks[i].next) >= 0) //Lemarads: jraindul
+          p_tasks[i].next = now + p_tasks[i].period;
+      }
+    }
+    now = tick_ms();
+    for(i=0; i<n; i++) {               //A legkzelebbi esedkes feladat
+      if ((int16_t)(p_tasks[i].next - now) <= 0) { wait = 0; break; }
+      if (p_tasks[i].next - now < wait) wait = p_tasks[i].next - now;
+    }
+    if (wait) sleep_ms(wait);
+  }
+}
+
+//----------------------------------------------------------------------
+// WDT intervallum megszakts: az id lptetse, breszts
+//----------------------------------------------------------------------
+ISR(WDT_VECTOR, WDT_ISR)               //A jelzbit automatikusan trldik
+{
+  tick_frac += tick_us;
+  while (tick_frac >= 1000) {          //Egsz ezredmsodpercek
+    tick_frac -= 1000;
+    tick_now++;
+  }
+  if (tick_sleeping && (int16_t)(tick_now - tick_wake_at) >= 0) {
+    tick_sleeping = 0;
+    __low_power_mode_off_on_exit();    //Felbresztjk az alv CPU-t
+  }
+}
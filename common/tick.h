@@ -0,0 +1,55 @@
+/**********************************************************************
+ *  tick.h
+ *
+ * Kis fogyaszts idzts s egyttmkd (kooperatv) temez.
+ * Az idalapot a watchdog idzt intervallum mdja adja, ACLK = VLO
+ * (kb. 12 kHz) rajellel, 64 rajelenknt megszaktssal (kb. 5,3 ms).
+ * A VLO frekvencijt a tick_init() a kalibrlt DCO-hoz mri (Timer_A
+ * bemeneti rgzts), gy az ezredmsodperc-szmll pontos marad.
+ *
+ * sleep_ms() alatt a CPU LPM3 mdban alszik (csak ACLK fut), ezrt
+ * ezalatt az SMCLK-t hasznl perifrik (Timer_A, sw_uart_tx, USCI,
+ * ADC trigger) llnak: a kirst alvs eltt be kell fejezni
+ * (sw_uart_tx_flush, sw_uart_flush).
+ *
+ * Periodikus feladatok: a TICK_TASK() bejegyzsekbl ll tblzatot
+ * a tick_run() futtatja, a feladatok kztt a CPU LPM3-ban alszik.
+ * A feladatok idztse csszsmentes (next += period), a felbonts
+ * egy tick (kb. 5 ms).
+ *
+ * Felttelek:
+ *  - a tick_init() a Timer_A hasznlatba vtele eltt hvand
+ *  - SMCLK = TICK_SMCLK (alaprtelmezs CLOCK_HZ) a kalibrlskor
+ *  - a WDT megszaktsi vektor ez a modul
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef TICK_H
+#define TICK_H
+
+#include "stdint.h"
+#include "clock.h"
+
+#ifndef TICK_SMCLK
+#define TICK_SMCLK     CLOCK_HZ        //SMCLK frekvencija a kalibrlskor
+#endif
+#ifndef TICK_VLO_HZ
+#define TICK_VLO_HZ    12000UL         //Nvleges VLO frekvencia (kalibrls eltt)
+#endif
+
+typedef struct {
+  void (*fn)(void);                    //A feladat eljrsa
+  uint16_t period;                     //Peridusid (ms)
+  uint16_t next;                       //A kvetkez futs ideje (ms)
+} tick_task_t;
+
+//--- Egy feladat bejegyzse: eljrs, peridus ms-ban ----------------
+#define TICK_TASK(fn,period)  { (fn), (period), 0 }
+
+void tick_init(void);
+uint16_t tick_ms(void);
+void sleep_ms(uint16_t ms);
+void tick_run(tick_task_t *p_tasks, uint8_t n);
+
+#endif
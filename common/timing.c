@@ -0,0 +1,22 @@
+/**********************************************************************
+ *  timing.c
+ *
+ * Ksleltet eljrsok (tevkeny vrakozs).
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "timing.h"
+
+/**------------------------------------------------------------
+ *   Ksleltet eljrs (1 - 65535 ms)
+ *-------------------------------------------------------------
+ * delay - a ksleltets ms egysgben megadva
+ */
+void delay_ms(uint16_t delay) {
+  uint16_t i;
+  for(i=0; i<delay; i++) {             //"delay"-szer ismteljk
+    __delay_cycles(TIMING_MCLK/1000);  //1 ms ksleltets
+  }
+}
@@ -0,0 +1,22 @@
+/**********************************************************************
+ *  timing.h
+ *
+ * Ksleltet eljrsok. A ciklusonknti vrakozs az MCLK
+ * frekvencijtl fgg, ezt a TIMING_MCLK makrval adhatjuk meg.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef TIMING_H
+#define TIMING_H
+
+#include "stdint.h"
+#include "clock.h"
+
+#ifndef TIMING_MCLK
+#define TIMING_MCLK   CLOCK_HZ         //MCLK frekvencija (Hz)
+#endif
+
+void delay_ms(uint16_t delay);
+
+#endif
@@ -0,0 +1,152 @@
+/**********************************************************************
+ *  usci_uart.c
+ *
+ * Megszaktsos hardveres UART ad az USCI_A0 modullal (MSP430G2553).
+ * Az UCA0TXIE megszakts csak addig engedlyezett, amg a krbufferben
+ * van kikldend bjt: az utols bjt tadsa utn a megszakts
+ * kiszolgl maga tiltja le, jabb berskor a usci_uart_write()
+ * engedlyezi ismt (az UCA0TXIFG ekkor mr ll, a megszakts azonnal
+ * bekvetkezik). Az USCIAB0TX vektor az USCI_B0-val kzs, itt csak
+ * az UCA0 adjt kezeljk.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include "io430.h"
+#include "usci_uart.h"
+#include "isr.h"
+
+#define TXD        BIT2                 //UCA0TXD a P1.2 lbon
+#define TXBUF_MASK (USCI_UART_TXBUF_SIZE - 1)
+
+static char tx_buf[USCI_UART_TXBUF_SIZE]; //Adsi krbuffer
+static volatile uint8_t tx_head;        //rsi index (fprogram)
+static volatile uint8_t tx_tail;        //Olvassi index (megszakts)
+static volatile uint8_t tx_wait;        //A fprogram LPM0-ban vr
+
+/**------------------------------------------------------------
+ *   Az USCI_A0 inicializlsa UART mdban
+ *-------------------------------------------------------------
+ * Formtum: 8 adatbit, nincs parits, USCI_UART_STOPBITS stop bit,
+ * rajel: SMCLK, az oszt s a modulci fordtskor szmolva.
+ */
+void usci_uart_init(void) {
+  UCA0CTL1 = UCSSEL_2 | UCSWRST;       //Lellts a bellts idejre, SMCLK
+#if USCI_UART_STOPBITS > 1
+  UCA0CTL0 = UCSPB;                    //8 bit, nincs parits, 2 stop bit
+#else
+  UCA0CTL0 = 0;                        //8 bit, nincs parits, 1 stop bit
+#endif
+  UCA0BR0 = (uint8_t)(USCI_UART_BR & 0xFF);
+  UCA0BR1 = (uint8_t)(USCI_UART_BR >> 8);
+  UCA0MCTL = (uint8_t)(USCI_UART_BRS << 1); //UCBRSx, UCOS16 = 0
+  P1SEL |= TXD;                        //P1.2 legyen UCA0TXD
+  P1SEL2 |= TXD;
+  tx_head = tx_tail = 0;
+  tx_wait = 0;
+  UCA0CTL1 &= ~UCSWRST;                //Az USCI indtsa
+  __enable_interrupt();
+}
+
+/**------------------------------------------------------------
+ *  Adatok bersa az adsi bufferbe (nem blokkol)
+ *-------------------------------------------------------------
+ * p_buf - a kikldend adatok cme
+ * len - a kikldend bjtok szma
+ * Visszatrsi rtk: a bufferbe tnylegesen bert bjtok szma
+ */
+uint8_t usci_uart_write(const char *p_buf, uint8_t len) {
+  uint8_t n, next;
+  for (n = 0; n < len; n++) {
+    next = (tx_head + 1) & TXBUF_MASK;
+    if (next == tx_tail) break;        //Megtelt a buffer
+    tx_buf[tx_head] = p_buf[n];
+    tx_head = next;
+  }
+  if (n) IE2 |= UCA0TXIE;              //Az ad elindtsa (ha mg llt)
+  return n;
+}
+
+/**------------------------------------------------------------
+ *   Egy karakter kikldse (tele buffer esetn LPM0-ban vr)
+ *-------------------------------------------------------------
+ * c - a kikldeni kvnt karakter kdja
+ */
+void usci_uart_putc(char c) {
+  __disable_interrupt();
+  while (!usci_uart_write(&c, 1)) {
+    tx_wait = 1;
+    __low_power_mode_0();              //Alvs, amg hely szabadul fel
+    __disable_interrupt();
+  }
+  __enable_interrupt();
+}
+
+/**------------------------------------------------------------
+ *  Karakterfzr kirsa a soros portra
+ *-------------------------------------------------------------
+ * p_str - karakterfzr mutat (nullval lezrt stringre mutat)
+ */
+void usci_uart_puts(const char *p_str) {
+  char c;
+  while ((c = *p_str)) {
+    usci_uart_putc(c);
+    p_str++;
+  }
+}
+
+/**------------------------------------------------------------
+ *  Vrakozs az ads vgig
+ *-------------------------------------------------------------
+ * A buffer kirlsig LPM0-ban alszunk, az utols (mr az USCI
+ * lptetregiszterben lev) bjtot az UCBUSY jelzn vrjuk ki.
+ */
+void usci_uart_flush(void) {
+  __disable_interrupt();
+  while (tx_head != tx_tail) {
+    tx_wait = 1;
+    __low_power_mode_0();              //Alvs a buffer kirlsig
+    __disable_interrupt();
+  }
+  __enable_interrupt();
+  while (UCA0STAT & UCBUSY);           //Legfeljebb egy karakterid
+}
+
+/**------------------------------------------------------------
+ *  Lekrdezs: folyamatban van-e mg ads?
+ *-------------------------------------------------------------*/
+uint8_t usci_uart_busy(void) {
+  return (tx_head != tx_tail) || (UCA0STAT & UCBUSY);
+}
+
+/**------------------------------------------------------------
+ *  breszts krse, ha hely szabadul fel a bufferben
+ *-------------------------------------------------------------
+ * Letiltott megszaktsok mellett, az LPM0 alvs eltt kell hvni
+ * (mint a sw_uart_tx_wake() eljrst).
+ * Visszatrsi rtk: 1 = az ad felbreszt, 0 = res a buffer, nem
+ * bresztene (ilyenkor nem szabad elaludni)
+ */
+uint8_t usci_uart_wake(void) {
+  if (tx_head == tx_tail) return 0;
+  tx_wait = 1;
+  return 1;
+}
+
+//----------------------------------------------------------------------
+// USCI_A0 TX megszakts: a kvetkez bjt tadsa az UCA0TXBUF-nak
+//----------------------------------------------------------------------
+ISR(USCIAB0TX_VECTOR, USCIAB0TX_ISR)
+{
+  if (tx_tail != tx_head) {
+    UCA0TXBUF = tx_buf[tx_tail];       //Az UCA0TXIFG is trldik
+    tx_tail = (tx_tail + 1) & TXBUF_MASK;
+  }
+  if (tx_tail == tx_head) {
+    IE2 &= ~UCA0TXIE;                  //Nincs tbb adat: megszakts tiltsa
+  }
+  if (tx_wait) {                       //Hely szabadult fel (vagy kirlt)
+    tx_wait = 0;
+    __low_power_mode_off_on_exit();
+  }
+}
@@ -0,0 +1,92 @@
+/**********************************************************************
+ *  usci_uart.h
+ *
+ * Megszaktsos hardveres UART ad az USCI_A0 modullal (MSP430G2553).
+ * A kikldend karakterek egy krbufferbe kerlnek, a bjtokat az
+ * USCIAB0TX megszakts adja t az UCA0TXBUF regiszternek. Bjtonknt
+ * egyetlen rvid megszakts kell, gy 115200 baud is elrhet mr
+ * 1 MHz-es rajelnl, a CPU pedig kzben LPM0 mdban alhat.
+ *
+ * Kivezets: UCA0TXD = P1.2 (a Launchpad TXD/RXD tktseit "HW"
+ * llsba kell tenni). A G2231 s a G2452 nem tartalmaz USCI_A modult,
+ * ott a sw_uart (bit banging) vagy a sw_uart_tx (Timer_A) hasznlhat.
+ *
+ *  USCI_UART_BAUD       - adatsebessg (alaprtelmezs: 115200)
+ *  USCI_UART_STOPBITS   - stop bitek szma (1 vagy 2)
+ *  USCI_UART_TXBUF_SIZE - adsi buffer mrete (2 hatvnya!)
+ *
+ * Az osztt alacsony frekvencis mdban (UCOS16 = 0) szmoljuk:
+ * UCBRx = N = SMCLK/BAUD egsz rsze, a trtrszt az UCBRSx modulci
+ * ptolja (egyes bitek egy ratssel hosszabbak). A modulcis minta
+ * nem egyenletes, ezrt az UCBRSx nem egyszeren a trtrsz * 8: a
+ * tblzat minden trtrszhez a legkisebb bitl-hibt ad rtket
+ * vlasztja (1 MHz, 115200 baud: UCBRx = 8, UCBRSx = 6, mint a
+ * felhasznli kziknyv tblzatban). Ellenrzs minden rajel s
+ * adatsebessg prra: tools/uart_timing_check.c (ctest)
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef USCI_UART_H
+#define USCI_UART_H
+
+#include "stdint.h"
+#include "clock.h"
+
+#ifndef USCI_UART_SMCLK
+#define USCI_UART_SMCLK      CLOCK_HZ  //Az USCI rajele: SMCLK (Hz)
+#endif
+#ifndef USCI_UART_BAUD
+#define USCI_UART_BAUD       115200UL  //Adatsebessg (bit/s)
+#endif
+#ifndef USCI_UART_STOPBITS
+#define USCI_UART_STOPBITS   1         //Stop bitek szma (1 vagy 2)
+#endif
+#ifndef USCI_UART_TXBUF_SIZE
+#define USCI_UART_TXBUF_SIZE 32        //Adsi buffer mrete (2 hatvnya!)
+#endif
+
+//--- Az oszt (N = SMCLK/BAUD) 1/32 egysgekben, kerektve -----------
+#define USCI_UART_N32  ((32 * USCI_UART_SMCLK + USCI_UART_BAUD/2) / USCI_UART_BAUD)
+#define USCI_UART_F32  (USCI_UART_N32 & 31)       //A trtrsz (0..31)
+
+//--- UCBRSx a trtrsz szerint: az a modulci, amelynl a keret
+//--- bitleinek legnagyobb eltrse a legkisebb (8: UCBRx + 1, UCBRSx = 0)
+#if   USCI_UART_F32 < 4
+#define USCI_UART_MOD  0
+#elif USCI_UART_F32 < 7
+#define USCI_UART_MOD  1
+#elif USCI_UART_F32 < 11
+#define USCI_UART_MOD  2
+#elif USCI_UART_F32 < 14
+#define USCI_UART_MOD  3
+#elif USCI_UART_F32 < 18
+#define USCI_UART_MOD  4
+#elif USCI_UART_F32 < 21
+#define USCI_UART_MOD  5
+#elif USCI_UART_F32 < 25
+#define USCI_UART_MOD  6
+#elif USCI_UART_F32 < 29
+#define USCI_UART_MOD  7
+#else
+#define USCI_UART_MOD  8
+#endif
+
+#define USCI_UART_BR   ((USCI_UART_N32 >> 5) + (USCI_UART_MOD >> 3)) //UCA0BR1:UCA0BR0
+#define USCI_UART_BRS  (USCI_UART_MOD & 7)        //UCA0MCTL UCBRSx mezje
+
+//--- Legalbb 8 rats bitenknt: a bitl hibja (legfeljebb egy
+//--- rats) gy a bitid 12,5%-a alatt marad
+#if USCI_UART_BR < 8
+#error "USCI_UART_BAUD: ehhez az rajelhez tl nagy adatsebessg (USCI)"
+#endif
+
+void usci_uart_init(void);
+uint8_t usci_uart_write(const char *p_buf, uint8_t len);
+void usci_uart_putc(char c);
+void usci_uart_puts(const char *p_str);
+void usci_uart_flush(void);
+uint8_t usci_uart_busy(void);
+uint8_t usci_uart_wake(void);
+
+#endif
@@ -0,0 +1,201 @@
+/**********************************************************************
+ *  calib_check.c
+ *
+ * Gazdagpes ellenrzs: a calib_init() (common/calib.c) mestersges
+ * TLV kpekkel. A kp felptse a G2553-val egyezik: ellenrzsszeg,
+ * res blokk (0xFE), ADC10 kalibrcis blokk (0x10, 16 bjt), res
+ * blokk, DCO kalibrcis blokk (0x01, 8 bjt).
+ *
+ * Esetek:
+ *  - hibtlan kp, klnbz ersts-, ofszet- s referenciahibkkal:
+ *    a kalibrlt egytthatk mind az 1024 kdra a lebegpontos
+ *    kplettl (SLAU144) legfeljebb 1 LSB-vel (mV, 0,1 C) trnek el
+ *  - egy bjtjban elrontott kp: CALIB_BAD_CHECKSUM
+ *  - ADC10 blokk nlkli, illetve tl rvid ADC10 blokkot tartalmaz
+ *    kp: CALIB_NO_ADC_TAG
+ *  - a DCO blokk utn ll ADC10 blokk is megtallhat
+ *  - a TLV terleten tllg blokkhossz (0xFE, rvnyes
+ *    ellenrzsszeggel) az elejn, illetve az ADC10 blokkban: a
+ *    keress lell, CALIB_NO_ADC_TAG
+ *  - hasznlhatatlan hmr pontok (T85 <= T30): a hmr nvleges marad
+ * Hiba esetn a nvleges egytthatknak kell rvnyben maradniuk.
+ *
+ * Hasznlat:
+ *   calib_check     (eltrs esetn kirja, s 1-es kddal ll le)
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "calib.h"
+
+#define TAG_EMPTY  0xFE                //res terlet
+#define TAG_DCO    0x01                //DCO kalibrci (8 bjt)
+
+//--- Az ADC10 blokk szavai (SLAU144 sorrend) ---------------------------
+typedef struct {
+  uint16_t gain, offset, fref15, t30_15, t85_15, fref25, t30_25, t85_25;
+} adc_cal_t;
+
+static int n_fail;
+
+/*-------------------------------------------------------------
+ * TLV kp sszelltsa: a blokkok a 2. bjttl, a maradk res,
+ * vgl az ellenrzsszeg (a szavak XOR-jnak kettes komplemense)
+ *-------------------------------------------------------------*/
+static uint8_t *tlv_block(uint8_t *p, uint8_t tag, uint8_t len, const uint16_t *p_w) {
+  uint8_t i;
+  p[0] = tag;
+  p[1] = len;
+  for (i = 0; i < len / 2; i++) {
+    p[2 + 2*i] = p_w ? p_w[i] & 0xFF : 0xFF;
+    p[3 + 2*i] = p_w ? p_w[i] >> 8 : 0xFF;
+  }
+  return p + 2 + len;
+}
+
+static void tlv_checksum(uint8_t *p_tlv) {
+  uint16_t chk = 0;
+  int i;
+  for (i = 2; i < CALIB_TLV_SIZE; i += 2) chk ^= p_tlv[i] | (p_tlv[i+1] << 8);
+  chk = -chk;
+  p_tlv[0] = chk & 0xFF;
+  p_tlv[1] = chk >> 8;
+}
+
+static void tlv_build(uint8_t *p_tlv, const adc_cal_t *p_cal, uint8_t adc_len, int dco_first) {
+  static const uint16_t dco[4] = { 0x8F95, 0x8E9D, 0x8D92, 0x86A6 };
+  uint8_t *p = p_tlv + 2;
+  memset(p_tlv, 0xFF, CALIB_TLV_SIZE);
+  if (dco_first) {
+    p = tlv_block(p, TAG_DCO, 8, dco);
+    p = tlv_block(p, TAG_EMPTY, 14, 0);
+  } else {
+    p = tlv_block(p, TAG_EMPTY, 22, 0);
+  }
+  if (p_cal) p = tlv_block(p, CALIB_TAG_ADC10_1, adc_len, &p_cal->gain);
+  else p = tlv_block(p, TAG_EMPTY, 16, 0);
+  if (dco_first) {
+    tlv_block(p, TAG_EMPTY, (uint8_t)(p_tlv + CALIB_TLV_SIZE - p - 2), 0);
+  } else {
+    p = tlv_block(p, TAG_EMPTY, 8, 0);
+    tlv_block(p, TAG_DCO, 8, dco);
+  }
+  tlv_checksum(p_tlv);
+}
+
+/*-------------------------------------------------------------
+ * Egy egytthatkszlet s a lebegpontos kplet sszevetse
+ *-------------------------------------------------------------*/
+static void check_mv(const char *name, const conv_t *p_conv, double full,
+                     const adc_cal_t *p_cal, uint16_t fref) {
+  double x, ref, d, dmax = 0;
+  int code;
+  for (code = 0; code < 1024; code++) {
+    x = conv_apply(p_conv, (uint16_t)code);
+    ref = code * (double)p_cal->gain / 32768.0;
+    if (fref) ref = ref * fref / 32768.0;
+    ref = (ref + (int16_t)p_cal->offset) * full / 1023.0;
+    d = fabs(x - floor(ref));
+    if (d > dmax) dmax = d;
+  }
+  if (dmax > 1.0) n_fail++;
+  printf("%s  %-14s legnagyobb elteres %.0f mV\n", dmax > 1.0 ? "HIBA" : "    ", name, dmax);
+}
+
+static void check_temp(const char *name, const conv_t *p_conv, uint16_t t30, uint16_t t85) {
+  double x, ref, d, dmax = 0;
+  int code;
+  for (code = 0; code < 1024; code++) {
+    x = conv_apply(p_conv, (uint16_t)code);
+    ref = (code - (double)t30) * 550.0 / (t85 - t30) + 300.0;
+    d = fabs(x - floor(ref + 0.5));
+    if (d > dmax) dmax = d;
+  }
+  if (dmax > 1.0) n_fail++;
+  printf("%s  %-14s legnagyobb elteres %.0f (0,1 C)\n", dmax > 1.0 ? "HIBA" : "    ", name, dmax);
+}
+
+/*-------------------------------------------------------------
+ * Az egytthatk a nvlegesek?
+ *-------------------------------------------------------------*/
+static int same(const conv_t *a, const conv_t *b) {
+  return a->k == b->k && a->b == b->b && a->s == b->s;
+}
+
+static int nominal_mv(void) {
+  return same(&cal_mv_ref1_5v, &conv_mv_ref1_5v) && same(&cal_mv_ref2_5v, &conv_mv_ref2_5v)
+      && same(&cal_mv_vcc, &conv_mv_vcc);
+}
+
+static int nominal_temp(void) {
+  return same(&cal_temp_ref1_5v, &conv_temp_ref1_5v)
+      && same(&cal_temp_ref2_5v, &conv_temp_ref2_5v);
+}
+
+static void expect(const char *name, int ok) {
+  if (!ok) n_fail++;
+  printf("%s  %s\n", ok ? "    " : "HIBA", name);
+}
+
+int main(void) {
+  //                          gain    offset  fref15  t30   t85   fref25  t30   t85
+  static const adc_cal_t cals[] = {
+    { 0x8000, 0,      0x8000, 0x2F8, 0x370, 0x8000, 0x1C9, 0x211 }, //Idelis
+    { 0x7F3A, 3,      0x8021, 0x2F2, 0x36B, 0x7FA5, 0x1C6, 0x20E }, //Jellemz
+    { 0x8215, 0xFFF8, 0x7E10, 0x2E0, 0x35C, 0x8190, 0x1BA, 0x203 }, //Nagy hibk
+    { 0x7C00, 0xFFFF, 0x83C0, 0x300, 0x380, 0x7D80, 0x1D0, 0x218 }
+  };
+  uint8_t tlv[CALIB_TLV_SIZE];
+  adc_cal_t c;
+  unsigned i;
+  uint8_t res;
+  for (i = 0; i < sizeof(cals) / sizeof(cals[0]); i++) {
+    const adc_cal_t *p = &cals[i];
+    printf("TLV %u: gain 0x%04X offset %d fref 0x%04X/0x%04X\n", i, p->gain,
+           (int16_t)p->offset, p->fref15, p->fref25);
+    tlv_build(tlv, p, 16, i & 1);
+    res = calib_init(tlv);
+    expect("calib_init() = CALIB_OK", res == CALIB_OK);
+    check_mv("mv_ref1_5v", &cal_mv_ref1_5v, 1500, p, p->fref15);
+    check_mv("mv_ref2_5v", &cal_mv_ref2_5v, 2500, p, p->fref25);
+    check_mv("mv_vcc", &cal_mv_vcc, 3500, p, 0);
+    check_temp("temp_ref1_5v", &cal_temp_ref1_5v, p->t30_15, p->t85_15);
+    check_temp("temp_ref2_5v", &cal_temp_ref2_5v, p->t30_25, p->t85_25);
+  }
+  printf("Hibas TLV kepek:\n");
+  tlv_build(tlv, &cals[1], 16, 0);
+  tlv[30] ^= 0x04;                     //Egy bit hiba az ADC10 blokkban
+  expect("elrontott bajt: CALIB_BAD_CHECKSUM, nevleges ertekek",
+         calib_init(tlv) == CALIB_BAD_CHECKSUM && nominal_mv() && nominal_temp());
+  tlv_build(tlv, &cals[1], 16, 0);
+  tlv[0] ^= 0x01;                      //Az ellenrzsszeg hibs
+  expect("hibas ellenorzoosszeg: CALIB_BAD_CHECKSUM",
+         calib_init(tlv) == CALIB_BAD_CHECKSUM && nominal_mv());
+  tlv_build(tlv, 0, 16, 0);
+  expect("nincs ADC10 blokk: CALIB_NO_ADC_TAG, nevleges ertekek",
+         calib_init(tlv) == CALIB_NO_ADC_TAG && nominal_mv() && nominal_temp());
+  tlv_build(tlv, &cals[1], 12, 0);
+  expect("rovid ADC10 blokk (12 bajt): CALIB_NO_ADC_TAG",
+         calib_init(tlv) == CALIB_NO_ADC_TAG && nominal_mv());
+  tlv_build(tlv, &cals[1], 16, 0);
+  tlv[3] = 0xFE;                       //Az els blokk hossza tllg
+  tlv_checksum(tlv);
+  expect("tullogo blokkhossz (0xFE): CALIB_NO_ADC_TAG, nevleges ertekek",
+         calib_init(tlv) == CALIB_NO_ADC_TAG && nominal_mv() && nominal_temp());
+  tlv_build(tlv, &cals[1], 16, 0);
+  tlv[2 + 2 + 22 + 1] = 0xFE;          //Az ADC10 blokk hossza tllg
+  tlv_checksum(tlv);
+  expect("tullogo ADC10 blokk (0xFE): CALIB_NO_ADC_TAG",
+         calib_init(tlv) == CALIB_NO_ADC_TAG && nominal_mv());
+  c = cals[1];
+  c.t85_15 = c.t30_15;                 //Hasznlhatatlan hmr pontok
+  c.t30_25 = 0x400;
+  tlv_build(tlv, &c, 16, 1);
+  expect("hasznalhatatlan homero pontok: CALIB_OK, nevleges homero",
+         calib_init(tlv) == CALIB_OK && nominal_temp() && !nominal_mv());
+  printf("calib_check: %d hiba\n", n_fail);
+  return n_fail ? 1 : 0;
+}
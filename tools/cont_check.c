@@ -0,0 +1,253 @@
+/**********************************************************************
+ *  cont_check.c
+ *
+ * Gazdagpes ellenrzs: az adc10_cont modul (common/adc10_cont.c)
+ * ktblokkos DTC bufferkezelse, a DTC modelljvel (tools/mock_io.c).
+ *
+ * A DTC modell mintnknt a kvetkez szt rja a bufferbe (a mintk
+ * rtke a sorszmuk), a flbuffer megtelsekor belltja az ADC10B1
+ * bitet (1: az els blokk telt meg), a buffer vgn trli s ellrl
+ * kezdi, s blokkonknt ADC10 megszaktst kr.
+ *
+ * Esetek (blokkmret: 1, 7, 10, 32 sz):
+ *  - ADC_cont_poll() minden blokk utn: a blokkok felvltva a buffer
+ *    kt felbl jnnek, a mintasor hzagmentes, nincs tlcsorduls
+ *  - a visszaadott blokkot a DTC ndat-1 tovbbi mintn t nem rja
+ *    fell (ennyi ideje van a feldolgozsnak), az ndat. minta utn igen
+ *  - ADC_cont_get(): alvs (LPM0) a blokk vgig, blokkonknt egy
+ *    breds
+ *  - hrom blokk feldolgozs nlkl: ADC_cont_overruns = 2, a poll a
+ *    legutbbi blokkot adja
+ *  - csatolt sor (ADC_cont_attach): a megszakts minden blokkot a
+ *    sorba tesz, a queue_get() + ADC_cont_block() ugyanazt a hzagmentes
+ *    sort adja, LPM0-ban blokkonknt egy breds; hrom blokk
+ *    feldolgozs nlkl: a kt rgebbi elavult (ADC_cont_overruns = 2),
+ *    t blokknl a sor is megtelik (overruns = 2)
+ *  - ADC_cont_stop(): a DTC, az ADC s a referencia lell
+ *
+ * Hasznlat:
+ *   cont_check     (eltrs esetn kirja, s 1-es kddal ll le)
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "mock_io.h"
+#include "adc10_cont.h"
+
+#define NMAX     32                    //A legnagyobb vizsglt blokkmret
+#define NBLOCKS  50                    //Ennyi blokkot figyelnk esetenknt
+
+static uint16_t buf[2*NMAX + 1];       //A ktblokkos buffer + rsz
+static uint16_t seq;                   //A kvetkez minta rtke
+static uint8_t idx;                    //A DTC rsi helye
+static uint8_t irq_pending;            //ADC10IFG (a GIE mg tiltott)
+
+/*-------------------------------------------------------------
+ * A DTC modellje: egy konverzi eredmnynek tvitele
+ *-------------------------------------------------------------*/
+static void dtc_sample(void) {
+  uint8_t ndat = mock_reg8[EMU_ADC10DTC1];
+  if (irq_pending && mock_irq(ADC10_VECTOR)) irq_pending = 0;
+  if (!(mock_reg16[EMU_ADC10CTL0] & ENC)
+      || (mock_reg8[EMU_ADC10DTC0] & (ADC10TB | ADC10CT)) != (ADC10TB | ADC10CT)) return;
+  buf[idx++] = seq++;
+  if (idx == ndat) {
+    mock_reg8[EMU_ADC10DTC0] |= ADC10B1;  //Az els blokk telt meg
+  } else if (idx == 2*ndat) {
+    mock_reg8[EMU_ADC10DTC0] &= ~ADC10B1; //A msodik
+    idx = 0;
+  } else {
+    return;
+  }
+  if (mock_reg16[EMU_ADC10CTL0] & ADC10IE) {
+    irq_pending = 1;
+    if (mock_irq(ADC10_VECTOR)) irq_pending = 0;
+  }
+}
+
+static void dtc_run(unsigned n) {
+  while (n--) dtc_sample();
+}
+
+/*-------------------------------------------------------------
+ * Mrs indtsa: a modell is ellrl kezdi
+ *-------------------------------------------------------------*/
+static void start(uint8_t ndat) {
+  mock_reset();
+  memset(buf, 0xEE, sizeof(buf));
+  seq = 0;
+  idx = 0;
+  irq_pending = 0;
+  ADC_cont_start_REF1_5V_TA(INCH_5, buf, ndat);
+  CHECK(mock_reg8[EMU_ADC10DTC1] == ndat, "ADC10DTC1 = %d (%d)", mock_reg8[EMU_ADC10DTC1], ndat);
+  CHECK((mock_reg16[EMU_ADC10CTL0] & (ENC | ADC10IE | REFON)) == (ENC | ADC10IE | REFON),
+         "ADC10CTL0 = 0x%04X", mock_reg16[EMU_ADC10CTL0]);
+}
+
+/*-------------------------------------------------------------
+ * Egy kapott blokk ellenrzse: helye s tartalma
+ *-------------------------------------------------------------*/
+static void check_block(const uint16_t *p, uint8_t ndat, unsigned k, uint16_t first) {
+  uint8_t i;
+  CHECK(p == buf + (k & 1) * ndat, "blokk %d: rossz felbuffer (%d)", (int)k, (int)(p - buf));
+  for (i = 0; i < ndat; i++) {
+    if (p[i] != (uint16_t)(first + i)) {
+      CHECK(0, "blokk %d: hezag a %d. mintanal", (int)k, i);
+      break;
+    }
+  }
+}
+
+/*-------------------------------------------------------------
+ * Csatolt sor: a megszakts a sorba teszi a blokkokat
+ *-------------------------------------------------------------*/
+QUEUE_DEFINE(blocks,4);
+
+static const uint16_t *next_block(unsigned k) {
+  queue_item_t item;
+  if (!queue_get(&blocks, &item)) {
+    CHECK(0, "sor: nincs blokk (%d. blokk)", (int)k);
+    return 0;
+  }
+  CHECK(item.stamp == k + 1, "sor: a %d. blokk idobelyege %d", (int)k, item.stamp);
+  return ADC_cont_block(&item);
+}
+
+static void run_queue(uint8_t ndat) {
+  const uint16_t *p;
+  uint16_t copy[NMAX];
+  queue_item_t item;
+  unsigned k;
+//--- Feldolgozs a kvetkez blokk alatt
+  queue_init(&blocks, blocks_items, 4);
+  ADC_cont_attach(&blocks);
+  start(ndat);
+  for (k = 0; k < NBLOCKS; k++) {
+    dtc_run(ndat);
+    CHECK(ADC_cont_poll() == 0, "sor: a poll is blokkot ad");
+    p = next_block(k);
+    if (!p) break;
+    check_block(p, ndat, k, (uint16_t)(k * ndat));
+    memcpy(copy, p, ndat * sizeof(uint16_t));
+    dtc_run(ndat - 1);
+    CHECK(!memcmp(copy, p, ndat * sizeof(uint16_t)), "sor: a %d. blokkot a DTC felulirta", (int)k);
+    dtc_run(1);
+    CHECK(ADC_cont_block(&(queue_item_t){ k & 1, (uint16_t)(k + 1) }) == 0,
+          "sor: a %d. blokk a kovetkezo utan is ervenyes", (int)k);
+    p = next_block(k + 1);
+    if (p) check_block(p, ndat, k + 1, (uint16_t)((k + 1) * ndat));
+    k++;
+  }
+  CHECK(ADC_cont_overruns == NBLOCKS / 2, "sor: ADC_cont_overruns = %d (%d)",
+        ADC_cont_overruns, NBLOCKS / 2);
+//--- Vrakozs LPM0-ban, amg a sor res
+  start(ndat);
+  queue_init(&blocks, blocks_items, 4);
+  mock_idle = dtc_sample;
+  for (k = 0; k < NBLOCKS; k++) {
+    __disable_interrupt();
+    while (!queue_count(&blocks)) {
+      __low_power_mode_0();
+      __disable_interrupt();
+    }
+    __enable_interrupt();
+    p = next_block(k);
+    if (p) check_block(p, ndat, k, (uint16_t)(k * ndat));
+  }
+  CHECK(mock_wakes == NBLOCKS, "sor: ebredesek: %d (%d)", (int)mock_wakes, NBLOCKS);
+  CHECK(ADC_cont_overruns == 0, "sor: ADC_cont_overruns = %d (%d)", ADC_cont_overruns, 0);
+  mock_idle = 0;
+//--- Hrom blokk feldolgozs nlkl: csak a legutbbi rvnyes
+  start(ndat);
+  queue_init(&blocks, blocks_items, 4);
+  dtc_run(3 * ndat);
+  CHECK(next_block(0) == 0 && next_block(1) == 0, "sor: elavult blokk ervenyes");
+  p = next_block(2);
+  if (p) check_block(p, ndat, 2, (uint16_t)(2 * ndat));
+  else CHECK(0, "sor: a legutobbi blokk sem ervenyes");
+  CHECK(ADC_cont_overruns == 2, "sor: ADC_cont_overruns = %d (%d)", ADC_cont_overruns, 2);
+//--- t blokk: a sorban hrom fr el
+  start(ndat);
+  queue_init(&blocks, blocks_items, 4);
+  dtc_run(5 * ndat);
+  CHECK(blocks.overruns == 2 && queue_count(&blocks) == 3, "sor: overruns = %d, %d elem",
+        blocks.overruns, queue_count(&blocks));
+  while (queue_get(&blocks, &item)) ADC_cont_block(&item);
+  CHECK(ADC_cont_overruns == 3, "sor: ADC_cont_overruns = %d (%d)", ADC_cont_overruns, 3);
+  ADC_cont_stop();
+  ADC_cont_attach(0);
+}
+
+static void run(uint8_t ndat) {
+  const uint16_t *p;
+  uint16_t copy[NMAX];
+  unsigned k;
+  int fail0 = mock_fail;
+//--- Lekrdezs minden blokk utn, feldolgozs a kvetkez blokk alatt
+  start(ndat);
+  CHECK(ADC_cont_poll() == 0, "poll: blokk a meres elott");
+  for (k = 0; k < NBLOCKS; k++) {
+    dtc_run(ndat);
+    p = ADC_cont_poll();
+    if (!p) {
+      CHECK(0, "poll: nincs blokk (%d. blokk)", (int)k);
+      break;
+    }
+    check_block(p, ndat, k, (uint16_t)(k * ndat));
+    CHECK(ADC_cont_poll() == 0, "poll: ugyanaz a blokk ketszer (%d)", (int)k);
+    memcpy(copy, p, ndat * sizeof(uint16_t));
+    dtc_run(ndat - 1);                 //A feldolgozs ideje: ndat-1 minta
+    CHECK(!memcmp(copy, p, ndat * sizeof(uint16_t)), "blokk %d: a DTC felulirta (ndat %d)", (int)k, ndat);
+    dtc_run(1);                        //A kvetkez blokk ksz
+    p = ADC_cont_poll();
+    check_block(p, ndat, k + 1, (uint16_t)((k + 1) * ndat));
+    k++;
+  }
+  CHECK(ADC_cont_blocks == NBLOCKS, "ADC_cont_blocks = %d (%d)", ADC_cont_blocks, NBLOCKS);
+  CHECK(ADC_cont_overruns == 0, "ADC_cont_overruns = %d (%d)", ADC_cont_overruns, 0);
+  CHECK(buf[2*ndat] == 0xEEEE, "a DTC a bufferen kivulre irt (ndat %d)", ndat);
+//--- Vrakozs LPM0-ban: a modell az alvs alatt jr
+  start(ndat);
+  mock_idle = dtc_sample;
+  for (k = 0; k < NBLOCKS; k++) {
+    p = ADC_cont_get();
+    check_block(p, ndat, k, (uint16_t)(k * ndat));
+  }
+  CHECK(mock_wakes == NBLOCKS, "ebredesek: %d (%d)", (int)mock_wakes, NBLOCKS);
+  CHECK(ADC_cont_overruns == 0, "ADC_cont_overruns = %d (%d)", ADC_cont_overruns, 0);
+  mock_idle = 0;
+//--- Tlcsorduls: hrom blokk feldolgozs nlkl
+  start(ndat);
+  dtc_run(3 * ndat);
+  p = ADC_cont_poll();
+  CHECK(ADC_cont_overruns == 2, "ADC_cont_overruns = %d (%d)", ADC_cont_overruns, 2);
+  CHECK(ADC_cont_blocks == 3, "ADC_cont_blocks = %d (%d)", ADC_cont_blocks, 3);
+  if (p) check_block(p, ndat, 2, (uint16_t)(2 * ndat));
+  else CHECK(0, "poll: nincs blokk a tulcsordulas utan");
+  dtc_run(ndat);
+  p = ADC_cont_poll();
+  if (p) check_block(p, ndat, 3, (uint16_t)(3 * ndat));
+  CHECK(ADC_cont_overruns == 2, "ADC_cont_overruns = %d (%d)", ADC_cont_overruns, 2);
+//--- Csatolt sor
+  run_queue(ndat);
+//--- Lellts
+  start(ndat);
+  ADC_cont_stop();
+  CHECK(!(mock_reg16[EMU_ADC10CTL0] & (ENC | ADC10IE | ADC10ON | REFON)),
+         "leallitas: ADC10CTL0 = 0x%04X", mock_reg16[EMU_ADC10CTL0]);
+  CHECK(mock_reg8[EMU_ADC10DTC0] == 0, "leallitas: ADC10DTC0 = 0x%02X", mock_reg8[EMU_ADC10DTC0]);
+  k = seq;
+  dtc_run(2 * ndat);
+  CHECK(seq == k, "leallitas utan is %d minta (ndat %d)", seq - (int)k, ndat);
+  printf("%s  ndat %2d: %d blokk, poll, get (LPM0), tulcsordulas, sor, leallitas\n",
+         mock_fail == fail0 ? "    " : "HIBA", ndat, NBLOCKS);
+}
+
+int main(void) {
+  static const uint8_t sizes[] = { 1, 7, 10, NMAX };
+  unsigned i;
+  for (i = 0; i < sizeof(sizes); i++) run(sizes[i]);
+  return mock_summary("cont_check");
+}
@@ -0,0 +1,93 @@
+/**********************************************************************
+ *  conv_check.c
+ *
+ * Gazdagpes ellenrzs: a conv_apply() (common/convert.c) minden
+ * egytthatkszlett a mintaprogramok korbbi, osztsos kpleteivel
+ * veti ssze mind az 1024 kdra, a conv_apply_os() eredmnyt pedig
+ * ugyanezek tlmintavtelezett (10+n bites kdra ltalnostott)
+ * vltozatval, n = 1 - CONV_OS_NMAX.
+ *
+ * A hmr kpleteit eljelesen, lefel kerektve szmoljuk: a korbbi
+ * (uint32_t)data*1762L - 711030L alak negatv eredmnynl krbefordul.
+ *
+ * Hasznlat:
+ *   conv_check [-v]     (-v: minden eltr kd kirsa)
+ * Trs: 1 LSB. Nagyobb eltrsnl a kdot kirja, s 1-es kddal
+ * ll le. Kszletenknt kirja a legnagyobb eltrst s azt, hogy
+ * hny kdnl nem pontos az eredmny.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "convert.h"
+
+//--- Egy egytthatkszlet s a korbbi kplete ----------------------
+//--- mV: code * mul / div, hmr: (code * mul - sub) >> sh ------------
+typedef struct {
+  const char *name;
+  const conv_t *p_conv;
+  long long mul, div, sub;
+  int sh;
+} conv_ref_t;
+
+static const conv_ref_t refs[] = {
+  { "mv_ref1_5v",   &conv_mv_ref1_5v,   1500, 1023, 0, 0 },
+  { "mv_ref2_5v",   &conv_mv_ref2_5v,   2500, 1023, 0, 0 },
+  { "mv_vcc",       &conv_mv_vcc,       3500, 1023, 0, 0 },
+  { "vdd_ref2_5v",  &conv_vdd_ref2_5v,  5000, 1023, 0, 0 },
+  { "temp_ref1_5v", &conv_temp_ref1_5v, 270687, 0, 182023932, 16 },
+  { "temp_ref2_5v", &conv_temp_ref2_5v, 1762, 0, 711030, 8 },
+  { "temp_vcc",     &conv_temp_vcc,     2467, 0, 711030, 8 }
+};
+#define NREFS  (sizeof(refs) / sizeof(refs[0]))
+
+/*-------------------------------------------------------------
+ * Lefel kerekt oszts (a >> negatv szmokra is gy mkdik)
+ *-------------------------------------------------------------*/
+static long long floor_div(long long a, long long b) {
+  long long q = a / b;
+  if ((a % b) && ((a < 0) != (b < 0))) q--;
+  return q;
+}
+
+/*-------------------------------------------------------------
+ * A korbbi kplet eredmnye egy (10+n bites) kdra
+ *-------------------------------------------------------------*/
+static long long reference(const conv_ref_t *p, long code, int n) {
+  if (p->div) return floor_div(code * p->mul, p->div << n);
+  return floor_div(code * p->mul - (p->sub << n), 1LL << (p->sh + n));
+}
+
+int main(int argc, char *argv[]) {
+  unsigned i;
+  int n, verbose;
+  long code, ncode, n_fail = 0;
+  verbose = argc > 1 && !strcmp(argv[1], "-v");
+  for (i = 0; i < NREFS; i++) {
+    for (n = 0; n <= CONV_OS_NMAX; n++) {
+      long long d, dmax = 0;
+      long n_off = 0;
+      ncode = 1024L << n;
+      for (code = 0; code < ncode; code++) {
+        long long r = reference(&refs[i], code, n);
+        long long x = n ? conv_apply_os(refs[i].p_conv, (uint16_t)code, (uint8_t)n)
+                        : conv_apply(refs[i].p_conv, (uint16_t)code);
+        d = x - r;
+        if (d < 0) d = -d;
+        if (d > dmax) dmax = d;
+        if (d) n_off++;
+        if (d > 1 || (d && verbose)) {
+          printf("%s%s n=%d kod %ld: %lld / %lld\n", d > 1 ? "HIBA " : "",
+                 refs[i].name, n, code, x, r);
+        }
+        if (d > 1) n_fail++;
+      }
+      printf("%-13s n=%d: %6ld kod, legnagyobb elteres %lld LSB, %ld kod nem pontos\n",
+             refs[i].name, n, ncode, dmax, n_off);
+    }
+  }
+  printf("conv_check: %ld hiba\n", n_fail);
+  return n_fail ? 1 : 0;
+}
@@ -0,0 +1,186 @@
+/**********************************************************************
+ *  decim_check.c
+ *
+ * Gazdagpes ellenrzs: a tlmintavtelezs (decimate(), common/stat.c)
+ * sszegzjnek bitnvekedse s tlcsordulsi hatra, valamint a
+ * dither (common/dither.c) hatsa a felbontsra.
+ *
+ * Esetek:
+ *  - bitnvekeds: 4^n * 1023 minta sszege 10+2n bit, n bittel
+ *    jobbra lptetve az eredmny 10+n bites; csupa 1023 esetn
+ *    pontosan 1023 * 2^n (n = 0 - STAT_OS_NMAX)
+ *  - tlcsorduls: a 16 bites sszegz (n <= 3) a legrosszabb esetben
+ *    is elg, n >= 4 esetn nem (ezrt 32 bites ott az sszegz);
+ *    a decimate() eredmnye vletlen s szlssges blokkokra is
+ *    megegyezik a 64 bites, felfel kerekt referencival
+ *  - dither: a DITHER_PIN kimenetet a TIMER0_A0 megszakts
+ *    DITHER_PERIOD mintnknt kapcsolja (mintnknt kt CCR0 esemny),
+ *    az RC tagot integrtorral modellezzk (hromszgjel, 1 LSB
+ *    cscstl cscsig). Zajmentes, 1 LSB-n bell lassan vltoz
+ *    jelre dither nlkl a decimlt rtk hibja 2^(n-1) LSB-ig n,
+ *    ditherrel legfeljebb DITH_TOL(n) LSB marad (a (10+n) bites
+ *    eredmny egysgben). A hromszgjel peridusonknt 8 szintet
+ *    vesz fel (1/8 LSB lpssel), gy a hiba legfeljebb 1/16 LSB a
+ *    10 bites egysgben: n = 5-nl ez 2 LSB.
+ *
+ * Hasznlat:
+ *   decim_check [-v]     (-v: a dither mrs minden pontja)
+ * Eltrs esetn kirja, s 1-es kddal ll le.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "mock_io.h"
+#include "stat.h"
+#include "dither.h"
+
+#define NMAX         OS_NSAMPLES(STAT_OS_NMAX)
+#define DITH_PP      1.0               //A dither cscstl cscsig (LSB)
+#define DITH_STEPS   64                //A jel trtrsznek lpsei
+#define DITH_TOL(n)  ((n) < 5 ? 1.0 : 2.0) //Trs ditherrel (10+n bites LSB)
+
+static uint16_t buf[NMAX];
+static int verbose;
+
+/*-------------------------------------------------------------
+ * Referencia: az sszeg 64 biten, n bittel lptetve, felfel kerektve
+ *-------------------------------------------------------------*/
+static uint32_t reference(const uint16_t *p, uint8_t n) {
+  unsigned long long sum = 0;
+  unsigned i;
+  for (i = 0; i < OS_NSAMPLES(n); i++) sum += p[i];
+  return n ? (uint32_t)((sum + (1ULL << (n - 1))) >> n) : (uint32_t)sum;
+}
+
+static void check_block(const char *name, uint8_t n) {
+  uint32_t r = reference(buf, n);
+  uint16_t x = decimate(buf, n);
+  CHECK(x == r, "%s n=%u: decimate %u, referencia %lu", name, n, x, (unsigned long)r);
+  CHECK(r < (1UL << (10 + n)), "%s n=%u: %lu nem fer el %u biten", name, n,
+        (unsigned long)r, 10 + n);
+}
+
+/*-------------------------------------------------------------
+ * Bitnvekeds s tlcsorduls
+ *-------------------------------------------------------------*/
+static void check_growth(void) {
+  uint8_t n;
+  unsigned i, r;
+  srand(1);
+  for (n = 0; n <= STAT_OS_NMAX; n++) {
+    unsigned long worst = OS_NSAMPLES(n) * 1023UL;
+    int fits16 = worst <= 0xFFFF;
+    CHECK(fits16 == (n <= 3), "n=%u: a legnagyobb osszeg %lu, a 16 bites osszegzo %s", n,
+          worst, n <= 3 ? "nem eleg" : "eleg lenne");
+    for (i = 0; i < OS_NSAMPLES(n); i++) buf[i] = 1023;
+    check_block("teljes skala", n);
+    CHECK(decimate(buf, n) == 1023U << n, "n=%u: teljes skala %u (%u)", n,
+          decimate(buf, n), 1023U << n);
+    for (i = 0; i < OS_NSAMPLES(n); i++) buf[i] = 0;
+    check_block("nulla", n);
+    for (i = 0; i < OS_NSAMPLES(n); i++) buf[i] = (i & 1) ? 1023 : 1022;
+    check_block("1022/1023", n);
+    for (r = 0; r < 2000; r++) {
+      unsigned base = rand() % 1024, w = rand() % 8;
+      for (i = 0; i < OS_NSAMPLES(n); i++) {
+        unsigned v = base + rand() % (w + 1);
+        buf[i] = (uint16_t)(v > 1023 ? 1023 : v);
+      }
+      check_block("veletlen", n);
+    }
+    printf("      n=%u: %4u minta, osszeg <= %7lu (%2u bit), eredmeny <= %5u (%2u bit), "
+           "osszegzo %s bites\n", n, OS_NSAMPLES(n), worst, 10 + 2*n, 1023U << n,
+           10 + n, fits16 ? "16" : "32");
+  }
+}
+
+/*-------------------------------------------------------------
+ * A dither modellje: a DITHER_PIN szintje (a TIMER0_A0 megszakts
+ * kapcsolja) az RC tagon t hromszgjelet ad a bemeneten
+ *-------------------------------------------------------------*/
+static double dith;                    //A dither pillanatnyi rtke (LSB)
+
+static uint16_t adc_sample(double v, int use_dither) {
+  double x;
+  if (use_dither) {
+    mock_irq(TIMER0_A0_VECTOR);        //Mintnknt kt CCR0 esemny
+    mock_irq(TIMER0_A0_VECTOR);
+    dith += (mock_reg8[EMU_P1OUT] & DITHER_PIN ? 1 : -1) * DITH_PP / (DITHER_PERIOD / 2);
+  }
+  x = floor(v + dith + 0.5);           //Zajmentes kvantls
+  return (uint16_t)(x < 0 ? 0 : x > 1023 ? 1023 : x);
+}
+
+static double dither_error(uint8_t n, int use_dither) {
+  unsigned i, s;
+  double v, e, emax = 0, m = 0;
+  mock_reset();
+  dith = 0;
+  if (use_dither) {
+    mock_sr = GIE;
+    dither_init();
+    CHECK(mock_reg8[EMU_P1DIR] & DITHER_PIN, "dither_init: a DITHER_PIN nem kimenet");
+    for (i = 0; i < DITHER_PERIOD; i++) { //Egy peridus: az tlag legyen 0
+      adc_sample(0, 1);
+      m += dith;
+    }
+    dith -= m / DITHER_PERIOD;
+  }
+  for (s = 0; s < DITH_STEPS; s++) {
+    v = 511.0 + (double)s / DITH_STEPS;
+    for (i = 0; i < OS_NSAMPLES(n); i++) buf[i] = adc_sample(v, use_dither);
+    e = fabs(decimate(buf, n) - v * (1 << n));
+    if (e > emax) emax = e;
+    if (verbose) printf("        n=%u %s v=%.4f: %u (%.2f)\n", n,
+                        use_dither ? "dither" : "nincs ", v, decimate(buf, n), v * (1 << n));
+  }
+  if (use_dither) {
+    dither_stop();
+    CHECK(!(mock_reg8[EMU_P1OUT] & DITHER_PIN) && !(mock_reg16[EMU_TACCTL0] & CCIE),
+          "dither_stop: a kimenet vagy a CCR0 megszakitas nem allt le");
+  }
+  return emax;
+}
+
+static void check_dither(void) {
+  uint8_t n;
+  unsigned i, k, hi;
+  uint8_t pin, last;
+  double e0, e1;
+//--- A kimenet DITHER_PERIOD/2 mintnknt vlt (a peridus DITHER_PERIOD)
+  mock_reset();
+  mock_sr = GIE;
+  dither_init();
+  for (i = k = hi = 0, last = 0; i < 8 * DITHER_PERIOD; i++) {
+    mock_irq(TIMER0_A0_VECTOR);
+    mock_irq(TIMER0_A0_VECTOR);
+    pin = mock_reg8[EMU_P1OUT] & DITHER_PIN;
+    if (pin) hi++;
+    k++;                               //Mintk az elz vlts ta
+    if (pin != last) {
+      CHECK(k == DITHER_PERIOD / 2, "dither: valtas %u minta utan (%u)", k, DITHER_PERIOD / 2);
+      k = 0;
+      last = pin;
+    }
+  }
+  CHECK(hi == 4 * DITHER_PERIOD, "dither: kitoltes %u/%u minta", hi, 8 * DITHER_PERIOD);
+  for (n = 2; n <= STAT_OS_NMAX; n++) {
+    e0 = dither_error(n, 0);
+    e1 = dither_error(n, 1);
+    CHECK(e1 <= DITH_TOL(n), "n=%u: hiba ditherrel %.2f LSB (tures %.0f)", n, e1, DITH_TOL(n));
+    CHECK(e0 >= (1 << (n - 1)) - 1, "n=%u: dither nelkul is csak %.2f LSB a hiba", n, e0);
+    printf("      n=%u: legnagyobb hiba dither nelkul %5.2f LSB, ditherrel %4.2f LSB (%u bites LSB)\n",
+           n, e0, e1, 10 + n);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  verbose = argc > 1 && !strcmp(argv[1], "-v");
+  check_growth();
+  check_dither();
+  return mock_summary("decim_check");
+}
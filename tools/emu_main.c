@@ -0,0 +1,124 @@
+/**********************************************************************
+ *  emu_main.c
+ *
+ * A mintaprogramok gazdagpes futtatja (common/emu): a parancssori
+ * belltsok utn a mintaprogram main() eljrst hvja, amelyet a
+ * fordtskor emu_main-re neveznk t (-Dmain=emu_main, CMake).
+ *
+ * Hasznlat:
+ *   <minta>-emu [-t s] [-a CH=jel]... [-n mV] [-V mV] [-T C] [-l Hz]
+ *               [-x] [-b baud] [-r szveg] [-R s] [-S mag] [-q]
+ *   -t  a futs hossza virtulis idben (alaprtelmezs: 1 s)
+ *   -a  az ADC10 CH csatornjnak jele (mV), a jel lehet:
+ *         1200                 lland
+ *         ramp:0:3300:10       frszjel 0-tl 3300 mV-ig, 10 s peridus
+ *         sine:1650:1000:2     1650 mV +/- 1000 mV, 2 Hz
+ *   -n  Gauss zaj minden analg bemeneten (mV, RMS)
+ *   -V  tpfeszltsg (mV, alaprtelmezs: 3300), -T a chip hmrsklete
+ *   -l  a VLO frekvencija (alaprtelmezs: 12000 Hz), -x 32768 Hz-es
+ *       kristly van az LFXT1-en
+ *   -b  a TXD (P1.1) dekdols s az RXD (P1.2) adatsebessge
+ *   -r  ezt a szveget kldjk az RXD lbra (\r, \n megengedett),
+ *       -R msodperc mlva (alaprtelmezs: 0,1 s)
+ *   -S  a zajgenertor kezdrtke, -q nincs sszests
+ * A dekdolt UART kimenet a szabvnyos kimenetre, az sszests
+ * (sebessg, alvsi arny, bredsek msodpercenknt, becslt tlagos
+ * ramfelvtel, konverzik, megszaktsok, kitlts) a
+ * szabvnyos hibakimenetre kerl. Pl.
+ *   4_adc_pwm2-emu -t 10 -a 5=ramp:0:3300:10 -n 3
+ *   4_adc_simple_ref1-emu -t 5 -a 5=750 -T 40
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "emu.h"
+
+#undef main                            //A mintaprogram emu_main lett
+void emu_main(void);
+
+/*-------------------------------------------------------------
+ * Egy -a CH=jel bellts feldolgozsa
+ *-------------------------------------------------------------*/
+static int parse_input(const char *s) {
+  emu_input_t *p;
+  char *e;
+  long ch;
+  ch = strtol(s, &e, 10);
+  if (e == s || *e != '=' || ch < 0 || ch >= EMU_NCHAN) return -1;
+  p = &emu_cfg.in[ch];
+  s = e + 1;
+  if (sscanf(s, "ramp:%lf:%lf:%lf", &p->a, &p->b, &p->c) == 3) {
+    p->kind = EMU_IN_RAMP;
+  } else if (sscanf(s, "sine:%lf:%lf:%lf", &p->a, &p->b, &p->c) == 3) {
+    p->kind = EMU_IN_SINE;
+  } else {
+    p->kind = EMU_IN_CONST;
+    p->a = strtod(s, &e);
+    if (e == s || *e) return -1;
+  }
+  return 0;
+}
+
+/*-------------------------------------------------------------
+ * Az RXD szveg: \r, \n, \t s \\ feloldsa
+ *-------------------------------------------------------------*/
+static char *unescape(const char *s) {
+  char *d, *p;
+  d = p = malloc(strlen(s) + 1);
+  if (!d) return 0;
+  while (*s) {
+    if (*s == '\\' && s[1]) {
+      s++;
+      *p++ = *s == 'r' ? '\r' : *s == 'n' ? '\n' : *s == 't' ? '\t' : *s;
+      s++;
+    } else {
+      *p++ = *s++;
+    }
+  }
+  *p = 0;
+  return d;
+}
+
+int main(int argc, char *argv[]) {
+  char top;                            //A verem teteje (DTC cmek)
+  int c;
+  while ((c = getopt(argc, argv, "t:a:n:V:T:l:xb:r:R:S:q")) != -1) {
+    switch (c) {
+    case 't': emu_cfg.t_end = atof(optarg); break;
+    case 'a':
+      if (parse_input(optarg)) {
+        fprintf(stderr, "Hibas analog bemenet: %s\n", optarg);
+        return 1;
+      }
+      break;
+    case 'n': emu_cfg.noise = atof(optarg); break;
+    case 'V': emu_cfg.vcc = atof(optarg); break;
+    case 'T': emu_cfg.temp = atof(optarg); break;
+    case 'l': emu_cfg.vlo = atof(optarg); break;
+    case 'x': emu_cfg.xtal = 1; break;
+    case 'b': emu_cfg.baud = strtoul(optarg, 0, 10); break;
+    case 'r': emu_cfg.rx_text = unescape(optarg); break;
+    case 'R': emu_cfg.rx_at = atof(optarg); break;
+    case 'S': emu_cfg.seed = strtoul(optarg, 0, 10); break;
+    case 'q': emu_cfg.quiet = 1; break;
+    default:
+      fprintf(stderr, "Hasznalat: %s [-t s] [-a CH=mV|ramp:a:b:T|sine:o:A:f]... "
+              "[-n mV] [-V mV] [-T C] [-l Hz] [-x] [-b baud] [-r szoveg] "
+              "[-R s] [-S mag] [-q]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (emu_cfg.t_end <= 0 || emu_cfg.vlo <= 0 || emu_cfg.baud == 0) {
+    fprintf(stderr, "Hibas -t, -l vagy -b ertek\n");
+    return 1;
+  }
+  setvbuf(stdout, NULL, _IOLBF, 0);    //Soronknt jelenjen meg
+  emu_start(&top);
+  emu_main();
+  emu_finish(0);                       //A main() visszatrt
+  return 0;
+}
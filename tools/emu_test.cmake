@@ -0,0 +1,56 @@
+# ---------------------------------------------------------------------
+#  emu_test.cmake
+#
+# Egy mintaprogram emullt futtatsa rgztett kapcsolkkal, s a
+# kimenet ellenrzse (ctest, lsd add_emu_test() a CMakeLists.txt-ben).
+# A dekdolt UART kimenet s az sszests egytt, \r nlkl kerl
+# sszevetsre.
+#
+# Vltozk (cmake -D...):
+#   EMU       a <minta>-emu program
+#   ARGS      a kapcsolk listja
+#   EXPECT    regulris kifejezsek, mindegyiknek illeszkednie kell
+#   REJECT    regulris kifejezsek, egyik sem illeszkedhet
+#   WAKE_MAX  az bredsek (LPM -> fprogram) fels korltja (1/s, ha adott)
+#
+# Hasznlat:
+#   cmake -DEMU=./4_uart_soft-emu "-DARGS=-t;2" "-DEXPECT=Hello" -P emu_test.cmake
+#
+#  I. Cserny
+#  MTA ATOMKI, Debrecen
+# ---------------------------------------------------------------------
+execute_process(COMMAND ${EMU} ${ARGS}
+    OUTPUT_VARIABLE out ERROR_VARIABLE err RESULT_VARIABLE rc TIMEOUT 60)
+string(REPLACE "\r" "" out "${out}${err}")
+message("${out}")
+set(fail 0)
+if(NOT rc EQUAL 0)
+  message("HIBA  a program kilepesi kodja: ${rc}")
+  math(EXPR fail "${fail} + 1")
+endif()
+foreach(re IN LISTS EXPECT)
+  if(NOT out MATCHES "${re}")
+    message("HIBA  nem talalhato: ${re}")
+    math(EXPR fail "${fail} + 1")
+  endif()
+endforeach()
+foreach(re IN LISTS REJECT)
+  if(out MATCHES "${re}")
+    message("HIBA  nem megengedett: ${CMAKE_MATCH_0}")
+    math(EXPR fail "${fail} + 1")
+  endif()
+endforeach()
+if(WAKE_MAX)
+  if(NOT out MATCHES "ebredes \\(LPM -> foprogram\\) ([0-9.]+)/s")
+    message("HIBA  nincs ebredesi adat az osszesitesben")
+    math(EXPR fail "${fail} + 1")
+  elseif(CMAKE_MATCH_1 GREATER WAKE_MAX)
+    message("HIBA  ebredes ${CMAKE_MATCH_1}/s (korlat ${WAKE_MAX}/s)")
+    math(EXPR fail "${fail} + 1")
+  endif()
+endif()
+get_filename_component(name "${EMU}" NAME)
+message("${name}: ${fail} hiba")
+if(fail)
+  message(FATAL_ERROR "${name}: a kimenet elter a vartol")
+endif()
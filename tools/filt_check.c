@@ -0,0 +1,160 @@
+/**********************************************************************
+ *  filt_check.c
+ *
+ * Gazdagpes ellenrzs: a szrk (common/filter.c) hlzati zavar
+ * elnyomsa decibelben, mestersges jelekkel.
+ *
+ * A bemenet egyenszint + szinuszos zavar (s felharmonikusai),
+ * 15 bites skln (mint a decimate() eredmnye), egszre kerektve.
+ * Az elnyoms: 20*log10(a zavar RMS rtke a bemeneten / a kimenet
+ * vltakoz sszetevjnek RMS rtke), a bells utni szakaszon,
+ * 16 vletlen kezdfzis tlagban. Az elmleti rtk:
+ *   mozgtlag (L):  |sin(pi*f*L/fs) / (L*sin(pi*f/fs))|
+ *   CIC (r, N-ed fok): a mozgtlag r hosszal, N-edik hatvnyon
+ *   IIR (2^-k):       a / |1 - (1-a)*exp(-j*2*pi*f/fs)|, a = 2^-k
+ * Felttel: ha az elmleti elnyoms 60 dB feletti (zrushely), a mrt
+ * legalbb 60 dB; egybknt legfeljebb 1 dB-lel tr el az elmlettl.
+ *
+ * Hasznlat:
+ *   filt_check     (eltrs esetn kirja, s 1-es kddal ll le)
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "filter.h"
+
+#define PI        3.14159265358979
+#define DC        16384.0              //Egyenszint (15 bites skla kzepe)
+#define AMP       8000.0               //A zavar amplitdja (LSB)
+#define T_RUN     20.0                 //Egy mrs hossza (s)
+#define NPHASE    16                   //Kezdfzisok szma
+#define NULL_DB   60.0                 //Zrushelyen legalbb ennyi
+#define TOL_DB    1.0                  //Egybknt ennyi eltrs az elmlettl
+
+enum { F_MA, F_CIC, F_IIR };
+
+typedef struct {
+  const char *name;
+  uint8_t kind;                        //F_MA, F_CIC vagy F_IIR
+  uint8_t par;                         //L, r vagy k
+  double fs;                           //Mintavteli frekvencia (Hz)
+  double f;                            //A zavar alapharmonikusa (Hz)
+  uint8_t nharm;                       //Felharmonikusokkal egytt (1: csak f)
+} filt_case_t;
+
+static const filt_case_t cases[] = {
+  { "MA 10, 50 Hz",          F_MA,  10, 500, 50.0,  1 },
+  { "MA 10, 50 Hz + 2., 3.", F_MA,  10, 500, 50.0,  3 },
+  { "MA 10, 49,5 Hz",        F_MA,  10, 500, 49.5,  1 },
+  { "MA 10, 50,5 Hz",        F_MA,  10, 500, 50.5,  1 },
+  { "MA 10, 60 Hz",          F_MA,  10, 500, 60.0,  1 },
+  { "MA 10 (600 Hz), 60 Hz", F_MA,  10, 600, 60.0,  3 },
+  { "MA 20, 50 Hz",          F_MA,  20, 500, 50.0,  1 },
+  { "CIC 10, 50 Hz",         F_CIC, 10, 500, 50.0,  1 },
+  { "CIC 10, 50 Hz + 2., 3.",F_CIC, 10, 500, 50.0,  3 },
+  { "CIC 10, 49,5 Hz",       F_CIC, 10, 500, 49.5,  1 },
+  { "CIC 10, 50,5 Hz",       F_CIC, 10, 500, 50.5,  1 },
+  { "CIC 10, 60 Hz",         F_CIC, 10, 500, 60.0,  1 },
+  { "CIC 50, 50 Hz",         F_CIC, 50, 500, 50.0,  3 },
+  { "IIR 4, 50 Hz",          F_IIR,  4, 500, 50.0,  1 },
+  { "IIR 6, 50 Hz",          F_IIR,  6, 500, 50.0,  1 },
+  { "IIR 6, 60 Hz",          F_IIR,  6, 500, 60.0,  1 }
+};
+#define NCASES  (sizeof(cases) / sizeof(cases[0]))
+
+/*-------------------------------------------------------------
+ * Elmleti tvitel egy frekvencin (abszolt rtk)
+ *-------------------------------------------------------------*/
+static double ma_gain(double f, double fs, int len) {
+  double d = len * sin(PI * f / fs);
+  return fabs(sin(PI * f * len / fs) / d);
+}
+
+static double gain(const filt_case_t *p, double f) {
+  double a, w;
+  switch (p->kind) {
+  case F_MA:
+    return ma_gain(f, p->fs, p->par);
+  case F_CIC:
+    return pow(ma_gain(f, p->fs, p->par), FILT_CIC_ORDER);
+  default:
+    a = 1.0 / (1 << p->par);
+    w = 2 * PI * f / p->fs;
+    return a / sqrt(1 - 2 * (1 - a) * cos(w) + (1 - a) * (1 - a));
+  }
+}
+
+/*-------------------------------------------------------------
+ * A zavar: alapharmonikus s felharmonikusok (1/h amplitdval)
+ *-------------------------------------------------------------*/
+static double tone(const filt_case_t *p, double t, const double *ph) {
+  double x = 0;
+  int h;
+  for (h = 1; h <= p->nharm; h++) x += AMP / h * sin(2 * PI * h * p->f * t + ph[h-1]);
+  return x;
+}
+
+/*-------------------------------------------------------------
+ * Egy eset mrse: a kimenet vltakoz sszetevjnek RMS rtke
+ *-------------------------------------------------------------*/
+static double measure(const filt_case_t *p) {
+  static uint16_t ma_buf[255];
+  filt_ma_t ma;
+  filt_cic_t cic;
+  filt_iir_t iir;
+  double ph[3], s, ss, rms_sum = 0;
+  long i, n, nskip, cnt;
+  uint16_t x, y;
+  int k, h;
+  n = (long)(T_RUN * p->fs);
+  nskip = p->kind == F_IIR ? 20L << p->par : 4L * p->par;  //Bells
+  for (k = 0; k < NPHASE; k++) {
+    for (h = 0; h < 3; h++) ph[h] = 2 * PI * rand() / RAND_MAX;
+    filt_ma_init(&ma, ma_buf, p->par);
+    filt_cic_init(&cic, p->par);
+    filt_iir_init(&iir, p->par, (uint16_t)DC);
+    s = ss = 0;
+    cnt = 0;
+    for (i = 0; i < n; i++) {
+      x = (uint16_t)floor(DC + tone(p, i / p->fs, ph) + 0.5);
+      if (p->kind == F_MA) y = filt_ma_put(&ma, x);
+      else if (p->kind == F_IIR) y = filt_iir_put(&iir, x);
+      else if (!filt_cic_put(&cic, x, &y)) continue;
+      if (i < nskip) continue;
+      s += y;
+      ss += (double)y * y;
+      cnt++;
+    }
+    s /= cnt;
+    rms_sum += sqrt(fmax(ss / cnt - s * s, 0));
+  }
+  return rms_sum / NPHASE;
+}
+
+int main(void) {
+  unsigned i;
+  int h, bad, n_fail = 0;
+  double rms_in, rms_out, g2, db, th;
+  srand(1);
+  printf("%-24s %10s %10s\n", "szuro, zavar", "elmelet", "mert");
+  for (i = 0; i < NCASES; i++) {
+    const filt_case_t *p = &cases[i];
+    rms_in = g2 = 0;
+    for (h = 1; h <= p->nharm; h++) {
+      rms_in += (AMP / h) * (AMP / h) / 2;
+      g2 += (AMP / h) * (AMP / h) / 2 * gain(p, h * p->f) * gain(p, h * p->f);
+    }
+    th = g2 > 0 ? 10 * log10(rms_in / g2) : 999;
+    rms_out = measure(p);
+    db = rms_out > 0 ? 20 * log10(sqrt(rms_in) / rms_out) : 999;
+    bad = th >= NULL_DB ? db < NULL_DB : fabs(db - th) > TOL_DB;
+    if (bad) n_fail++;
+    printf("%s%-24s %7.1f dB %7.1f dB\n", bad ? "HIBA " : "", p->name,
+           th > 200 ? INFINITY : th, db > 200 ? INFINITY : db);
+  }
+  printf("filt_check: %d hiba\n", n_fail);
+  return n_fail ? 1 : 0;
+}
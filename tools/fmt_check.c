@@ -0,0 +1,158 @@
+/**********************************************************************
+ *  fmt_check.c
+ *
+ * Gazdagpes ellenrzs: a fmt_dec() s fmt_hex4() (common/format.c)
+ * kimenett a mintaprogramok korbbi sw_uart_outdec() s
+ * sw_uart_out4hex() eljrsaival veti ssze. A korbbi eljrsok
+ * trzse vltozatlan (4_ADC_simple_ref1/main.c, a format modul
+ * bevezetse eltti llapot), a sw_uart_putc() itt egy bufferbe r.
+ *
+ * Esetek:
+ *  - fmt_dec(), ndigits = 0 - 9: 0, +/-1, +/-(2^31-1), minden
+ *    tzhatvny s szomszdai (+/-(10^k - 1), +/-10^k, +/-(10^k + 1)),
+ *    a -99999 - 99999 tartomny minden rtke s 100000 vletlen szm.
+ *    A korbbi kimenet furcsasgait (pl. ndigits = 0 esetn legalbb
+ *    kt szmjegy: " 00") is meg kell tartani.
+ *  - fmt_hex4(): mind a 65536 rtk
+ * A -2^31 nem szerepel: a korbbi eljrsban a -data tlcsordul.
+ *
+ * Hasznlat:
+ *   fmt_check     (eltrs esetn kirja, s 1-es kddal ll le)
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "format.h"
+
+#define NRAND     100000               //Vletlen szmok ndigits rtkenknt
+#define NSHOW     5                    //Legfeljebb ennyi eltrst runk ki
+
+static char out[32];                   //A korbbi eljrsok kimenete
+static uint8_t n_out;
+static long n_fail;
+
+static void sw_uart_putc(char c) {
+  if (n_out < sizeof(out) - 1) out[n_out++] = c;
+}
+
+//--- A korbbi eljrsok, vltozatlan trzzsel -----------------------
+
+/**------------------------------------------------------------
+ * Eljel nlkli egsz szm kirsa hexadecimlis formban
+ *-------------------------------------------------------------
+ * t - a kirand szm (uint16_t tpus)
+ */
+void sw_uart_out4hex(uint16_t t)
+{
+  char c;
+  c=(char)((t>>12) & 0x0F);
+  if (c>9) c+=7;
+  sw_uart_putc(c+'0');
+  c=(char)((t>>8) & 0x0F);
+  if (c>9) c+=7;
+  sw_uart_putc(c+'0');
+  c=(char)((t>>4) & 0x0F);
+  if (c>9) c+=7;
+  sw_uart_putc(c+'0');
+  c=(char)(t & 0x0F);
+  if (c>9) c+=7;
+  sw_uart_putc(c+'0');
+}
+
+/**------------------------------------------------------------
+ * Decimlis kirats adott szm tizedesjegyre.
+ *-------------------------------------------------------------
+ * data - a kirand szm (eljelesen)
+ * ndigits - a kirand tizedesek szma
+ */
+void sw_uart_outdec(int32_t data, uint8_t ndigits) {
+  static char sign, s[12];
+  int8_t i;
+  i=0; sign=' ';
+  if(data<0) {                         //Az eljel meghatrozsa
+    sign='-';
+    data = -data;
+  }
+    do {
+      s[i]=data%10 + '0';              //A szmjegyek meghatrozsa
+      data=data/10;                    //htulrl visszafel
+      i++;
+      if(i==ndigits) {s[i]='.'; i++;}  //A tizedespont beszrsa
+    } while(data>0 || i<(ndigits+2));
+    sw_uart_putc(sign);                //Az eljel kirsa
+    do {
+      sw_uart_putc(s[--i]);            //A szmjegyek kirsa
+    } while(i);
+}
+
+/*-------------------------------------------------------------
+ * Egy rtk sszevetse. Visszatrsi rtk: 1, ha eltr.
+ *-------------------------------------------------------------*/
+static int check_dec(int32_t data, uint8_t ndigits) {
+  char buf[FMT_DEC_SIZE];
+  uint8_t len;
+  n_out = 0;
+  sw_uart_outdec(data, ndigits);
+  out[n_out] = 0;
+  len = fmt_dec(buf, data, ndigits);
+  if (!strcmp(buf, out) && len == n_out) return 0;
+  if (++n_fail <= NSHOW) {
+    printf("HIBA fmt_dec(%ld, %u) = \"%s\" (%u), korabban \"%s\"\n", (long)data, ndigits, buf,
+           len, out);
+  }
+  return 1;
+}
+
+static int check_hex(uint16_t t) {
+  char buf[FMT_HEX_SIZE];
+  uint8_t len;
+  n_out = 0;
+  sw_uart_out4hex(t);
+  out[n_out] = 0;
+  len = fmt_hex4(buf, t);
+  if (!strcmp(buf, out) && len == n_out) return 0;
+  if (++n_fail <= NSHOW) {
+    printf("HIBA fmt_hex4(0x%04X) = \"%s\" (%u), korabban \"%s\"\n", t, buf, len, out);
+  }
+  return 1;
+}
+
+int main(void) {
+  static const int32_t edge[] = { 0, 1, -1, 2147483647L, -2147483647L };
+  int32_t v;
+  long long p;
+  long i, n, n_bad;
+  uint8_t nd;
+  int k;
+  srand(1);
+  for (nd = 0; nd <= 9; nd++) {
+    n = n_bad = 0;
+    for (i = 0; i < (long)(sizeof(edge) / sizeof(edge[0])); i++, n++) {
+      n_bad += check_dec(edge[i], nd);
+    }
+    for (k = 0, p = 1; k <= 9; k++, p *= 10) {  //Tzhatvnyok s szomszdaik
+      for (v = (int32_t)(p - 1); v <= p + 1; v++, n += 2) {
+        n_bad += check_dec(v, nd);
+        n_bad += check_dec(-v, nd);
+      }
+    }
+    for (v = -99999; v <= 99999; v++, n++) n_bad += check_dec(v, nd);
+    for (i = 0; i < NRAND; i++, n++) {
+      v = (int32_t)(((unsigned long)rand() << 16 ^ (unsigned long)rand() << 1 ^ rand()) & 0x7FFFFFFFUL);
+      n_bad += check_dec(i & 1 ? -v : v, nd);
+    }
+    n_out = 0;
+    sw_uart_outdec(0, nd);
+    out[n_out] = 0;
+    printf("%s  fmt_dec ndigits = %u: %7ld ertek, %ld elteres (0 -> \"%s\")\n",
+           n_bad ? "HIBA" : "    ", nd, n, n_bad, out);
+  }
+  n_bad = 0;
+  for (i = 0; i <= 0xFFFF; i++) n_bad += check_hex((uint16_t)i);
+  printf("%s  fmt_hex4: 65536 ertek, %ld elteres\n", n_bad ? "HIBA" : "    ", n_bad);
+  printf("fmt_check: %ld hiba\n", n_fail);
+  return n_fail ? 1 : 0;
+}
@@ -0,0 +1,134 @@
+/**********************************************************************
+ *  mock_io.c
+ *
+ * Regiszter-utnzat a hardverkzeli modulok gazdagpes ellenrzshez
+ * (lsd mock_io.h).
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mock_io.h"
+
+#define IDLE_MAX  10000000UL           //Ennyi mock_idle() utn nem bredt fel
+
+uint16_t mock_reg16[EMU_N16];
+uint8_t mock_reg8[EMU_N8];
+uint16_t mock_sr;
+unsigned long mock_cycles;
+unsigned long mock_wakes;
+void (*mock_hook16)(uint8_t r);
+void (*mock_hook8)(uint8_t r);
+void (*mock_idle)(void);
+int mock_fail;
+uint8_t emu_tlv[64];                   //(io430.h: CALIB_TLV_ADDR)
+static void (*vectors[16])(void);      //Az ISR() makr tlti ki (isr.h)
+static uint16_t sr_saved;              //A megszaktott program SR-je
+static uint8_t in_irq;
+
+/**------------------------------------------------------------
+ * Kiindul llapot: a regiszterek nullk, GIE trlve
+ *-------------------------------------------------------------*/
+void mock_reset(void) {
+  memset(mock_reg16, 0, sizeof(mock_reg16));
+  memset(mock_reg8, 0, sizeof(mock_reg8));
+  mock_sr = 0;
+  mock_cycles = 0;
+  mock_wakes = 0;
+  mock_hook16 = 0;
+  mock_hook8 = 0;
+  mock_idle = 0;
+}
+
+/**------------------------------------------------------------
+ * Megszakts kiszolglsa
+ *-------------------------------------------------------------
+ * vec - a vektor (pl. ADC10_VECTOR)
+ * Visszatrsi rtk: 1, ha lefutott; 0, ha a GIE trlt (a krs
+ * nem vsz el, a hv ksbb jra prblhatja), vagy nincs ISR
+ */
+int mock_irq(unsigned vec) {
+  void (*isr)(void) = vectors[(vec / 2) & 15];
+  if (!isr || !(mock_sr & GIE) || in_irq) return 0;
+  sr_saved = mock_sr;
+  mock_sr = 0;
+  in_irq = 1;
+  isr();
+  in_irq = 0;
+  mock_sr = sr_saved;                  //RETI: az (esetleg mdostott) SR
+  return 1;
+}
+
+/**------------------------------------------------------------
+ * sszests a program vgn
+ *-------------------------------------------------------------
+ * name - az ellenrz program neve
+ * Visszatrsi rtk: a kilpsi kd (1, ha volt hiba)
+ */
+int mock_summary(const char *name) {
+  printf("%s: %d hiba\n", name, mock_fail);
+  return mock_fail ? 1 : 0;
+}
+
+/*-------------------------------------------------------------
+ * emu/io430.h: regiszterelrs, vektorok
+ *-------------------------------------------------------------*/
+volatile uint16_t *emu_reg16(uint8_t r) {
+  if (mock_hook16) mock_hook16(r);
+  return &mock_reg16[r];
+}
+
+volatile uint8_t *emu_reg8(uint8_t r) {
+  if (mock_hook8) mock_hook8(r);
+  return &mock_reg8[r];
+}
+
+void emu_vector(unsigned vec, void (*isr)(void)) {
+  vectors[(vec / 2) & 15] = isr;
+}
+
+/*-------------------------------------------------------------
+ * Beptett fggvnyek
+ *-------------------------------------------------------------*/
+void __delay_cycles(unsigned long n) {
+  mock_cycles += n;
+}
+
+void __no_operation(void) {
+}
+
+void __enable_interrupt(void) {
+  mock_sr |= GIE;
+}
+
+void __disable_interrupt(void) {
+  mock_sr &= ~GIE;
+}
+
+unsigned short __get_interrupt_state(void) {
+  return mock_sr & GIE;
+}
+
+void __set_interrupt_state(unsigned short s) {
+  mock_sr = (mock_sr & ~GIE) | (s & GIE);
+}
+
+void __bis_SR_register(unsigned short bits) {
+  unsigned long n = 0;
+  mock_sr |= bits;
+  while (mock_sr & CPUOFF) {           //Alvs: csak a modell jr
+    if (!mock_idle || ++n > IDLE_MAX) {
+      fprintf(stderr, "mock_io: a CPU nem ebredt fel\n");
+      exit(2);
+    }
+    mock_idle();
+  }
+}
+
+void __bic_SR_register_on_exit(unsigned short bits) {
+  if (!in_irq) return;
+  if (sr_saved & bits & CPUOFF) mock_wakes++;
+  sr_saved &= ~bits;
+}
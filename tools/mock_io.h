@@ -0,0 +1,50 @@
+/**********************************************************************
+ *  mock_io.h
+ *
+ * Regiszter-utnzat a hardverkzeli modulok gazdagpes ellenrzshez
+ * (tools, *_check.c). A modulokat az emultor io430.h-jval fordtjuk
+ * (EMU_HOST, common/emu az include tvonal elejn), de az emu.c
+ * helyett ez a modul adja a regisztereket s a beptett fggvnyeket:
+ * a regiszterek egyszer trolk, mellkhatsuk nincs, a perifrit
+ * (DTC, Timer_A rgzts, WDT) az ellenrz program modellezi.
+ *
+ *  - mock_hook16/mock_hook8: minden regiszterelrs eltt lefut (ha
+ *    nem 0), gy a program pldul a jelzbiteket bellthatja
+ *  - mock_idle: alvs (LPM) kzben ismtelten hvdik, amg egy
+ *    megszakts (mock_irq) fel nem breszti a CPU-t; ez lpteti a
+ *    modell idejt
+ *  - mock_irq(vec): a modul ISR() eljrsnak futtatsa megszaktsknt
+ *    (GIE trlve, kilpskor az SR visszall, vagy a
+ *    __low_power_mode_off_on_exit() szerint mdosul)
+ *  - CHECK(ok, ...): felttel ellenrzse, hibnl "HIBA <szveg>" sor,
+ *    a hibkat a mock_fail szmolja; a program vgn mock_summary()
+ *    rja ki az sszestst, s adja a kilpsi kdot
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifndef MOCK_IO_H
+#define MOCK_IO_H
+
+#include <stdio.h>
+#include "io430.h"
+
+//--- Felttel ellenrzse: hiba esetn a megadott szveg kirsa ------
+#define CHECK(ok, ...)  do { if (!(ok)) { mock_fail++; printf("HIBA "); \
+                             printf(__VA_ARGS__); printf("\n"); } } while (0)
+
+extern uint16_t mock_reg16[EMU_N16];   //A regiszterek (emu/io430.h sorszmai)
+extern uint8_t mock_reg8[EMU_N8];
+extern uint16_t mock_sr;               //Sttuszregiszter (GIE, LPM bitek)
+extern unsigned long mock_cycles;      //__delay_cycles() sszesen
+extern unsigned long mock_wakes;       //bredsek (LPM -> fprogram)
+extern void (*mock_hook16)(uint8_t r);
+extern void (*mock_hook8)(uint8_t r);
+extern void (*mock_idle)(void);
+extern int mock_fail;                  //A nem teljeslt CHECK felttelek szma
+
+void mock_reset(void);
+int mock_irq(unsigned vec);
+int mock_summary(const char *name);
+
+#endif
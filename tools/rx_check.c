@@ -0,0 +1,262 @@
+/**********************************************************************
+ *  rx_check.c
+ *
+ * Gazdagpes ellenrzs: a szoftveres UART vev (common/sw_uart_rx.c)
+ * mestersges lsorozatokkal, a Timer_A CCR1 modelljvel
+ * (tools/mock_io.c). A megszaktst a sw_uart_tx.c kzs TIMER0_A1
+ * ISR-je adja tovbb a vevnek (SW_UART_RX), ahogy a clgpen.
+ *
+ * A modell az idt SMCLK temben szmolja; a TAR folytonos mdban az
+ * id 65536-tal, felfel szmll mdban (TACCR0+1)-gyel vett
+ * maradka. Rgzt mdban a CCR1 a vonal kvetkez lefut lre lp
+ * (TACCR1 = az l ideje), komparl mdban a TACCR1 idpontra, s
+ * az SCCI bit a vonal akkori szintje; ezutn TIMER0_A1 megszakts
+ * (TAIV = 2) jn.
+ *
+ * Esetek (256 bjt, 1 stop bit, 0 - 2 bitid sznettel):
+ *  - tiszta jel, folytonos s felfel szmll (TACCR0 = 999) md
+ *  - adatsebessg-eltrs (+/-2%) s lenknti jitter (+/-15%)
+ *  - tskk (0,3 bitid) a sznetekben: nem okoznak hibt
+ *  - keretezsi hibk (alacsony stop bit, 20 bitids break): a bjt
+ *    elvsz, a sw_uart_rx_errors pontosan ennyivel n, a tbbi p
+ *  - tlcsorduls: 10 bjt kiolvass nlkl, a bufferben 7 marad, a
+ *    hibaszm 3
+ *  - sw_uart_getc(): alvs (LPM0) a bjt vgig, bjtonknt egy
+ *    breds
+ *
+ * Hasznlat:
+ *   rx_check     (eltrs esetn kirja, s 1-es kddal ll le)
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "mock_io.h"
+#include "sw_uart_tx.h"
+#include "sw_uart_rx.h"
+
+#define BITTIME   ((double)SW_UART_SMCLK / SW_UART_BAUD) //Bitid (rats)
+#define NEDGES    8192                 //Az lsorozat legnagyobb hossza
+#define NBYTES    256                  //Bjtok esetenknt
+#define UP_PERIOD 1000                 //Felfel szmll md: TACCR0 + 1
+
+enum {                                 //Az esetek jelzbitjei
+  UP_MODE = 0x01,                      //Felfel szmll md
+  GLITCH  = 0x02,                      //Tskk a sznetekben
+  FRAMING = 0x04                       //Keretezsi hibk
+};
+
+typedef unsigned long long tick_t;
+
+static tick_t e_time[NEDGES];          //A vonal leinek ideje
+static uint8_t e_level[NEDGES];        //A vonal szintje az l utn
+static unsigned n_edges;
+static uint8_t line_last;              //Az utoljra bert szint
+static tick_t now;                     //A modell ideje (rats)
+
+/*-------------------------------------------------------------
+ * Az lsorozat sszelltsa (a vonal alaphelyzete magas)
+ *-------------------------------------------------------------*/
+static void line_reset(void) {
+  n_edges = 0;
+  line_last = 1;
+}
+
+static void line_set(double t, uint8_t level) {
+  if (level == line_last || n_edges == NEDGES) return;
+  e_time[n_edges] = (tick_t)(t + 0.5);
+  e_level[n_edges++] = level;
+  line_last = level;
+}
+
+//--- A vonal szintje t idpontban
+static uint8_t line_at(tick_t t) {
+  unsigned lo = 0, hi = n_edges;       //Az els l, amely t utn van
+  while (lo < hi) {
+    unsigned mid = (lo + hi) / 2;
+    if (e_time[mid] <= t) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo ? e_level[lo - 1] : 1;
+}
+
+static double jitter(double jit) {
+  return jit * BITTIME * (2.0 * rand() / RAND_MAX - 1);
+}
+
+/*-------------------------------------------------------------
+ * Egy keret: start bit, 8 adatbit, 1 stop bit (skew: a bitid
+ * relatv eltrse, jit: lenknti jitter bitidben)
+ * Visszatrsi rtk: a keret vge
+ *-------------------------------------------------------------*/
+static double frame(double t0, uint8_t c, double skew, double jit, uint8_t stop) {
+  double t = BITTIME * (1 + skew);
+  uint8_t k;
+  line_set(t0, 0);
+  for (k = 1; k <= 8; k++) line_set(t0 + k * t + jitter(jit), (c >> (k - 1)) & 1);
+  line_set(t0 + 9 * t + jitter(jit), stop);
+  line_set(t0 + 10 * t, 1);
+  return t0 + 10 * t;
+}
+
+/*-------------------------------------------------------------
+ * A Timer_A CCR1 modellje: a kvetkez esemny vgrehajtsa, ha
+ * legksbb 'until' idpontban van. Visszatrsi rtk: 1, ha volt.
+ *-------------------------------------------------------------*/
+static unsigned long period(void) {
+  return (mock_reg16[EMU_TACTL] & MC_3) == MC_1 ? mock_reg16[EMU_TACCR0] + 1UL : 65536UL;
+}
+
+static int rx_event(tick_t until) {
+  uint16_t cctl = mock_reg16[EMU_TACCTL1];
+  unsigned long p = period(), d;
+  unsigned i;
+  if (!(cctl & CCIE)) return 0;
+  if (cctl & CAP) {                    //Rgzts: a kvetkez lefut l
+    for (i = 0; i < n_edges && (e_time[i] <= now || e_level[i]); i++);
+    if (i == n_edges || e_time[i] > until) return 0;
+    now = e_time[i];
+    mock_reg16[EMU_TACCR1] = (uint16_t)(now % p);
+  } else {                             //Komparls: TAR == TACCR1
+    d = (mock_reg16[EMU_TACCR1] + p - now % p) % p;
+    if (!d) d = p;
+    if (now + d > until) return 0;
+    now += d;
+    if (line_at(now)) mock_reg16[EMU_TACCTL1] |= SCCI;
+    else mock_reg16[EMU_TACCTL1] &= ~SCCI;
+  }
+  mock_reg16[EMU_TAIV] = 2;            //CCR1 esemny
+  if (!mock_irq(TIMER0_A1_VECTOR)) {
+    CHECK(0, "TIMER0_A1: a megszakitas tiltva");
+    return 0;
+  }
+  return 1;
+}
+
+static void rx_run(double until) {     //Az ra az utols esemnynl marad
+  while (rx_event((tick_t)until));
+}
+
+//--- Alvs (LPM0) kzben: a kvetkez esemny
+static void idle(void) {
+  rx_event(~0ULL);
+}
+
+/*-------------------------------------------------------------
+ * Indts: Timer_A folytonos vagy felfel szmll mdban
+ *-------------------------------------------------------------*/
+static void start(uint8_t flags) {
+  mock_reset();
+  line_reset();
+  now = 0;
+  if (flags & UP_MODE) {               //Mr fut idzt (pl. ADC trigger)
+    mock_reg16[EMU_TACCR0] = UP_PERIOD - 1;
+    mock_reg16[EMU_TACTL] = TASSEL_2 | MC_1;
+  }
+  sw_uart_tx_init();
+  sw_uart_rx_init();
+  CHECK(mock_reg16[EMU_TACCTL1] & CAP, "sw_uart_rx_init: a CCR1 nem rogzito modban");
+}
+
+/*-------------------------------------------------------------
+ * Egy eset: 256 bjt, minden keret utn kiolvass
+ *-------------------------------------------------------------*/
+static void run(const char *name, double skew, double jit, uint8_t flags) {
+  static uint8_t sent[NBYTES], got[NBYTES + 8];
+  unsigned i, n_sent = 0, n_got = 0, n_bad = 0;
+  double t = 3 * BITTIME;
+  int fail0 = mock_fail;
+  char c;
+  start(flags);
+  srand(1);
+  for (i = 0; i < NBYTES; i++) {
+    uint8_t b = (uint8_t)(i * 167 + 13), stop = 1;
+    if ((flags & GLITCH) && i % 4 == 0) { //Tske, utna egy bitid sznet
+      line_set(t + BITTIME / 2, 0);
+      line_set(t + 0.8 * BITTIME, 1);
+      t += 2 * BITTIME;
+    }
+    if ((flags & FRAMING) && i % 16 == 5) stop = 0; //Alacsony stop bit
+    if ((flags & FRAMING) && i % 64 == 40) { //Break: 20 bitid alacsony szint
+      line_set(t, 0);
+      line_set(t + 20 * BITTIME, 1);
+      t += 21 * BITTIME;
+      rx_run(t);
+      n_bad++;
+    }
+    t = frame(t, b, skew, jit, stop);
+    if (stop) sent[n_sent++] = b;
+    else n_bad++;
+    t += BITTIME * (rand() % 3);       //Sznet: 0 - 2 bitid
+    rx_run(t);
+    while (n_got < NBYTES && sw_uart_rx_get(&c)) got[n_got++] = (uint8_t)c;
+  }
+  CHECK(n_got == n_sent, "%s: %u bajt jott (%u)", name, n_got, n_sent);
+  for (i = 0; i < n_got && i < n_sent; i++) {
+    if (got[i] != sent[i]) {
+      CHECK(0, "%s: a %u. bajt 0x%02X (0x%02X)", name, i, got[i], sent[i]);
+      break;
+    }
+  }
+  CHECK(sw_uart_rx_errors == n_bad, "%s: sw_uart_rx_errors = %u (%u)", name,
+        sw_uart_rx_errors, n_bad);
+  CHECK(n_edges < NEDGES, "%s: tul hosszu elsorozat", name);
+  printf("%s  %-40s %3u bajt, %2u hiba\n", mock_fail == fail0 ? "    " : "HIBA", name,
+         n_got, sw_uart_rx_errors);
+}
+
+/*-------------------------------------------------------------
+ * Tlcsorduls s sw_uart_getc()
+ *-------------------------------------------------------------*/
+static void run_overflow(void) {
+  double t = BITTIME;
+  unsigned i, n = 0;
+  int fail0 = mock_fail;
+  char c;
+  start(0);
+  for (i = 0; i < 10; i++) t = frame(t, (uint8_t)('A' + i), 0, 0, 1);
+  rx_run(t + BITTIME);
+  while (sw_uart_rx_get(&c)) {
+    CHECK(c == (char)('A' + n), "tulcsordulas: a %u. bajt '%c' ('%c')", n, c, 'A' + n);
+    n++;
+  }
+  CHECK(n == SW_UART_RXBUF_SIZE - 1, "tulcsordulas: %u bajt maradt (%u)", n,
+        SW_UART_RXBUF_SIZE - 1);
+  CHECK(sw_uart_rx_errors == 10 - n, "tulcsordulas: sw_uart_rx_errors = %u (%u)",
+        sw_uart_rx_errors, 10 - n);
+  printf("%s  %-40s %3u bajt, %2u hiba\n", mock_fail == fail0 ? "    " : "HIBA",
+         "tulcsordulas (10 bajt kiolvasas nelkul)", n, sw_uart_rx_errors);
+}
+
+static void run_getc(void) {
+  static const char msg[] = "ch 5\rrate 100\r";
+  double t = BITTIME;
+  unsigned i;
+  int fail0 = mock_fail;
+  char c;
+  start(UP_MODE);
+  for (i = 0; msg[i]; i++) t = frame(t, (uint8_t)msg[i], 0.01, 0.1, 1) + BITTIME;
+  mock_idle = idle;
+  for (i = 0; msg[i]; i++) {
+    c = sw_uart_getc();
+    CHECK(c == msg[i], "getc: a %u. bajt 0x%02X (0x%02X)", i, c, msg[i]);
+  }
+  CHECK(mock_wakes == i, "getc: %lu ebredes (%u)", mock_wakes, i);
+  CHECK(mock_sr & GIE, "getc: a megszakitasok tiltva maradtak");
+  printf("%s  %-40s %3u bajt, %2lu ebredes\n", mock_fail == fail0 ? "    " : "HIBA",
+         "sw_uart_getc (LPM0)", i, mock_wakes);
+}
+
+int main(void) {
+  run("tiszta, folytonos mod", 0, 0, 0);
+  run("tiszta, felfele szamlalo mod", 0, 0, UP_MODE);
+  run("+2% sebesseg, +/-15% jitter", 0.02, 0.15, 0);
+  run("-2% sebesseg, +/-15% jitter, felfele", -0.02, 0.15, UP_MODE);
+  run("tuskek, +/-10% jitter", 0, 0.10, GLITCH);
+  run("keretezesi hibak es break, felfele", 0.01, 0.05, FRAMING | UP_MODE);
+  run("tuskek es keretezesi hibak", -0.01, 0.10, GLITCH | FRAMING);
+  run_overflow();
+  run_getc();
+  return mock_summary("rx_check");
+}
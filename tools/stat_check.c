@@ -0,0 +1,98 @@
+/**********************************************************************
+ *  stat_check.c
+ *
+ * Gazdagpes ellenrzs: a stat_block() (common/stat.c) eredmnyeit
+ * lebegpontos referencival veti ssze, minden blokkmretre
+ * (2^STAT_K_MIN - 2^STAT_K_MAX) s tbbfle jelre: lland, a skla
+ * kt vge felvltva, frsz, lass szinusz zajjal, egyenletes zaj.
+ *
+ * Hasznlat:
+ *   stat_check [-v] [ismtls]   (alaprtelmezs: 1000 vletlen blokk
+ *                                  mretenknt, -v: minden blokk kirsa)
+ * Trs (1/16 LSB egysgben): min, max pontos; tlag 1/2; ngyzetes
+ * kzp 1; szrsngyzet 1 + 16/n (az S^2/n lefel kerektse); szrs
+ * a szrsngyzet trsbl. Eltrs esetn a blokkot kirja, s 1-es
+ * kddal ll le.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "stat.h"
+
+#define NMAX      (1 << STAT_K_MAX)
+
+static unsigned long n_blocks, n_fail;
+static int verbose;
+
+/*-------------------------------------------------------------
+ * Egy blokk ellenrzse a referencival
+ *-------------------------------------------------------------*/
+static void check(const char *name, const uint16_t *p_data, int k) {
+  stat_block_t st;
+  int i, n = 1 << k, lo = 1023, hi = 0, bad;
+  double sum = 0, sxx = 0, m2 = 0, mean, var, t_var, t_sd;
+  for (i = 0; i < n; i++) {
+    if (p_data[i] < lo) lo = p_data[i];
+    if (p_data[i] > hi) hi = p_data[i];
+    sum += p_data[i];
+    sxx += (double)p_data[i] * p_data[i];
+  }
+  mean = sum / n;
+  for (i = 0; i < n; i++) m2 += (p_data[i] - mean) * (p_data[i] - mean);
+  var = m2 / n;
+  stat_block(p_data, k, &st);
+  t_var = 1.0 + 16.0 / n;
+  t_sd = sqrt(256 * var + 16 * t_var) - sqrt(256 * var) + 1.0;
+  bad = st.min != lo || st.max != hi
+     || fabs(st.mean - 16 * mean) > 0.5
+     || fabs(st.var - 16 * var) > t_var
+     || fabs(st.sd - 16 * sqrt(var)) > t_sd
+     || fabs(st.rms - 16 * sqrt(sxx / n)) > 1.0;
+  n_blocks++;
+  if (bad) n_fail++;
+  if (bad || verbose) {
+    printf("%s%s n=%d: min %u/%d max %u/%d mean %u/%.2f var %lu/%.2f "
+           "sd %u/%.2f rms %u/%.2f\n", bad ? "HIBA " : "", name, n,
+           st.min, lo, st.max, hi, st.mean, 16 * mean,
+           (unsigned long)st.var, 16 * var, st.sd, 16 * sqrt(var),
+           st.rms, 16 * sqrt(sxx / n));
+  }
+}
+
+int main(int argc, char *argv[]) {
+  static uint16_t data[NMAX];
+  int i, k, r, reps = 1000;
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-v")) verbose = 1;
+    else reps = atoi(argv[i]);
+  }
+  srand(1);
+  for (k = STAT_K_MIN; k <= STAT_K_MAX; k++) {
+    int n = 1 << k;
+    for (i = 0; i < n; i++) data[i] = 0;
+    check("nulla", data, k);
+    for (i = 0; i < n; i++) data[i] = 1023;
+    check("teljes skala", data, k);
+    for (i = 0; i < n; i++) data[i] = (i & 1) ? 1023 : 0;
+    check("0/1023 felvaltva", data, k);
+    for (i = 0; i < n; i++) data[i] = (uint16_t)(i * 1023 / (n - 1));
+    check("fureszjel", data, k);
+    for (r = 0; r < reps; r++) {
+      double ph = rand() * 6.2832 / RAND_MAX, amp = rand() % 512;
+      int dc = 511 + rand() % 2 - 1;
+      for (i = 0; i < n; i++) {
+        int x = (int)floor(dc + amp * sin(ph + i * 0.05) + rand() % 5 - 2 + 0.5);
+        data[i] = (uint16_t)(x < 0 ? 0 : x > 1023 ? 1023 : x);
+      }
+      check("szinusz+zaj", data, k);
+      for (i = 0; i < n; i++) data[i] = (uint16_t)(rand() % 1024);
+      check("egyenletes zaj", data, k);
+    }
+  }
+  printf("stat_check: %lu blokk, %lu hiba\n", n_blocks, n_fail);
+  return n_fail ? 1 : 0;
+}
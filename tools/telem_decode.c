@@ -0,0 +1,110 @@
+/**********************************************************************
+ *  telem_decode.c
+ *
+ * Gazdagpes dekdol: a soros vonalrl rgztett binris mrsi
+ * kereteket (common/telem.h) CSV tblzatt alaktja.
+ *
+ * Hasznlat:
+ *   telem_decode [fjl]          (fjl nlkl a szabvnyos bemenetet olvassa)
+ *   pl. stty -F /dev/ttyACM0 9600 raw; telem_decode /dev/ttyACM0 > meres.csv
+ *
+ * Kimenet: "seq,A7,A6,A5" fejlc (a csatornamaszk minden vltozsakor
+ * jra), utna keretenknt egy sor a 10 bites ADC kdokkal.
+ * A vgn a szabvnyos hibakimenetre sszests kerl: p keretek,
+ * CRC hibk, kimaradt keretek (sorszm ugrs), hamis szinkronok,
+ * tlpett bjtok. Hibs keret utn a kvetkez szinkron bjttl
+ * folytatja. CRC hibnak csak az p keret utn kvetkez keret
+ * szmt; az jraszinkronizls kzben (s az els p keret eltt,
+ * pl. keret kzepn kezdd rgztsnl) az adatbjtok kztt tallt
+ * 0xA5 hamis szinkron, ez csak az sszestsben szerepel.
+ * Kilpsi kd: 1, ha volt CRC hiba.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "telem.h"
+
+#define BUFSIZE   256
+
+static unsigned long n_ok, n_crc, n_lost, n_false, n_skip;
+
+/*-------------------------------------------------------------
+ * Egy p keret kirsa CSV sorknt
+ *-------------------------------------------------------------*/
+static void print_frame(uint8_t seq, uint16_t mask, const uint16_t *p_data) {
+  static int have_mask = 0;
+  static uint16_t last_mask;
+  static uint8_t last_seq;
+  int k;
+  if (!have_mask || mask != last_mask) {  //j csatornakioszts: fejlc
+    printf("seq");
+    for (k = TELEM_NCHAN_MAX - 1; k >= 0; k--) {
+      if (mask & (1U << k)) printf(",A%d", k);
+    }
+    printf("\n");
+  } else {
+    n_lost += (uint8_t)(seq - last_seq - 1); //Sorszm ugrs
+  }
+  have_mask = 1;
+  last_mask = mask;
+  last_seq = seq;
+  printf("%u", seq);
+  for (k = telem_nchan(mask); k > 0; k--) printf(",%u", *p_data++);
+  printf("\n");
+}
+
+int main(int argc, char *argv[]) {
+  int fd = 0;                          //Szabvnyos bemenet
+  uint8_t buf[BUFSIZE];
+  uint16_t data[TELEM_NCHAN_MAX];
+  uint16_t mask;
+  uint8_t seq, size;
+  size_t len = 0, pos;
+  ssize_t n;
+  int synced = 0;                      //Az elz keret p volt: keret elejn llunk
+  if (argc > 2 || (argc == 2 && !strcmp(argv[1], "-h"))) {
+    fprintf(stderr, "Hasznalat: %s [fajl]\n", argv[0]);
+    return 2;
+  }
+  if (argc == 2 && (fd = open(argv[1], O_RDONLY)) < 0) {
+    perror(argv[1]);
+    return 1;
+  }
+  setvbuf(stdout, NULL, _IOLBF, 0);    //l vonalnl is soronknt jelenjen meg
+  while ((n = read(fd, buf + len, BUFSIZE - len)) > 0) {  //Ami ppen megjtt
+    len += n;
+    pos = 0;
+    while (pos < len) {
+      switch (telem_parse(buf + pos, (uint8_t)(len - pos > 255 ? 255 : len - pos),
+                          &seq, &mask, data, &size)) {
+      case TELEM_OK:
+        print_frame(seq, mask, data);
+        n_ok++;
+        synced = 1;
+        pos += size;
+        continue;
+      case TELEM_BAD_CRC:
+        if (synced) n_crc++;           //Hibs keret a vrt helyen
+        else n_false++;                //Adatbjt 0xA5 rtkkel
+        /* fall through */
+      case TELEM_BAD_SYNC:
+        synced = 0;                    //jraszinkronizls a kvetkez bjttl
+        n_skip++;
+        pos++;
+        continue;
+      }
+      break;                           //TELEM_SHORT: tovbbi adat kell
+    }
+    memmove(buf, buf + pos, len - pos);
+    len -= pos;
+  }
+  n_skip += len;                       //Csonka keret a vgn
+  if (fd) close(fd);
+  fprintf(stderr, "keretek: %lu, CRC hiba: %lu, kimaradt: %lu, hamis szinkron: %lu, "
+          "atlepett bajt: %lu\n", n_ok, n_crc, n_lost, n_false, n_skip);
+  return n_crc ? 1 : 0;
+}
@@ -0,0 +1,289 @@
+/**********************************************************************
+ *  tick_check.c
+ *
+ * Gazdagpes ellenrzs: a tick modul (common/tick.c) VLO kalibrlsa,
+ * a sleep_ms() pontossga s a tick_run() csszsmentes temezse,
+ * valamint az adapt modul (common/adapt.c) ugrsszlelsi ideje,
+ * virtulis rval (tools/mock_io.c).
+ *
+ * A modell a vals idt msodpercben szmolja. A Timer_A rgzts
+ * (CCR0, CCI0B = ACLK) a TACCTL0 olvassakor, ha a CCIFG trlt,
+ * az rt a VLO kvetkez felfut lre lpteti, a TACCR0-ba az l
+ * idejt rja SMCLK temben (16 biten), s belltja a CCIFG bitet.
+ * Alvs kzben (mock_idle) s a feladatok futsakor az ra a WDT
+ * peridusval (64 VLO rajel) lp, s WDT megszakts jn.
+ *
+ * Esetek (VLO: 9,4 kHz, 12 kHz, 15 kHz, vletlen fzissal):
+ *  - tick_init(): ACLK = VLO, WDT_ADLY_1_9, WDTIE
+ *  - sleep_ms(0 - 30000): a vals id legfeljebb egy WDT peridus
+ *    + 1 ms + CAL_TOL(f) relatv hibval tr el a krttl; a CAL_TOL
+ *    a kalibrls felbontsa (1 SMCLK rajel CAL_N VLO peridus
+ *    alatt, 1 MHz-en 15 kHz-nl kb. 0,2%), a nvleges 12 kHz-cel
+ *    szmolva 9,4 kHz-en 28% lenne az eltrs
+ *  - tick_run(): hrom feladat (100 ms / 2 ms munka, 37 ms / 3 ms,
+ *    20 ms / 0 ms) 20 s-ig; minden futs a k*period idpont utn
+ *    legfeljebb LATE_MAX ms-mal indul (nincs csszs), a futsok
+ *    szma a vrtnak felel meg, s a 20 s vals idben is pontos
+ *  - adapt_wait()/adapt_put(): a 4_adc_multi2_ref1 fciklusa (A5 s a
+ *    bels hmr, blokkonknt T_BUSY mrs s T_PRINT kirs) NSTEP
+ *    ugrssal az A5-n, mindig T_MAX idkznl. Minden msodik ugrs
+ *    vletlen idpontban jn, a tbbi a legrosszabb esetben: kzvetlenl
+ *    az A5 blokkja utn, s a hmr mrse 1 - 4 ms-mal az A5
+ *    kvetkez mrse eltt esedkes. Az ugrs s az azt szlel blokk
+ *    vge kzti id legfeljebb az adapt.h korltja: t_max + 2*t_busy
+ *    + t_print + egy tick (a t_max tick_ms() szerinti, ezrt a
+ *    kalibrls CAL_TOL hibjval), s az szlels utn az idkz t_min
+ *
+ * Hasznlat:
+ *   tick_check     (eltrs esetn kirja, s 1-es kddal ll le)
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <setjmp.h>
+#include "mock_io.h"
+#include "tick.h"
+#include "adapt.h"
+
+#define WDT_DIV   64                   //WDT_ADLY_1_9: ACLK/64
+#define CAL_N     8                    //tick.c: TICK_CAL_N
+//--- A kalibrlt id relatv trse: a mrs 1 SMCLK rajel felbontsa
+//    (CAL_N VLO peridus alatt) s a tick_us egsz us-ra csonktsa
+#define CAL_TOL(f)  ((f) / (CAL_N * (double)TICK_SMCLK) + (f) / (WDT_DIV * 1e6))
+#define RUN_MS    20000                //A tick_run() eset hossza (ms)
+#define LATE_MAX  25                   //Legnagyobb kss a k*period idponthoz (ms)
+#define NTASKS    3
+//--- adapt: a 4_adc_multi2_ref1 belltsai s kirsa
+#define T_BUSY    32                   //Egy blokk ideje (ms)
+#define T_PRINT   (55 * 11 / 9600.0)   //Egy sor: 55 karakter, 9600 baud, 2 stop bit (s)
+#define NSTEP     200                  //Ugrsok szma VLO frekvencinknt
+#define CALM      40                   //Nyugodt szakasz az ugrsok kztt (s)
+
+static double f_vlo;                   //A modell VLO frekvencija (Hz)
+static double vlo_ph;                  //Az els VLO l fzisa (peridus)
+static unsigned long vlo_edge;         //A kvetkez VLO l sorszma
+static double t_now;                   //Vals id (s)
+static double t_wdt;                   //Az utols WDT megszakts ideje (s)
+
+/*-------------------------------------------------------------
+ * Timer_A rgzts: CCR0 a VLO felfut ln (SMCLK temben)
+ *-------------------------------------------------------------*/
+static void capture_hook(uint8_t r) {
+  double t;
+  if (r != EMU_TACCTL0 || !(mock_reg16[EMU_TACCTL0] & CAP)
+      || (mock_reg16[EMU_TACCTL0] & CCIFG) || !(mock_reg16[EMU_TACTL] & MC_2)) return;
+  t = (vlo_edge++ + vlo_ph) / f_vlo;
+  t_now = t;                           //A program az lig vr
+  mock_reg16[EMU_TACCR0] = (uint16_t)(unsigned long long)(t * TICK_SMCLK);
+  mock_reg16[EMU_TACCTL0] |= CCIFG;
+}
+
+/*-------------------------------------------------------------
+ * A WDT intervallum idzt: a kvetkez megszakts
+ *-------------------------------------------------------------*/
+static int wdt_on(void) {
+  return mock_reg16[EMU_WDTCTL] == WDT_ADLY_1_9 && (mock_reg8[EMU_IE1] & WDTIE);
+}
+
+static void wdt_tick(void) {
+  t_wdt += WDT_DIV / f_vlo;
+  t_now = t_wdt;
+  mock_irq(WDT_VECTOR);
+}
+
+//--- Alvs (LPM3): az id a kvetkez WDT megszaktsig telik
+static void idle(void) {
+  if (wdt_on()) wdt_tick();
+}
+
+//--- Munka aktv mdban: dt msodperc, kzben WDT megszaktsok
+static void busy(double dt) {
+  double t_end = t_now + dt;
+  while (wdt_on() && t_wdt + WDT_DIV / f_vlo <= t_end) wdt_tick();
+  t_now = t_end;
+}
+
+/*-------------------------------------------------------------
+ * Indts adott VLO frekvencival
+ *-------------------------------------------------------------*/
+static void start(double f) {
+  mock_reset();
+  f_vlo = f;
+  vlo_ph = (double)rand() / RAND_MAX;
+  vlo_edge = 0;
+  t_now = 0;
+  mock_hook16 = capture_hook;
+  tick_init();
+  t_wdt = t_now;                       //WDTCNTCL: a szmll az indtskor nullzdik
+  mock_hook16 = 0;
+  mock_idle = idle;
+  CHECK((mock_reg8[EMU_BCSCTL3] & LFXT1S_3) == LFXT1S_2, "tick_init: ACLK nem a VLO");
+  CHECK(wdt_on(), "tick_init: WDTCTL = 0x%04X, IE1 = 0x%02X", mock_reg16[EMU_WDTCTL],
+        mock_reg8[EMU_IE1]);
+  CHECK(mock_sr & GIE, "tick_init: a megszakitasok tiltva");
+  CHECK(mock_reg16[EMU_TACTL] == 0 && mock_reg16[EMU_TACCTL0] == 0,
+        "tick_init: a Timer_A nem allt le");
+}
+
+/*-------------------------------------------------------------
+ * sleep_ms() pontossga
+ *-------------------------------------------------------------*/
+static void check_sleep(double f) {
+  static const uint16_t ms[] = { 0, 1, 5, 10, 33, 100, 1000, 10000, 30000 };
+  unsigned i, k;
+  double t0, dt, tol, err, err_max = 0;
+  int fail0 = mock_fail;
+  start(f);
+  for (i = 0; i < sizeof(ms) / sizeof(ms[0]); i++) {
+    for (k = 0; k < 8; k++) {          //Vletlen fzis a WDT-hez kpest
+      busy(WDT_DIV / f * rand() / RAND_MAX);
+      t0 = t_now;
+      sleep_ms(ms[i]);
+      dt = (t_now - t0) * 1000;
+      tol = ms[i] ? WDT_DIV / f * 1000 + 1 + ms[i] * CAL_TOL(f) : 0;
+      CHECK(fabs(dt - ms[i]) <= tol, "VLO %.0f Hz: sleep_ms(%u) %.3f ms (tures %.3f ms)",
+            f, ms[i], dt, tol);
+      if (ms[i] >= 10000 && fabs(dt - ms[i]) / ms[i] > err_max) err_max = fabs(dt - ms[i]) / ms[i];
+    }
+  }
+  CHECK(mock_sr & GIE, "sleep_ms: a megszakitasok tiltva maradtak");
+  err = fabs(12000.0 / f - 1);
+  printf("%s  VLO %5.0f Hz: sleep_ms(10000 - 30000) hibaja %.3f%% (tures %.3f%%, "
+         "kalibralas nelkul %.1f%%)\n", mock_fail == fail0 ? "    " : "HIBA", f, err_max * 100,
+         CAL_TOL(f) * 100, err * 100);
+}
+
+/*-------------------------------------------------------------
+ * tick_run(): a feladatok a futsuk idejt jegyzik fel
+ *-------------------------------------------------------------*/
+static jmp_buf run_end;
+static const double work[NTASKS] = { 0.002, 0.003, 0 };  //Munka (s)
+static unsigned runs[NTASKS];
+static uint16_t late_max[NTASKS];
+static double t_end;                   //Az utols A futs vals ideje
+static uint16_t ms0;                   //tick_ms() a tick_run() indtsakor
+static tick_task_t tasks[NTASKS];
+
+static void task(uint8_t i) {
+  uint16_t late = tick_ms() - ms0 - (uint16_t)(runs[i] * tasks[i].period);
+  if (late > late_max[i]) late_max[i] = late;
+  runs[i]++;
+  busy(work[i]);
+  if (i == 0 && runs[0] > RUN_MS / tasks[0].period) {
+    t_end = t_now - work[0];
+    longjmp(run_end, 1);
+  }
+}
+
+static void task_a(void) { task(0); }
+static void task_b(void) { task(1); }
+static void task_c(void) { task(2); }
+
+static void check_run(double f) {
+  static const tick_task_t init[NTASKS] = {
+    TICK_TASK(task_a, 100), TICK_TASK(task_b, 37), TICK_TASK(task_c, 20)
+  };
+  unsigned i, n;
+  double t0;
+  int fail0 = mock_fail;
+  start(f);
+  busy(0.0123);
+  for (i = 0; i < NTASKS; i++) {
+    tasks[i] = init[i];
+    runs[i] = 0;
+    late_max[i] = 0;
+  }
+  t0 = t_now;
+  ms0 = tick_ms();
+  if (!setjmp(run_end)) {
+    tick_run(tasks, NTASKS);
+    CHECK(0, "tick_run: visszatert");
+  }
+  for (i = 0; i < NTASKS; i++) {
+    n = RUN_MS / tasks[i].period + 1;  //Az indtskor is lefut
+    CHECK(runs[i] + 1 >= n && runs[i] <= n + 1, "VLO %.0f Hz: %u ms feladat %u-szor fut (%u)",
+          f, tasks[i].period, runs[i], n);
+    CHECK(late_max[i] <= LATE_MAX, "VLO %.0f Hz: %u ms feladat %u ms keses (%u)",
+          f, tasks[i].period, late_max[i], LATE_MAX);
+  }
+  CHECK(fabs((t_end - t0) * 1000 - RUN_MS) <= RUN_MS * CAL_TOL(f) + LATE_MAX,
+        "VLO %.0f Hz: %u ms valos ideje %.1f ms", f, RUN_MS, (t_end - t0) * 1000);
+  printf("%s  VLO %5.0f Hz: tick_run %u s, futasok %u/%u/%u, legnagyobb keses %u/%u/%u ms\n",
+         mock_fail == fail0 ? "    " : "HIBA", f, RUN_MS / 1000, runs[0], runs[1], runs[2],
+         late_max[0], late_max[1], late_max[2]);
+}
+
+/*-------------------------------------------------------------
+ * adapt: ugrs az A5-n, az szlelsig eltelt vals id
+ *-------------------------------------------------------------*/
+static const adapt_cfg_t cfg_a5 = { 250, 8000, 4, 8, 4, T_BUSY };
+static const adapt_cfg_t cfg_temp = { 1000, 16000, 8, 16, 2, T_BUSY };
+
+static void check_adapt(double f) {
+  adapt_t sched[2];
+  uint16_t lv[2] = { 2000, 2400 };     //Az A5 szintje az ugrs eltt s utn
+  uint16_t x, dx, period;
+  unsigned n = 0, n_slow = 0;
+  double t_step = 1e30, t_arm, t_a, lat, lat_max = 0;
+  double bound = cfg_a5.t_max / 1000.0 * (1 + CAL_TOL(f)) + 2 * T_BUSY / 1000.0 + T_PRINT
+                 + WDT_DIV / f;
+  int fail0 = mock_fail;
+  start(f);
+  busy(WDT_DIV / f * rand() / RAND_MAX);
+  adapt_init(&sched[0], &cfg_a5);
+  adapt_init(&sched[1], &cfg_temp);
+  t_arm = t_now + CALM;
+  while (n < NSTEP) {
+    if (adapt_wait(sched, 2) == 0) {
+      t_a = t_now;
+      busy(T_BUSY / 1000.0);
+      x = lv[t_now >= t_step];         //A blokk vgn
+      dx = lv[t_a >= t_step] != x ? 1000 : 0; //Ugrs a blokk alatt: a terjedelem nagy
+      period = sched[0].period;
+      adapt_put(&sched[0], x, dx);
+      if (t_now >= t_step) {           //Az ugrs utni els blokk
+        lat = t_now - t_step;
+        if (lat > lat_max) lat_max = lat;
+        n_slow += period == cfg_a5.t_max;
+        CHECK(lat <= bound, "VLO %.0f Hz: ugras utan %.1f ms az eszleles (korlat %.1f ms)",
+              f, lat * 1000, bound * 1000);
+        CHECK(sched[0].period == cfg_a5.t_min, "VLO %.0f Hz: eszleles utan %u ms idokoz",
+              f, sched[0].period);
+        lv[1] = lv[0];                 //A kvetkez ugrs visszafel
+        lv[0] = x;
+        t_step = 1e30;
+        t_arm = t_now + CALM;
+        n++;
+      } else if (t_step > 1e29 && t_now >= t_arm) {
+        if (n & 1) {                   //Legrosszabb eset: a blokk utn, eltte a hmr
+          t_step = t_now + T_PRINT * rand() / RAND_MAX;
+          sched[1].next = sched[0].next - 1 - rand() % 4;
+        } else {
+          t_step = t_now + 8.0 * rand() / RAND_MAX;
+        }
+      }
+    } else {
+      busy(T_BUSY / 1000.0);
+      adapt_put(&sched[1], 1200, 0);
+    }
+    busy(T_PRINT);                     //A sor kirsa (sw_uart_flush)
+  }
+  CHECK(n_slow == n, "VLO %.0f Hz: %u ugrasbol csak %u erte T_MAX idokoznel", f, n, n_slow);
+  printf("%s  VLO %5.0f Hz: adapt %u ugras, leghosszabb eszleles %.1f ms (korlat %.1f ms)\n",
+         mock_fail == fail0 ? "    " : "HIBA", f, n, lat_max * 1000, bound * 1000);
+}
+
+int main(void) {
+  static const double f[] = { 9400, 12000, 15000 };
+  unsigned i;
+  srand(1);
+  for (i = 0; i < sizeof(f) / sizeof(f[0]); i++) {
+    check_sleep(f[i]);
+    check_run(f[i]);
+    check_adapt(f[i]);
+  }
+  return mock_summary("tick_check");
+}
@@ -0,0 +1,332 @@
+/**********************************************************************
+ *  tx_check.c
+ *
+ * Gazdagpes ellenrzs: a megszaktsos szoftveres UART ad
+ * (common/sw_uart_tx.c) a Timer_A modelljvel (tools/mock_io.c).
+ *
+ * A modell az idt SMCLK temben szmolja; a TAR folytonos mdban az
+ * id 65536-tal, felfel szmll mdban (TACCR0+1)-gyel vett
+ * maradka. Az ad kompartora (CCR1, SW_UART_RX esetn CCR2) a
+ * TACCRx idpontban TIMER0_A1 megszaktst (TAIV = 2, ill. 4) ad; a
+ * megszakts utn a modell feljegyzi a P1.1 kimenet vltozsait az
+ * idvel egytt. Az lsorozatot a program bjtokk alaktja vissza,
+ * s minden lnek pontosan a keret kezdete + SW_UART_EDGE(k)
+ * idpontban kell lennie.
+ *
+ * Esetek (folytonos s felfel szmll md, TACCR0 = 999):
+ *  - folyamatos ads: a buffert a fprogram 0 - 3 bitidnknt tlti,
+ *    a keretek hzag nlkl kvetik egymst (SW_UART_EDGE(NBITS))
+ *  - tele buffer: sw_uart_write() legfeljebb SW_UART_TXBUF_SIZE-1
+ *    bjtot vesz t; sw_uart_tx_puts() 100 karakterbl az els
+ *    SW_UART_TXBUF_SIZE utn (egy mr az adatregiszterben van)
+ *    karakterenknt egyszer alszik (LPM0), a sw_uart_tx_flush() az
+ *    utols stop bit vgn tr vissza
+ *  - stop bit vrakozs: a keret utn mg egy bitidig foglalt; az
+ *    ekkor bert bjt egy bitid sznettel, jraindts nlkl megy
+ *    ki, lells utn pedig a TAR + bitid idpontban indul
+ * SW_UART_RX esetn (tx_check_rx, 1 stop bit, 4800 baud) az ad a
+ * CCR2-t hasznlja, a vev CCR1 belltst nem mdosthatja.
+ *
+ * Hasznlat:
+ *   tx_check     (eltrs esetn kirja, s 1-es kddal ll le)
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "mock_io.h"
+#include "sw_uart_tx.h"
+#ifdef SW_UART_RX
+#include "sw_uart_rx.h"
+#endif
+
+#ifdef SW_UART_RX                      //Az ad a CCR2-n
+#define CHECK_NAME "tx_check_rx"
+#define TX_CCR    EMU_TACCR2
+#define TX_CCTL   EMU_TACCTL2
+#define TX_IV     4
+#else
+#define CHECK_NAME "tx_check"
+#define TX_CCR    EMU_TACCR1
+#define TX_CCTL   EMU_TACCTL1
+#define TX_IV     2
+#endif
+
+#define EDGE(k)   ((tick_t)SW_UART_EDGE(k))  //A k. bitl a keret elejtl
+#define FRAME     EDGE(SW_UART_NBITS)  //Egy keret hossza (rats)
+#define NEDGES    8192                 //Az lsorozat legnagyobb hossza
+#define NBYTES    256                  //Bjtok a folyamatos adsban
+#define UP_PERIOD 1000                 //Felfel szmll md: TACCR0 + 1
+
+typedef unsigned long long tick_t;
+
+static tick_t e_time[NEDGES];          //A TXD leinek ideje
+static uint8_t e_level[NEDGES];        //A TXD szintje az l utn
+static unsigned n_edges;
+static uint8_t txd;                    //A TXD utoljra feljegyzett szintje
+static tick_t now;                     //A modell ideje (rats)
+
+/*-------------------------------------------------------------
+ * A Timer_A modellje: TAR a modell idejbl, az ad kompartora
+ *-------------------------------------------------------------*/
+static unsigned long period(void) {
+  return (mock_reg16[EMU_TACTL] & MC_3) == MC_1 ? mock_reg16[EMU_TACCR0] + 1UL : 65536UL;
+}
+
+static void tar_hook(uint8_t r) {
+  if (r == EMU_TAR) mock_reg16[EMU_TAR] = (uint16_t)(now % period());
+}
+
+//--- A TXD vltozsnak feljegyzse
+static void record(void) {
+  uint8_t l = (mock_reg8[EMU_P1OUT] & BIT1) != 0;
+  if (l == txd) return;
+  if (n_edges < NEDGES) {
+    e_time[n_edges] = now;
+    e_level[n_edges++] = l;
+  }
+  txd = l;
+}
+
+/*-------------------------------------------------------------
+ * Az ad kvetkez megszaktsa, ha legksbb 'until' idpontban
+ * van. Visszatrsi rtk: 1, ha volt.
+ *-------------------------------------------------------------*/
+static int tx_event(tick_t until) {
+  unsigned long p = period(), d;
+  uint16_t ccr = mock_reg16[TX_CCR];
+  if (!(mock_reg16[TX_CCTL] & CCIE)) return 0;
+  if (ccr >= p) {                      //Felfel szmllsnl sosem egyezik
+    CHECK(0, "TACCR = %u a perioduson kivul (%lu)", ccr, p);
+    mock_reg16[TX_CCTL] &= ~CCIE;
+    return 0;
+  }
+  d = (ccr + p - now % p) % p;
+  if (!d) d = p;
+  if (now + d > until) return 0;
+  now += d;
+  mock_reg16[EMU_TAIV] = TX_IV;
+  if (!mock_irq(TIMER0_A1_VECTOR)) {
+    CHECK(0, "TIMER0_A1: a megszakitas tiltva");
+    return 0;
+  }
+  record();
+  return 1;
+}
+
+static void tx_run(tick_t until) {     //A fprogram 'until'-ig fut
+  while (tx_event(until));
+  now = until;
+}
+
+//--- Alvs (LPM0) kzben: a kvetkez megszakts
+static void idle(void) {
+  tx_event(~0ULL);
+}
+
+/*-------------------------------------------------------------
+ * Indts: Timer_A folytonos vagy felfel szmll mdban
+ *-------------------------------------------------------------*/
+static void start(int up) {
+  mock_reset();
+  n_edges = 0;
+  txd = 1;
+  now = 12345;                         //Az els keretek mr krbefordulnak
+  if (up) {                            //Mr fut idzt (pl. ADC trigger)
+    mock_reg16[EMU_TACCR0] = UP_PERIOD - 1;
+    mock_reg16[EMU_TACTL] = TASSEL_2 | MC_1;
+  }
+  mock_hook16 = tar_hook;
+  mock_idle = idle;
+  sw_uart_tx_init();
+#ifdef SW_UART_RX
+  sw_uart_rx_init();
+#endif
+  CHECK((mock_reg8[EMU_P1DIR] & BIT1) && (mock_reg8[EMU_P1OUT] & BIT1),
+        "sw_uart_tx_init: a TXD nem magas szintu kimenet");
+  CHECK(up || (mock_reg16[EMU_TACTL] & MC_3) == MC_2, "sw_uart_tx_init: Timer_A nem fut");
+  CHECK(!up || (mock_reg16[EMU_TACTL] & MC_3) == MC_1,
+        "sw_uart_tx_init: a futo Timer_A-t atallitotta");
+}
+
+/*-------------------------------------------------------------
+ * Az lsorozat visszaalaktsa bjtokk. A bitek a bitek kzepn
+ * (SW_UART_MID) vett szintek, minden lnek a keret elejtl
+ * SW_UART_EDGE(k) tvolsgra kell lennie.
+ * t_start: a keretek kezdete; visszatrsi rtk: a bjtok szma
+ *-------------------------------------------------------------*/
+static uint8_t line_at(tick_t t) {
+  unsigned lo = 0, hi = n_edges;       //Az els l, amely t utn van
+  while (lo < hi) {
+    unsigned mid = (lo + hi) / 2;
+    if (e_time[mid] <= t) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo ? e_level[lo - 1] : 1;
+}
+
+static unsigned decode(const char *name, uint8_t *buf, tick_t *t_start, unsigned max) {
+  unsigned i = 0, n = 0, k, n_bad = 0;
+  tick_t t0, off;
+  uint8_t c;
+  CHECK(n_edges < NEDGES, "%s: tul hosszu elsorozat", name);
+  while (i < n_edges && n < max) {
+    t0 = e_time[i];
+    if (e_level[i]) {
+      CHECK(0, "%s: felfuto el kereten kivul (t = %llu)", name, t0);
+      i++;
+      continue;
+    }
+    for (; i < n_edges && e_time[i] < t0 + FRAME; i++) {
+      off = e_time[i] - t0;
+      for (k = 0; k < SW_UART_NBITS && off != EDGE(k); k++);
+      if (k == SW_UART_NBITS && !n_bad++) {
+        CHECK(0, "%s: a %u. keret ele %llu orautesnel, nem SW_UART_EDGE(k)-nal", name, n, off);
+      }
+    }
+    c = 0;
+    for (k = 1; k <= 8; k++) c |= line_at(t0 + SW_UART_MID(k)) << (k - 1);
+    for (k = 9; k < SW_UART_NBITS; k++) {
+      CHECK(line_at(t0 + SW_UART_MID(k)), "%s: a %u. keret %u. stop bitje alacsony", name, n,
+            k - 8);
+    }
+    t_start[n] = t0;
+    buf[n++] = c;
+  }
+  CHECK(n_bad <= 1, "%s: osszesen %u el nem SW_UART_EDGE(k)-nal", name, n_bad);
+  return n;
+}
+
+/*-------------------------------------------------------------
+ * Folyamatos ads: a buffert a fprogram 0 - 3 bitidnknt tlti
+ *-------------------------------------------------------------*/
+static void run_stream(const char *name, int up) {
+  static uint8_t msg[NBYTES], got[NBYTES + 8];
+  static tick_t t_start[NBYTES + 8];
+  unsigned i, n, n_in = 0, n_gap = 0;
+  tick_t t_write;
+  int fail0 = mock_fail;
+  start(up);
+  srand(1);
+  for (i = 0; i < NBYTES; i++) msg[i] = (uint8_t)(i * 167 + 13);
+  t_write = now;
+  n = sw_uart_write((const char *)msg, 255);
+  CHECK(n == SW_UART_TXBUF_SIZE - 1, "%s: sw_uart_write() %u bajtot vett at (%u)", name, n,
+        SW_UART_TXBUF_SIZE - 1);
+  n_in = n;
+  while (n_in < NBYTES) {
+    tx_run(now + rand() % (3 * SW_UART_BITTIME + 1));
+    n = NBYTES - n_in;
+    n_in += sw_uart_write((const char *)msg + n_in, (uint8_t)(n > 255 ? 255 : n));
+  }
+  sw_uart_tx_flush();
+  n = decode(name, got, t_start, NBYTES + 8);
+  CHECK(n == NBYTES, "%s: %u bajt ment ki (%u)", name, n, NBYTES);
+  for (i = 0; i < n && i < NBYTES; i++) {
+    if (got[i] != msg[i]) {
+      CHECK(0, "%s: a %u. bajt 0x%02X (0x%02X)", name, i, got[i], msg[i]);
+      break;
+    }
+  }
+  CHECK(n && t_start[0] == t_write + SW_UART_BITTIME,
+        "%s: az elso start bit %llu orautes utan (%u)", name, n ? t_start[0] - t_write : 0,
+        SW_UART_BITTIME);
+  for (i = 1; i < n; i++) {
+    if (t_start[i] - t_start[i-1] != FRAME) n_gap++;
+  }
+  CHECK(n_gap == 0, "%s: %u keret nem hezagmentesen kovette az elozot", name, n_gap);
+  CHECK(n && now == t_start[n-1] + FRAME, "%s: a flush %lld orautessel a keret vege utan tert vissza",
+        name, n ? (long long)(now - t_start[n-1] - FRAME) : 0);
+  CHECK(!sw_uart_tx_busy() && !(mock_reg16[TX_CCTL] & CCIE), "%s: az ado nem allt le", name);
+  CHECK(txd == 1, "%s: a TXD alacsony maradt", name);
+#ifdef SW_UART_RX
+  CHECK((mock_reg16[EMU_TACCTL1] & (CAP | CCIE)) == (CAP | CCIE),
+        "%s: az ado atallitotta a vevo CCR1-et", name);
+#endif
+  printf("%s  %-40s %3u bajt, %u el\n", mock_fail == fail0 ? "    " : "HIBA", name, n, n_edges);
+}
+
+/*-------------------------------------------------------------
+ * Tele buffer: sw_uart_tx_puts() LPM0-ban vr
+ *-------------------------------------------------------------*/
+static void run_full(int up) {
+  static char msg[101];
+  static uint8_t got[128];
+  static tick_t t_start[128];
+  const char *name = up ? "tele buffer, puts, felfele" : "tele buffer, puts";
+  unsigned i, n, wakes;
+  int fail0 = mock_fail;
+  start(up);
+  for (i = 0; i < 100; i++) msg[i] = (char)('!' + i % 90);
+  msg[100] = 0;
+  sw_uart_tx_puts(msg);
+  wakes = mock_wakes;
+  CHECK(wakes == 100 - SW_UART_TXBUF_SIZE, "%s: puts %u ebredes (%u)", name, wakes,
+        100 - SW_UART_TXBUF_SIZE);     //Egy bjt mr az adatregiszterben
+  CHECK(mock_sr & GIE, "%s: a megszakitasok tiltva maradtak", name);
+  sw_uart_tx_flush();
+  n = decode(name, got, t_start, 128);
+  CHECK(n == 100, "%s: %u bajt ment ki (100)", name, n);
+  for (i = 0; i < n && i < 100; i++) {
+    if (got[i] != (uint8_t)msg[i]) {
+      CHECK(0, "%s: a %u. bajt 0x%02X (0x%02X)", name, i, got[i], (uint8_t)msg[i]);
+      break;
+    }
+    CHECK(!i || t_start[i] - t_start[i-1] == FRAME, "%s: hezag a %u. keret elott", name, i);
+  }
+  CHECK(n && now == t_start[n-1] + FRAME, "%s: a flush nem a keret vegen tert vissza", name);
+  CHECK(!sw_uart_tx_busy(), "%s: az ado nem allt le", name);
+  printf("%s  %-40s %3u bajt, %u ebredes\n", mock_fail == fail0 ? "    " : "HIBA", name, n,
+         wakes);
+}
+
+/*-------------------------------------------------------------
+ * Stop bit vrakozs s jraindts
+ *-------------------------------------------------------------*/
+static void run_stop(int up) {
+  uint8_t got[4];
+  tick_t t_start[4], t_w1, t_w3;
+  const char *name = up ? "stop bit varakozas, felfele" : "stop bit varakozas";
+  unsigned n;
+  int fail0 = mock_fail;
+  start(up);
+  t_w1 = now;
+  sw_uart_write("U", 1);
+  tx_run(t_w1 + SW_UART_BITTIME + EDGE(SW_UART_NBITS - 1) - 1);
+  CHECK(sw_uart_tx_busy(), "%s: az utolso stop bit elott leallt", name);
+  tx_run(now + 2);                     //Az utols stop bit alatt: vrakozs
+  CHECK(sw_uart_tx_busy(), "%s: az utolso stop bit alatt leallt", name);
+  sw_uart_write("\x80", 1);            //jraindts nlkl folytatja
+  tx_run(t_w1 + SW_UART_BITTIME + 3 * FRAME);
+  CHECK(!sw_uart_tx_busy(), "%s: nem allt le", name);
+  t_w3 = now;
+  sw_uart_write("\x0F", 1);            //Lells utn: TAR + bitid
+  sw_uart_tx_flush();
+  n = decode(name, got, t_start, 4);
+  CHECK(n == 3 && got[0] == 'U' && got[1] == 0x80 && got[2] == 0x0F,
+        "%s: %u bajt, 0x%02X 0x%02X 0x%02X", name, n, got[0], got[1], got[2]);
+  if (n == 3) {
+    CHECK(t_start[0] == t_w1 + SW_UART_BITTIME, "%s: az 1. keret kezdete", name);
+    CHECK(t_start[1] == t_start[0] + FRAME + SW_UART_BITLEN(SW_UART_NBITS - 1),
+          "%s: a 2. keret %llu orautessel a keret vege utan (%u)", name,
+          t_start[1] - t_start[0] - FRAME, (unsigned)SW_UART_BITLEN(SW_UART_NBITS - 1));
+    CHECK(t_start[2] == t_w3 + SW_UART_BITTIME, "%s: a 3. keret %llu orautessel a beiras utan",
+          name, t_start[2] - t_w3);
+    CHECK(now == t_start[2] + FRAME, "%s: a flush nem a keret vegen tert vissza", name);
+  }
+  printf("%s  %-40s %3u bajt\n", mock_fail == fail0 ? "    " : "HIBA", name, n);
+}
+
+int main(void) {
+  printf("SMCLK %lu Hz, %lu baud, %u stop bit, bitido %u orautes\n",
+         (unsigned long)SW_UART_SMCLK, (unsigned long)SW_UART_BAUD, SW_UART_STOPBITS,
+         SW_UART_BITTIME);
+  run_stream("folyamatos adas, folytonos mod", 0);
+  run_stream("folyamatos adas, felfele szamlalo mod", 1);
+  run_full(0);
+  run_full(1);
+  run_stop(0);
+  run_stop(1);
+  return mock_summary(CHECK_NAME);
+}
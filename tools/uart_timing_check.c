@@ -0,0 +1,130 @@
+/**********************************************************************
+ *  uart_timing_check.c
+ *
+ * Gazdagpes ellenrzs: a szoftveres s a hardveres UART bitidztse
+ * minden tmogatott rajel (CLOCK_MHZ: 1, 8, 12, 16) s adatsebessg
+ * (2400 - 230400 baud) prra. Az rtkeket nem szmoljuk jra: a
+ * tblzat minden eleme a sw_uart.h, sw_uart_tx.h s usci_uart.h
+ * makrinak kifejtse az adott prra (uart_timing_pair.h, a prok
+ * listja: uart_timing_pairs.h).
+ *
+ * Tmogatott pr (a forrs #error felttelei szerint):
+ *  - bit banging (sw_uart.c): SMCLK/BAUD > SW_UART_LOOP_CYCLES
+ *  - Timer_A ad (sw_uart_tx.h): SMCLK/BAUD >= SW_UART_TX_MINBIT
+ *  - USCI (usci_uart.h): UCBRx >= 8
+ * Felttelek tmogatott prra:
+ *  - a SW_UART_EDGE(k) bitlek legfeljebb fl ratsre, a bitid
+ *    LIMIT_PCT szzalkn bell vannak az idelistl (k * SMCLK/BAUD),
+ *    a keret vgig (a trtrsz nem halmozdik)
+ *  - a SW_UART_MID(k) mintavteli pontok legfeljebb fl ratsre
+ *    vannak a bitek kzeptl ("kozep" oszlop, ratsben)
+ *  - bit bangingnl a SW_UART_DELAY() ksleltetsek pozitvak
+ *  - USCI: az UCBRx/UCBRSx modulcival a keret bitleinek hibja
+ *    legfeljebb USCI_LIMIT_PCT (egy rats, UCBRx >= 8 esetn 12,5%)
+ * sszevetsl kirja a rgi mdszer (minden bit SW_UART_EDGE(1)
+ * hossz) hibjt is a keret vgn.
+ *
+ * Hasznlat:
+ *   uart_timing_check     (eltrs esetn kirja, s 1-es kddal ll le)
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#include <stdio.h>
+#include <math.h>
+#include "sw_uart.h"
+#include "sw_uart_tx.h"                //SW_UART_TX_MINBIT
+#include "usci_uart.h"
+
+#define LIMIT_PCT       5.0            //Bitl-hiba hatra (a bitid %-a)
+#define USCI_LIMIT_PCT  12.5           //USCI: egy rats 8 ratses bitnl
+#define USCI_NBITS      (1 + 8 + USCI_UART_STOPBITS)
+
+typedef struct {
+  unsigned mhz;
+  unsigned long baud;
+  int bitbang, timer, usci;            //Tmogatott-e a pr
+  unsigned br, brs;                    //USCI: UCBRx, UCBRSx
+  unsigned long edge[12];              //SW_UART_EDGE(0 - 11)
+  unsigned long mid[11];               //SW_UART_MID(0 - 10)
+} pair_t;
+
+//--- A prok (uart_timing_pairs.h): pair_<MHz>_<baud> objektumok -----
+#define PAIR_ID(m,b)    PAIR_ID_(m,b)
+#define PAIR_ID_(m,b)   pair_##m##_##b
+#include "uart_timing_pairs.h"
+#define PAIR_LIST                      //Msodik menet: a cmek tblzata
+static const pair_t *const pairs[] = {
+#include "uart_timing_pairs.h"
+};
+#define NPAIRS  (sizeof(pairs) / sizeof(pairs[0]))
+
+//--- USCI UCBRSx modulcis mintk: bitenknt +1 rats a start bittl
+//--- (a felhasznli kziknyv tblzata)
+static const unsigned char usci_pattern[8][8] = {
+  { 0,0,0,0,0,0,0,0 }, { 0,1,0,0,0,0,0,0 }, { 0,1,0,0,0,1,0,0 }, { 0,1,0,1,0,1,0,0 },
+  { 0,1,0,1,0,1,0,1 }, { 0,1,1,1,0,1,0,1 }, { 0,1,1,1,0,1,1,1 }, { 0,1,1,1,1,1,1,1 }
+};
+
+/*-------------------------------------------------------------
+ * A legnagyobb bitl-eltrs (rats) az USCI modulcijval
+ *-------------------------------------------------------------*/
+static double usci_error(const pair_t *p, double c) {
+  double w = 0;
+  unsigned long t = 0;
+  int k;
+  for (k = 0; k < USCI_NBITS; k++) {
+    t += p->br + usci_pattern[p->brs][k % 8];
+    w = fmax(w, fabs(t - (k + 1) * c));
+  }
+  return w;
+}
+
+int main(void) {
+  unsigned i;
+  int k, bad, n_fail = 0;
+  double c, err, old, mid, uerr;
+  long dmin;
+  char br[16];
+  printf("%d stop bit, SW_UART_LOOP_CYCLES = %d, SW_UART_TX_MINBIT = %d\n",
+         SW_UART_STOPBITS, SW_UART_LOOP_CYCLES, SW_UART_TX_MINBIT);
+  printf("%4s %7s %8s %5s %5s %8s %8s %8s %7s %8s\n", "MHz", "baud", "utes/bit", "bitb",
+         "timer", "hiba %", "kozep", "regi %", "UCBR", "USCI %");
+  for (i = 0; i < NPAIRS; i++) {
+    const pair_t *p = pairs[i];
+    c = p->mhz * 1e6 / p->baud;
+    err = old = mid = 0;
+    dmin = 0x7FFFFFFFL;
+    for (k = 0; k <= SW_UART_NBITS; k++) {
+      err = fmax(err, fabs(p->edge[k] - k * c));
+      old = fmax(old, fabs(k * (double)p->edge[1] - k * c));
+      if (k < SW_UART_NBITS) {
+        mid = fmax(mid, fabs(p->mid[k] - (k + 0.5) * c));
+        //SW_UART_DELAY(k,k+1): a bit hossza a sajt id nlkl
+        if ((long)(p->edge[k+1] - p->edge[k]) - SW_UART_LOOP_CYCLES < dmin) {
+          dmin = (long)(p->edge[k+1] - p->edge[k]) - SW_UART_LOOP_CYCLES;
+        }
+      }
+    }
+    uerr = p->usci ? usci_error(p, c) / c * 100 : 0;
+    bad = 0;
+    if (p->bitbang || p->timer) {
+      bad |= err > 0.5 + 1e-9 || err / c * 100 > LIMIT_PCT || mid > 0.5 + 1e-9;
+    }
+    if (p->bitbang) bad |= dmin <= 0;
+    if (p->usci) bad |= uerr > USCI_LIMIT_PCT;
+    if (bad) n_fail++;
+    printf("%4u %7lu %8.2f %5s %5s %8.2f %8.2f %8.2f", p->mhz, p->baud, c,
+           p->bitbang ? "igen" : "-", p->timer ? "igen" : "-", err / c * 100, mid,
+           old / c * 100);
+    if (p->usci) {
+      snprintf(br, sizeof(br), "%u/%u", p->br, p->brs);
+      printf(" %7s %8.2f", br, uerr);
+    } else {
+      printf(" %7s %8s", "-", "-");
+    }
+    printf("%s\n", bad ? "  HIBA" : "");
+  }
+  printf("uart_timing_check: %d hiba\n", n_fail);
+  return n_fail ? 1 : 0;
+}
@@ -0,0 +1,51 @@
+/**********************************************************************
+ *  uart_timing_pair.h
+ *
+ * A uart_timing_check.c tblzatnak egy eleme: a PAIR_MHZ rajel s a
+ * PAIR_BAUD adatsebessg prra a sw_uart.h, sw_uart_tx.h s
+ * usci_uart.h makrinak rtke (pair_<MHz>_<baud> objektum), illetve
+ * PAIR_LIST esetn csak az objektum cme a tblzat felsorolshoz.
+ * Az SMCLK s BAUD makrkat a pr szerint definiljuk jra, a sw_uart.h
+ * makri ezekkel fejtdnek ki. Az usci_uart.h az UCBRSx-et #if lnccal
+ * vlasztja, ezrt ezt a fejlcet pronknt jra beolvassuk, ha a pr
+ * az USCI-val tmogatott (klnben a fejlc #error sora lltan meg a
+ * fordtst). Nincs include r: minden prhoz jra beolvassuk.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#ifdef PAIR_LIST
+  &PAIR_ID(PAIR_MHZ, PAIR_BAUD),
+#else
+#undef SW_UART_SMCLK
+#undef SW_UART_BAUD
+#undef USCI_UART_SMCLK
+#undef USCI_UART_BAUD
+#define SW_UART_SMCLK    (PAIR_MHZ * 1000000UL)
+#define SW_UART_BAUD     PAIR_BAUD
+#define USCI_UART_SMCLK  SW_UART_SMCLK
+#define USCI_UART_BAUD   SW_UART_BAUD
+//--- USCI: UCBRx >= 8, azaz N32 >= 7*32 + 29 (az UCBRSx = 8 lps miatt)
+#if USCI_UART_N32 >= 7 * 32 + 29
+#undef USCI_UART_H
+#undef USCI_UART_MOD
+#include "usci_uart.h"
+#define PAIR_USCI  1, USCI_UART_BR, USCI_UART_BRS
+#else
+#define PAIR_USCI  0, 0, 0
+#endif
+
+static const pair_t PAIR_ID(PAIR_MHZ, PAIR_BAUD) = {
+  PAIR_MHZ, PAIR_BAUD,
+  SW_UART_SMCLK / SW_UART_BAUD > SW_UART_LOOP_CYCLES,  //sw_uart.c: bit banging
+  SW_UART_SMCLK / SW_UART_BAUD >= SW_UART_TX_MINBIT,   //sw_uart_tx.h: Timer_A ad
+  PAIR_USCI,
+  { SW_UART_EDGE(0), SW_UART_EDGE(1), SW_UART_EDGE(2), SW_UART_EDGE(3),
+    SW_UART_EDGE(4), SW_UART_EDGE(5), SW_UART_EDGE(6), SW_UART_EDGE(7),
+    SW_UART_EDGE(8), SW_UART_EDGE(9), SW_UART_EDGE(10), SW_UART_EDGE(11) },
+  { SW_UART_MID(0), SW_UART_MID(1), SW_UART_MID(2), SW_UART_MID(3),
+    SW_UART_MID(4), SW_UART_MID(5), SW_UART_MID(6), SW_UART_MID(7),
+    SW_UART_MID(8), SW_UART_MID(9), SW_UART_MID(10) }
+};
+#undef PAIR_USCI
+#endif
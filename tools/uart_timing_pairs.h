@@ -0,0 +1,115 @@
+/**********************************************************************
+ *  uart_timing_pairs.h
+ *
+ * A uart_timing_check.c vizsglt rajel (CLOCK_MHZ) s adatsebessg
+ * prjai: pronknt a uart_timing_pair.h egyszer beolvasva. Kt
+ * menetben hasznljuk (objektumok, majd PAIR_LIST esetn a cmeik),
+ * ezrt nincs include r.
+ *
+ *  I. Cserny
+ *  MTA ATOMKI, Debrecen
+ **********************************************************************/
+#define PAIR_MHZ   1
+#define PAIR_BAUD  2400UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  4800UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  9600UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  19200UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  38400UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  57600UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  115200UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  230400UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#undef PAIR_MHZ
+#define PAIR_MHZ   8
+#define PAIR_BAUD  2400UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  4800UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  9600UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  19200UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  38400UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  57600UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  115200UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  230400UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#undef PAIR_MHZ
+#define PAIR_MHZ   12
+#define PAIR_BAUD  2400UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  4800UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  9600UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  19200UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  38400UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  57600UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  115200UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  230400UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#undef PAIR_MHZ
+#define PAIR_MHZ   16
+#define PAIR_BAUD  2400UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  4800UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  9600UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  19200UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  38400UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  57600UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  115200UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#define PAIR_BAUD  230400UL
+#include "uart_timing_pair.h"
+#undef PAIR_BAUD
+#undef PAIR_MHZ